@@ -0,0 +1,36 @@
+project "arv-headless"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir "bin/%{cfg.buildcfg}"
+    objdir "obj/%{cfg.buildcfg}"
+
+    files { "src/**.cpp", "src/**.h" }
+
+    includedirs {
+        "../arv_core_interfaces/src",
+        "../arv_core/src",
+        "../providers/headless_software_provider/src"
+    }
+
+    sysincludedirs {
+        GLM_INCLUDE_DIR,
+        -- nlohmann JSON for JsonSceneParser
+        "../arv_core/vendor/nlohmann"
+    }
+
+    -- The provider uses arv_core, so it comes first for single-pass linkers
+    links {
+        "arv_headless_software_provider",
+        "arv_core"
+    }
+
+    filter "system:linux"
+        links { "pthread" }
+
+    filter "configurations:Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        optimize "On"
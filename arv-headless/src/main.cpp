@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ARVBase.h"
+#include "HeadlessSoftwarePlatformProvider.h"
+#include "camera/StandardCamera.h"
+#include "rendering/RenderingObjectFactory.h"
+#include "rendering/SoftwareRenderingAPI.h"
+#include "utils/AssetPath.h"
+#include "utils/JsonSceneParser.h"
+#include "utils/Stopwatch.h"
+
+// Renders a scene JSON with the software provider for a fixed number of frames
+// and reports frame times, e.g. to benchmark on machines without a GPU:
+//     arv-headless arv-studio/assets/scenes/main_scene.json --frames 300
+struct Options {
+    std::string scenePath;
+    std::string assetDirectory = "arv-studio/assets";
+    uint32_t frames = 100;
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    std::string outputDirectory;
+    uint32_t captureEveryNthFrame = 0;
+};
+
+static void PrintUsage()
+{
+    std::cerr << "Usage: arv-headless <scene.json> [--frames N] [--size WIDTH HEIGHT] [--assets DIR]\n"
+                 "                    [--output DIR [--capture-every N]]\n"
+                 "  --frames N         Frames to render (default 100)\n"
+                 "  --size W H         Default target size (default 1280 720)\n"
+                 "  --assets DIR       Asset directory, relative to the working directory (default arv-studio/assets)\n"
+                 "  --output DIR       Write frames as PPM into DIR\n"
+                 "  --capture-every N  Write every Nth frame (default 1 with --output)\n";
+}
+
+static bool ParseCount(const char* text, uint32_t& value)
+{
+    char* end = nullptr;
+    unsigned long parsed = std::strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || parsed == 0 || parsed > 1000000) {
+        return false;
+    }
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            if (!ParseCount(argv[++i], options.frames)) {
+                return false;
+            }
+        } else if (arg == "--size" && i + 2 < argc) {
+            if (!ParseCount(argv[++i], options.width) || !ParseCount(argv[++i], options.height)) {
+                return false;
+            }
+        } else if (arg == "--assets" && hasValue) {
+            options.assetDirectory = argv[++i];
+        } else if (arg == "--output" && hasValue) {
+            options.outputDirectory = argv[++i];
+        } else if (arg == "--capture-every" && hasValue) {
+            if (!ParseCount(argv[++i], options.captureEveryNthFrame)) {
+                return false;
+            }
+        } else if (!arg.empty() && arg[0] != '-' && options.scenePath.empty()) {
+            options.scenePath = arg;
+        } else {
+            return false;
+        }
+    }
+
+    if (!options.outputDirectory.empty() && options.captureEveryNthFrame == 0) {
+        options.captureEveryNthFrame = 1;
+    }
+    return !options.scenePath.empty();
+}
+
+static void PrintReport(std::vector<double> frameMs, const arv::SoftwareRasterizerStats& stats)
+{
+    if (frameMs.empty()) {
+        return;
+    }
+
+    double total = 0.0;
+    for (double ms : frameMs) {
+        total += ms;
+    }
+    std::sort(frameMs.begin(), frameMs.end());
+    size_t frames = frameMs.size();
+    double average = total / frames;
+
+    std::cout << "Frames:        " << frames << "\n"
+              << "Average:       " << average << " ms (" << 1000.0 / average << " fps)\n"
+              << "Median:        " << frameMs[frames / 2] << " ms\n"
+              << "95th pct:      " << frameMs[std::min(frames - 1, frames * 95 / 100)] << " ms\n"
+              << "Min / max:     " << frameMs.front() << " / " << frameMs.back() << " ms\n"
+              << "Draw calls:    " << stats.drawCalls / frames << " per frame\n"
+              << "Triangles:     " << stats.trianglesSubmitted / frames << " submitted, "
+                                   << stats.trianglesBinned / frames << " binned per frame\n"
+              << "Fragments:     " << stats.fragmentsShaded / frames << " per frame\n";
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+    arv::AssetPath::SetAssetDirectory(options.assetDirectory);
+
+    arv::HeadlessCanvasSpecification spec;
+    spec.width = options.width;
+    spec.height = options.height;
+    spec.maxFrames = options.frames;
+    spec.outputDirectory = options.outputDirectory;
+    spec.captureEveryNthFrame = options.captureEveryNthFrame;
+
+    arv::ARVApplication* app = arv::ARVApplication::Create(std::make_unique<arv::HeadlessSoftwarePlatformProvider>(spec));
+    if (!app) {
+        return 1;
+    }
+    app->Initialize();
+
+    // Only the types arv_core implements; studio objects in the scene are skipped
+    arv::RenderingObjectFactory::Instance().RegisterCoreTypes();
+
+    arv::JsonSceneParser parser;
+    arv::ParsedScene scene;
+    try {
+        scene = parser.parseFromFile(options.scenePath);
+    } catch (const std::exception& error) {
+        ARV_LOG_ERROR("arv-headless - Cannot load {}: {}", options.scenePath, error.what());
+        arv::ARVApplication::Destroy();
+        return 1;
+    }
+    if (scene.backgroundMode == "skybox") {
+        ARV_LOG_WARN("arv-headless - Skyboxes are drawn by arv-studio, using the background color");
+    }
+    ARV_LOG_INFO("arv-headless - Rendering {} objects for {} frames at {}x{}",
+                 scene.objects.size(), options.frames, options.width, options.height);
+
+    arv::PlatformProvider* provider = app->GetPlatformProvider();
+    arv::Canvas* canvas = provider->GetCanvas();
+    auto* renderingAPI = static_cast<arv::SoftwareRenderingAPI*>(provider->GetRenderingAPI());
+
+    arv::StandardCamera camera(static_cast<int>(options.width), static_cast<int>(options.height));
+    std::vector<double> frameMs;
+    frameMs.reserve(options.frames);
+
+    while (!canvas->ShouldClose()) {
+        auto frameStart = std::chrono::steady_clock::now();
+
+        app->CalculateNextTimestep();
+        app->GetTextureStreamer()->Update();
+
+        renderingAPI->BeginFrame();
+        arv::Scene frame = app->GetRenderer()->NewScene(&camera);
+        frame.ClearColor(scene.backgroundColor);
+        for (auto& object : scene.objects) {
+            frame.Submit(*object);
+        }
+        frame.Render();
+        renderingAPI->EndFrame();
+
+        canvas->PollEvents();
+        canvas->SwapBuffers();
+        frameMs.push_back(arv::MillisecondsSince(frameStart));
+    }
+
+    PrintReport(frameMs, renderingAPI->GetRasterizerStats());
+
+    scene.objects.clear();
+    arv::ARVApplication::Destroy();
+    return 0;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "rendering/RenderingObject.h"
+#include "rendering/Scene.h"
+#include "rendering/ObjectSpatialIndex.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -15,9 +17,11 @@ struct BackgroundSettings {
 
 struct EditorState {
     std::vector<std::unique_ptr<arv::RenderingObject>> objects;
+    arv::ObjectSpatialIndex spatialIndex;  // Bounds of `objects`; declared after them so it is destroyed first
     int selectedObjectIndex = -1;
     std::string currentScenePath;
     BackgroundSettings background;
     float deltaTime = 0.0f;
     int maxFPS = 0;
+    arv::SceneStats sceneStats;  // Stats of the last rendered scene
 };
@@ -2,7 +2,6 @@
 #include "rendering/RenderingObjectFactory.h"
 #include "objects/SimpleTriangleRO.h"
 #include "objects/ImageTextureRO.h"
-#include "rendering/ObjAssetRO.h"
 #include "utils/AssetPath.h"
 #include <nlohmann/json.hpp>
 
@@ -41,14 +40,7 @@ namespace arv {
         });
 
         // ObjAssetRO
-        factory.Register("ObjAssetRO", [](const nlohmann::json& json) -> std::unique_ptr<RenderingObject> {
-            std::string pathFragment;
-            if (json.contains("pathFragment")) {
-                pathFragment = json.at("pathFragment").get<std::string>();
-            }
-
-            return std::make_unique<ObjAssetRO>(pathFragment);
-        });
+        factory.RegisterCoreTypes();
     }
 
 }
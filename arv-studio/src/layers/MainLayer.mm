@@ -60,6 +60,7 @@ void MainLayer::OnDetach()
 {
     ARV_LOG_INFO("MainLayer::OnDetach()");
     m_SceneDisplay->Shutdown();
+    m_State.spatialIndex.Clear();
     m_State.objects.clear();
     m_ImGuiManager->Shutdown();
 }
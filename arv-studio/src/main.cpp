@@ -84,6 +84,9 @@ int start(int platformType) {
         arv::Timestep timestep = app->CalculateNextTimestep();
         app->GetLayerStack().OnUpdate(timestep.GetSeconds());
 
+        // Swap decoded images into their placeholder textures, within the upload budget
+        app->GetTextureStreamer()->Update();
+
         renderingAPI->BeginFrame();
         app->GetLayerStack().OnRender();
         renderingAPI->EndFrame();
@@ -1,7 +1,8 @@
 #include "ImageTextureRO.h"
 #include "ARVApplication.h"
 #include "rendering/ShaderSource.h"
-#include "rendering/CoreShaderSource.h"
+#include "rendering/ResourceCache.h"
+#include "rendering/ShaderLibrary.h"
 #include <string>
 
 namespace arv {
@@ -19,14 +20,31 @@ namespace arv {
             layout(location = 0) in vec3 a_Position;
             layout(location = 1) in vec2 a_TexCoord;
 
-            uniform mat4 u_mvp;
+            #ifdef ARV_INSTANCED
+            layout(location = 8) in mat4 a_InstanceModel;
+            layout(location = 12) in vec4 a_InstanceTint;
+
+            uniform mat4 u_viewProjection;
+
+            out vec4 v_Tint;
+            #else
+            layout(std140) uniform ArvObject {
+                mat4 u_model;
+                mat4 u_mvp;
+            };
+            #endif
 
             out vec2 v_TexCoord;
 
             void main()
             {
                 v_TexCoord = a_TexCoord;
+            #ifdef ARV_INSTANCED
+                v_Tint = a_InstanceTint;
+                gl_Position = u_viewProjection * a_InstanceModel * vec4(a_Position, 1.0);
+            #else
                 gl_Position = u_mvp * vec4(a_Position, 1.0);
+            #endif
             }
 
             ### GLSL_FRAGMENT_SHADER ###
@@ -36,16 +54,27 @@ namespace arv {
             layout(location = 0) out vec4 color;
 
             in vec2 v_TexCoord;
+            #ifdef ARV_INSTANCED
+            in vec4 v_Tint;
+            #endif
 
             uniform sampler2D u_Texture;
 
             void main()
             {
                 color = texture(u_Texture, v_TexCoord);
+            #ifdef ARV_INSTANCED
+                color *= v_Tint;
+            #endif
                 if (color.a < 0.01)
                     discard;
             }
 
+            ### SOFTWARE_SHADER ###
+
+            texture = u_Texture
+            alphaDiscard = 0.01
+
             ### MSL_SHADER ###
 
             #include <metal_stdlib>
@@ -84,40 +113,41 @@ namespace arv {
             }
         )";
 
-        m_ShaderSource = std::make_unique<CoreShaderSource>(fullSource);
-        m_Shader = app->GetRenderer()->CreateShader(m_ShaderSource.get());
-        m_Shader->Compile();
+        // Every image shares the shader and the quad; only the texture differs
+        m_Shader = ShaderLibrary::Global().Get(fullSource);
+        m_VertexArray = ResourceCache::Global().GetOrCreate<VertexArray>("ImageTextureRO|quad|", [app]() {
+            std::shared_ptr<VertexArray> vertexArray = app->GetRenderer()->CreateVertexArray();
+
+            // Quad vertices: position (xyz) + texture coordinates (uv)
+            float vertices[] = {
+                // Position            // TexCoord
+                -0.5f, -0.5f, 0.0f,    0.0f, 0.0f,  // Bottom-left
+                 0.5f, -0.5f, 0.0f,    1.0f, 0.0f,  // Bottom-right
+                 0.5f,  0.5f, 0.0f,    1.0f, 1.0f,  // Top-right
+                -0.5f,  0.5f, 0.0f,    0.0f, 1.0f   // Top-left
+            };
 
-        m_VertexArray = app->GetRenderer()->CreateVertexArray();
+            auto vertexBuffer = app->GetRenderer()->CreateVertexBuffer(vertices, sizeof(vertices));
+            arv::BufferLayout layout = {
+                { arv::ShaderDataType::Float3, "a_Position" },
+                { arv::ShaderDataType::Float2, "a_TexCoord" }
+            };
+            vertexBuffer->SetLayout(layout);
+            vertexArray->AddVertexBuffer(vertexBuffer);
+
+            uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
+            auto indexBuffer = app->GetRenderer()->CreateIndexBuffer(indices, sizeof(indices) / sizeof(uint32_t));
+            vertexArray->SetIndexBuffer(indexBuffer);
 
-        // Quad vertices: position (xyz) + texture coordinates (uv)
-        float vertices[] = {
-            // Position            // TexCoord
-            -0.5f, -0.5f, 0.0f,    0.0f, 0.0f,  // Bottom-left
-             0.5f, -0.5f, 0.0f,    1.0f, 0.0f,  // Bottom-right
-             0.5f,  0.5f, 0.0f,    1.0f, 1.0f,  // Top-right
-            -0.5f,  0.5f, 0.0f,    0.0f, 1.0f   // Top-left
-        };
+            vertexArray->Unbind();
+            return vertexArray;
+        });
 
         m_boundsMin = glm::vec3(-0.5f, -0.5f, 0.0f);
         m_boundsMax = glm::vec3(0.5f, 0.5f, 0.0f);
 
-        auto vertexBuffer = app->GetRenderer()->CreateVertexBuffer(vertices, sizeof(vertices));
-        arv::BufferLayout layout = {
-            { arv::ShaderDataType::Float3, "a_Position" },
-            { arv::ShaderDataType::Float2, "a_TexCoord" }
-        };
-        vertexBuffer->SetLayout(layout);
-        m_VertexArray->AddVertexBuffer(vertexBuffer);
-
-        uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
-        auto indexBuffer = app->GetRenderer()->CreateIndexBuffer(indices, sizeof(indices) / sizeof(uint32_t));
-        m_VertexArray->SetIndexBuffer(indexBuffer);
-
-        m_VertexArray->Unbind();
-
-        // Load the texture
-        m_Texture = app->GetRenderer()->CreateTexture2D(texturePath);
+        // Shows a placeholder until the image has been decoded and uploaded
+        m_Texture = ResourceCache::Global().StreamTexture2D(texturePath);
     };
 
     std::shared_ptr<Shader>& ImageTextureRO::GetShader() {
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "rendering/RenderingObject.h"
-#include "rendering/CoreShaderSource.h"
 #include "rendering/Texture.h"
 #include <glm/glm.hpp>
 #include <memory>
@@ -19,7 +18,6 @@ namespace arv {
         std::shared_ptr<Texture2D> GetTexture() override { return m_Texture; }
 
     private:
-        std::unique_ptr<CoreShaderSource> m_ShaderSource;
         std::shared_ptr<Shader> m_Shader;
         std::shared_ptr<VertexArray> m_VertexArray;
         std::shared_ptr<Texture2D> m_Texture;
@@ -1,6 +1,6 @@
 #include "SelectionCubeRO.h"
 #include "ARVApplication.h"
-#include "rendering/CoreShaderSource.h"
+#include "rendering/ShaderLibrary.h"
 #include <string>
 
 namespace arv {
@@ -35,6 +35,10 @@ namespace arv {
                 color = vec4(0.0, 0.7, 1.0, 0.3);
             }
 
+            ### SOFTWARE_SHADER ###
+
+            color = 0.0 0.7 1.0 0.3
+
             ### MSL_SHADER ###
 
             #include <metal_stdlib>
@@ -64,9 +68,7 @@ namespace arv {
             }
         )";
 
-        m_ShaderSource = std::make_unique<CoreShaderSource>(fullSource);
-        m_Shader = app->GetRenderer()->CreateShader(m_ShaderSource.get());
-        m_Shader->Compile();
+        m_Shader = ShaderLibrary::Global().Get(fullSource);
 
         m_VertexArray = app->GetRenderer()->CreateVertexArray();
 
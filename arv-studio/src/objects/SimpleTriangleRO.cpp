@@ -1,13 +1,15 @@
 #include "SimpleTriangleRO.h"
 #include "ARVApplication.h"
 #include "rendering/ShaderSource.h"
-#include "rendering/CoreShaderSource.h"
+#include "rendering/ShaderLibrary.h"
 #include <string>
 #include <imgui.h>
 #include <nlohmann/json.hpp>
 
 namespace arv {
 
+    static constexpr UniformId ColorUniform("u_Color");
+
     SimpleTriangleRO::SimpleTriangleRO() {
 
         ARVApplication* app = ARVApplication::Get();
@@ -20,7 +22,10 @@ namespace arv {
                             
             layout(location = 0) in vec3 a_Position;
 
-            uniform mat4 u_mvp;
+            layout(std140) uniform ArvObject {
+                mat4 u_model;
+                mat4 u_mvp;
+            };
 
             out vec3 v_Position;
 
@@ -45,6 +50,10 @@ namespace arv {
                 color = u_Color;
             }
 
+            ### SOFTWARE_SHADER ###
+
+            color = u_Color
+
             ### MSL_SHADER ###
 
             #include <metal_stdlib>
@@ -79,9 +88,9 @@ namespace arv {
             }
         )";
 
-        m_ShaderSource = std::make_unique<CoreShaderSource>(fullSource);
-        m_Shader = app->GetRenderer()->CreateShader(m_ShaderSource.get());
-        m_Shader->Compile();
+        // Triangles share the program; the color is a per-object uniform
+        m_Shader = ShaderLibrary::Global().Get(fullSource);
+        m_uniforms.SetFloat4(ColorUniform, m_Color);
 
         m_VertexArray = app->GetRenderer()->CreateVertexArray();
 
@@ -118,7 +127,7 @@ namespace arv {
 
     void SimpleTriangleRO::SetColor(const glm::vec4& color) {
         m_Color = color;
-        m_Shader->UploadUniformFloat4("u_Color", m_Color);
+        m_uniforms.SetFloat4(ColorUniform, m_Color);
     }
 
     void SimpleTriangleRO::RenderCustomImGui() {
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "rendering/RenderingObject.h"
-#include "rendering/CoreShaderSource.h"
 #include <glm/glm.hpp>
 #include <memory>
 
@@ -22,7 +21,6 @@ namespace arv {
         void SaveCustomProperties(nlohmann::json& j) const override;
 
     private:
-        std::unique_ptr<CoreShaderSource> m_ShaderSource;
         std::shared_ptr<Shader> m_Shader;
         std::shared_ptr<VertexArray> m_VertexArray;
         glm::vec4 m_Color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
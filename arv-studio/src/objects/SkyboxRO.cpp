@@ -1,6 +1,6 @@
 #include "SkyboxRO.h"
 #include "ARVApplication.h"
-#include "rendering/CoreShaderSource.h"
+#include "rendering/ShaderLibrary.h"
 #include <string>
 
 namespace arv {
@@ -16,11 +16,15 @@ namespace arv {
 
             layout(location = 0) in vec3 a_Position;
 
-            out vec2 v_Position;
+            uniform mat4 u_inverseVP;
+
+            out vec4 v_Direction;
 
             void main()
             {
-                v_Position = a_Position.xy;
+                // Far plane point in world space. Its w is positive, so the
+                // interpolated xyz points the same way as xyz / w.
+                v_Direction = u_inverseVP * vec4(a_Position.xy, 1.0, 1.0);
                 gl_Position = vec4(a_Position.xy, 0.9999, 1.0);
             }
 
@@ -30,24 +34,13 @@ namespace arv {
 
             layout(location = 0) out vec4 fragColor;
 
-            in vec2 v_Position;
-
-            uniform mat4 u_inverseVP;
-            uniform sampler2D u_Texture;
+            in vec4 v_Direction;
 
-            const float PI = 3.14159265358979323846;
+            uniform samplerCube u_Texture;
 
             void main()
             {
-                vec4 clipPos = vec4(v_Position, 1.0, 1.0);
-                vec4 worldPos = u_inverseVP * clipPos;
-                vec3 dir = normalize(worldPos.xyz / worldPos.w);
-
-                float u = atan(dir.z, dir.x) / (2.0 * PI) + 0.5;
-                float v = asin(clamp(dir.y, -1.0, 1.0)) / PI + 0.5;
-                v = 1.0 - v;
-
-                vec3 hdrColor = texture(u_Texture, vec2(u, v)).rgb;
+                vec3 hdrColor = texture(u_Texture, v_Direction.xyz).rgb;
 
                 // Reinhard tonemapping
                 vec3 mapped = hdrColor / (hdrColor + vec3(1.0));
@@ -58,6 +51,11 @@ namespace arv {
                 fragColor = vec4(mapped, 1.0);
             }
 
+            ### SOFTWARE_SHADER ###
+
+            program = cubemap
+            texture = u_Texture
+
             ### MSL_SHADER ###
 
             #include <metal_stdlib>
@@ -67,41 +65,28 @@ namespace arv {
                 float4x4 u_inverseVP;
             };
 
-            struct FragmentUniforms {
-                float4x4 u_inverseVP;
-            };
-
             struct VertexIn {
                 float3 position [[attribute(0)]];
             };
 
             struct VertexOut {
                 float4 position [[position]];
-                float2 ndc;
+                float4 direction;
             };
 
             vertex VertexOut vertexMain(VertexIn in [[stage_in]],
                                         constant VertexUniforms& uniforms [[buffer(1)]]) {
                 VertexOut out;
                 out.position = float4(in.position.xy, 0.9999, 1.0);
-                out.ndc = in.position.xy;
+                // Far plane point in world space; its w is positive, see the GLSL version
+                out.direction = uniforms.u_inverseVP * float4(in.position.xy, 1.0, 1.0);
                 return out;
             }
 
             fragment float4 fragmentMain(VertexOut in [[stage_in]],
-                                         constant FragmentUniforms& uniforms [[buffer(0)]],
-                                         texture2d<float> tex [[texture(0)]],
+                                         texturecube<float> tex [[texture(0)]],
                                          sampler texSampler [[sampler(0)]]) {
-                float4 clipPos = float4(in.ndc, 1.0, 1.0);
-                float4 worldPos = uniforms.u_inverseVP * clipPos;
-                float3 dir = normalize(worldPos.xyz / worldPos.w);
-
-                constexpr float PI = 3.14159265358979323846;
-                float u = atan2(dir.z, dir.x) / (2.0 * PI) + 0.5;
-                float v = asin(clamp(dir.y, -1.0f, 1.0f)) / PI + 0.5;
-                v = 1.0 - v;
-
-                float3 hdrColor = tex.sample(texSampler, float2(u, v)).rgb;
+                float3 hdrColor = tex.sample(texSampler, in.direction.xyz).rgb;
 
                 // Reinhard tonemapping
                 float3 mapped = hdrColor / (hdrColor + float3(1.0));
@@ -113,9 +98,7 @@ namespace arv {
             }
         )";
 
-        m_ShaderSource = std::make_unique<CoreShaderSource>(fullSource);
-        m_Shader = app->GetRenderer()->CreateShader(m_ShaderSource.get());
-        m_Shader->Compile();
+        m_Shader = ShaderLibrary::Global().Get(fullSource);
 
         m_VertexArray = app->GetRenderer()->CreateVertexArray();
 
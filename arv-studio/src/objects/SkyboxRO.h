@@ -1,7 +1,6 @@
 #pragma once
 
 #include "rendering/RenderingObject.h"
-#include "rendering/CoreShaderSource.h"
 #include <memory>
 
 namespace arv {
@@ -14,7 +13,6 @@ namespace arv {
         std::shared_ptr<VertexArray>& GetVertexArray() override;
 
     private:
-        std::unique_ptr<CoreShaderSource> m_ShaderSource;
         std::shared_ptr<Shader> m_Shader;
         std::shared_ptr<VertexArray> m_VertexArray;
     };
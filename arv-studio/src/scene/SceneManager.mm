@@ -25,7 +25,9 @@ void SceneManager::LoadScene(const std::string& path)
     arv::ParsedScene parsedScene = parser.parseFromFile(path);
 
     m_State->currentScenePath = path;
+    m_State->spatialIndex.Clear();
     m_State->objects = std::move(parsedScene.objects);
+    m_State->spatialIndex.Rebuild(m_State->objects);
     m_State->selectedObjectIndex = -1;
 
     ApplyBackground(parsedScene.backgroundMode, parsedScene.backgroundColor, parsedScene.skyboxPath);
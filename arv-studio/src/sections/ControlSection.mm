@@ -2,6 +2,9 @@
 #include "ARVBase.h"
 #include "../events/StudioActionEvents.h"
 #include "utils/AssetPath.h"
+#include "math/TransformBatch.h"
+#include "rendering/ResourceCache.h"
+#include "rendering/ShaderLibrary.h"
 
 #include <imgui.h>
 #include <string>
@@ -238,4 +241,30 @@ void ControlSection::RenderPerformanceInfo()
         ImGui::Text("FPS: %.1f (%.2f ms)", fps, m_State->deltaTime * 1000.0f);
     }
     ImGui::SliderInt("Max FPS", &m_State->maxFPS, 0, 240, m_State->maxFPS == 0 ? "Unlimited" : "%d");
+
+    ImGui::Text("Objects: %u submitted, %u culled",
+                m_State->sceneStats.submittedObjects, m_State->sceneStats.culledObjects);
+    ImGui::Text("Matrices built: %u (%s)", m_State->sceneStats.matricesBuilt, arv::TransformBatch::GetKernelName());
+    ImGui::Text("Instanced: %u objects in %u draws",
+                m_State->sceneStats.instancedObjects, m_State->sceneStats.instancedDraws);
+
+    const arv::RenderStats& stats = m_RenderingAPI->GetRenderStats();
+    ImGui::Text("Draw calls: %u", stats.drawCalls);
+    ImGui::Text("Binds: %u shader, %u texture, %u vertex array",
+                stats.shaderBinds, stats.textureBinds, stats.vertexArrayBinds);
+    ImGui::Text("State changes skipped: %u", stats.stateChangesSkipped);
+    ImGui::Text("Draw queue: %.1f KB (peak %.1f KB)",
+                stats.queueMemoryUsed / 1024.0f, stats.queueMemoryHighWater / 1024.0f);
+
+    arv::ResourceCacheStats cacheStats = arv::ResourceCache::Global().GetStats();
+    ImGui::Text("Resource cache: %u live, %u hits, %u misses, %u evicted",
+                cacheStats.liveEntries, cacheStats.hits, cacheStats.misses, cacheStats.evictions);
+
+    arv::ShaderLibraryStats shaderStats = arv::ShaderLibrary::Global().GetStats();
+    ImGui::Text("Shader library: %u programs, %u compiles, %u shared lookups",
+                shaderStats.liveShaders, shaderStats.compiles, shaderStats.hits);
+
+    arv::TextureStreamerStats streamStats = arv::ARVApplication::Get()->GetTextureStreamer()->GetStats();
+    ImGui::Text("Texture streaming: %u pending, %u uploaded (%.2f ms), %u failed",
+                streamStats.pending, streamStats.uploadedLastUpdate, streamStats.uploadMsLastUpdate, streamStats.failed);
 }
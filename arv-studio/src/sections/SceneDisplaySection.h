@@ -33,7 +33,9 @@ public:
 private:
     void RenderSkybox();
     void SubmitScene();
-    void RenderSelectionCube();
+    void RenderSelectionCube(const glm::mat4& viewProjection);
+    // Selects the object under a pixel of the viewport image (origin top-left)
+    void PickObjectAt(const glm::vec2& pixel);
     // Non-owning references
     arv::Renderer* m_Renderer;
     arv::RenderingAPI* m_RenderingAPI;
@@ -46,6 +48,7 @@ private:
     std::shared_ptr<arv::Framebuffer> m_SceneFramebuffer;
     std::unique_ptr<arv::SelectionCubeRO> m_SelectionCube;
     std::unique_ptr<arv::SkyboxRO> m_Skybox;
-    std::shared_ptr<arv::Texture2D> m_SkyboxTexture;
+    std::shared_ptr<arv::TextureCube> m_SkyboxTexture;
     glm::vec2 m_ViewportSize{0.0f, 0.0f};
+    std::vector<arv::RenderingObject*> m_VisibleObjects;  // Per-frame frustum query results
 };
@@ -3,10 +3,13 @@
 #include "../objects/SelectionCubeRO.h"
 #include "../objects/SkyboxRO.h"
 #include "rendering/Scene.h"
+#include "math/TransformBatch.h"
 #include "utils/Timestep.h"
+#include "utils/Stopwatch.h"
 #include "utils/AssetPath.h"
 
 #include <imgui.h>
+#include <chrono>
 #include <glm/gtc/matrix_transform.hpp>
 
 #ifdef __APPLE__
@@ -53,7 +56,7 @@ void SceneDisplaySection::Init(int width, int height)
 
 void SceneDisplaySection::LoadSkyboxTexture(const std::string& path)
 {
-    m_SkyboxTexture = m_RenderingAPI->CreateHDRTexture2D(
+    m_SkyboxTexture = m_RenderingAPI->CreateHDRTextureCube(
         arv::AssetPath::Resolve(path));
 }
 
@@ -79,20 +82,34 @@ void SceneDisplaySection::RenderSkybox()
 
     glm::mat4 inverseVP = glm::inverse(m_Camera->GetProjectionMatrix() * m_Camera->GetViewMatrix());
     m_Skybox->GetShader()->UploadUniformMat4("u_inverseVP", inverseVP);
+    m_RenderingAPI->SetDrawPass(arv::DrawPass::Background);
     m_RenderingAPI->Draw(m_Skybox->GetShader(), m_Skybox->GetVertexArray(), m_SkyboxTexture);
+    m_RenderingAPI->SetDrawPass(arv::DrawPass::Opaque);
 }
 
 void SceneDisplaySection::SubmitScene()
 {
     arv::Scene scene = m_Renderer->NewScene(m_Camera.get());
-    for (auto& object : m_State->objects) {
+
+    // Only objects the spatial index finds in the frustum reach the scene
+    m_VisibleObjects.clear();
+    m_State->spatialIndex.QueryFrustum(m_Camera->GetFrustum(), m_VisibleObjects);
+    for (arv::RenderingObject* object : m_VisibleObjects) {
         scene.Submit(*object);
     }
-    RenderSelectionCube();
     scene.Render();
+
+    m_State->sceneStats = scene.GetStats();
+    uint32_t rejected = static_cast<uint32_t>(m_State->objects.size() - m_VisibleObjects.size());
+    m_State->sceneStats.submittedObjects += rejected;
+    m_State->sceneStats.culledObjects += rejected;
+
+    // Drawn after the scene so the transparent cube blends over the objects
+    RenderSelectionCube(scene.GetViewProjectionMatrix());
+    m_RenderingAPI->FlushDrawCommands();
 }
 
-void SceneDisplaySection::RenderSelectionCube()
+void SceneDisplaySection::RenderSelectionCube(const glm::mat4& viewProjection)
 {
     if (m_State->selectedObjectIndex < 0 ||
         m_State->selectedObjectIndex >= static_cast<int>(m_State->objects.size()))
@@ -103,20 +120,16 @@ void SceneDisplaySection::RenderSelectionCube()
     glm::vec3 boundsCenter = selectedObj->GetBoundsCenter();
     glm::vec3 boundsSize = selectedObj->GetBoundsSize();
 
-    glm::mat4 projection = m_Camera->GetProjectionMatrix();
-    glm::mat4 view = m_Camera->GetViewMatrix();
-    const glm::vec3& rot = selectedObj->GetRotation();
-    const glm::vec3& scl = selectedObj->GetScale();
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), objPos);
-    model = glm::rotate(model, glm::radians(rot.y), glm::vec3(0, 1, 0));
-    model = glm::rotate(model, glm::radians(rot.x), glm::vec3(1, 0, 0));
-    model = glm::rotate(model, glm::radians(rot.z), glm::vec3(0, 0, 1));
-    model = glm::translate(model, boundsCenter * scl);
-    model = glm::scale(model, boundsSize * scl);
-    glm::mat4 mvp = projection * view * model;
+    // Object transform followed by the local bounds box
+    glm::mat4 model = arv::ComposeModelMatrix(objPos, selectedObj->GetRotation(), selectedObj->GetScale());
+    model = glm::translate(model, boundsCenter);
+    model = glm::scale(model, boundsSize);
+    glm::mat4 mvp = viewProjection * model;
 
     m_SelectionCube->GetShader()->UploadUniformMat4("u_mvp", mvp);
+    m_RenderingAPI->SetDrawPass(arv::DrawPass::Transparent);
     m_RenderingAPI->Draw(m_SelectionCube->GetShader(), m_SelectionCube->GetVertexArray());
+    m_RenderingAPI->SetDrawPass(arv::DrawPass::Opaque);
 }
 
 void SceneDisplaySection::RenderSceneToFramebuffer()
@@ -141,6 +154,29 @@ void SceneDisplaySection::RenderSceneToFramebuffer()
     }
 }
 
+void SceneDisplaySection::PickObjectAt(const glm::vec2& pixel)
+{
+    if (m_ViewportSize.x <= 0 || m_ViewportSize.y <= 0) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    arv::Ray ray = arv::Ray::FromScreenPoint(glm::inverse(m_Camera->GetViewProjectionMatrix()), pixel, m_ViewportSize);
+    arv::RenderingObject* picked = m_State->spatialIndex.Pick(ray);
+    double pickMs = arv::MillisecondsSince(start);
+
+    m_State->selectedObjectIndex = -1;
+    for (size_t i = 0; picked && i < m_State->objects.size(); i++) {
+        if (m_State->objects[i].get() == picked) {
+            m_State->selectedObjectIndex = static_cast<int>(i);
+            break;
+        }
+    }
+
+    ARV_LOG_INFO("SceneDisplaySection::PickObjectAt() - Picked '{}' in {:.3f} ms",
+                 picked ? picked->GetName() : std::string("nothing"), pickMs);
+}
+
 void SceneDisplaySection::RenderImGuiPanel()
 {
     ImGuiWindowFlags childFlags = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse;
@@ -175,6 +211,12 @@ void SceneDisplaySection::RenderImGuiPanel()
             ImGui::Image((__bridge ImTextureID)texture, viewportSize);
         }
 #endif
+
+        if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
+            ImVec2 mouse = ImGui::GetMousePos();
+            ImVec2 imageMin = ImGui::GetItemRectMin();
+            PickObjectAt({ mouse.x - imageMin.x, mouse.y - imageMin.y });
+        }
     }
     ImGui::EndChild();
 }
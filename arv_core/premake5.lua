@@ -26,3 +26,9 @@ project "arv_core"
 
     filter "configurations:Release"
         optimize "On"
+
+    -- TransformBatch picks its SIMD kernel at compile time (NEON is implicit on arm64);
+    -- F16C converts half floats for HDR images (see VertexPacking.h)
+    filter "architecture:x86_64"
+        vectorextensions "AVX2"
+        buildoptions { "-mf16c" }
@@ -1,6 +1,8 @@
 #include "ARVApplication.h"
 #include "ARVBase.h"
 #include "rendering/Renderer.h"
+#include "rendering/TextureStreamer.h"
+#include "utils/ThreadPool.h"
 #include <iostream>
 #include <chrono>
 
@@ -60,6 +62,11 @@ namespace arv
         ARV_LOG_INFO("ARVApplication::Initialize() - Creating renderer");
         m_renderer = std::make_unique<Renderer>(m_platformProvider->GetRenderingAPI());
 
+        ARV_LOG_INFO("ARVApplication::Initialize() - Creating texture streamer");
+        // Decodes run on their own workers, so they never hold up the frame's ParallelFor() jobs
+        m_streamingPool = std::make_unique<ThreadPool>(TextureStreamer::DefaultThreadCount);
+        m_textureStreamer = std::make_unique<TextureStreamer>(m_renderer.get(), *m_streamingPool);
+
         ARV_LOG_INFO("ARVApplication::Initialize() - Registering ApplicationResizeEvent listener");
         m_EventManager->AddListener(EventType::ApplicationResizeEvent, [this](arv::Event& event) {
             ApplicationResizeEvent* resizeEvent = static_cast<ApplicationResizeEvent*>(&event);
@@ -84,6 +91,11 @@ namespace arv
         return m_renderer.get();
     }
 
+    TextureStreamer* ARVApplication::GetTextureStreamer() const
+    {
+        return m_textureStreamer.get();
+    }
+
     Timestep ARVApplication::CalculateNextTimestep() {
         float time = GetTime();
         Timestep timestep = time - m_LastFrameTime;
@@ -7,6 +7,8 @@
 
 #include "PlatformProvider.h"
 #include "rendering/Renderer.h"
+#include "rendering/TextureStreamer.h"
+#include "utils/ThreadPool.h"
 #include "utils/Timestep.h"
 
 namespace arv
@@ -23,6 +25,7 @@ namespace arv
         void Initialize();
         PlatformProvider* GetPlatformProvider() const;
         Renderer* GetRenderer() const;
+        TextureStreamer* GetTextureStreamer() const;
 
         inline std::unique_ptr<Logger>& GetLogger() { return m_Logger; }
         inline std::unique_ptr<EventManager>& GetEventManager() { return m_EventManager; }
@@ -48,6 +51,8 @@ namespace arv
     private:
         std::unique_ptr<PlatformProvider> m_platformProvider;
         std::unique_ptr<Renderer> m_renderer;
+        std::unique_ptr<ThreadPool> m_streamingPool;  // Outlives the streamer
+        std::unique_ptr<TextureStreamer> m_textureStreamer;
         LayerStack m_LayerStack;
 
         float m_LastFrameTime = 0.0f;
@@ -4,6 +4,7 @@
 
 #define PROVIDER_OPENGL 1
 #define PROVIDER_METAL 2
+#define PROVIDER_SOFTWARE 3
 
 #define ARV_LOG_INFO(...) arv::ARVApplication::Get()->GetLogger()->Info(__VA_ARGS__)
 #define ARV_LOG_WARN(...) arv::ARVApplication::Get()->GetLogger()->Warn(__VA_ARGS__)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include "../math/Frustum.h"
 
 namespace arv {
 
@@ -11,6 +12,7 @@ namespace arv {
         virtual glm::mat4 GetViewMatrix() const = 0;
         virtual glm::mat4 GetProjectionMatrix() const = 0;
         virtual glm::mat4 GetViewProjectionMatrix() const { return GetProjectionMatrix() * GetViewMatrix(); }
+        virtual Frustum GetFrustum() const { return Frustum::FromViewProjection(GetViewProjectionMatrix()); }
     };
 
 }
\ No newline at end of file
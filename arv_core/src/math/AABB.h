@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <glm/glm.hpp>
+
+namespace arv {
+
+    // Axis-aligned bounding box
+    struct AABB {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        AABB() = default;
+        AABB(const glm::vec3& minCorner, const glm::vec3& maxCorner) : min(minCorner), max(maxCorner) {}
+
+        glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+        glm::vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+        float GetSurfaceArea() const
+        {
+            glm::vec3 size = max - min;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        bool Contains(const AABB& other) const
+        {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                   max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+        }
+
+        bool Overlaps(const AABB& other) const
+        {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        // Slab test. inverseDirection is 1 / ray direction per axis (may be +-inf).
+        // On a hit within [0, maxDistance] returns true and the entry distance.
+        bool IntersectRay(const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& outDistance) const
+        {
+            float tMin = 0.0f;
+            float tMax = maxDistance;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                float t0 = (min[axis] - origin[axis]) * inverseDirection[axis];
+                float t1 = (max[axis] - origin[axis]) * inverseDirection[axis];
+                if (t0 > t1)
+                {
+                    std::swap(t0, t1);
+                }
+                // Written so NaN (origin on a slab plane of a zero direction) keeps the range
+                tMin = t0 > tMin ? t0 : tMin;
+                tMax = t1 < tMax ? t1 : tMax;
+                if (tMin > tMax)
+                {
+                    return false;
+                }
+            }
+            outDistance = tMin;
+            return true;
+        }
+
+        static AABB Union(const AABB& a, const AABB& b)
+        {
+            return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+        }
+    };
+
+}
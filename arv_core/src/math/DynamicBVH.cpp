@@ -0,0 +1,405 @@
+#include "DynamicBVH.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace arv {
+
+    DynamicBVH::DynamicBVH(float fatMargin)
+        : m_FatMargin(fatMargin)
+    {
+    }
+
+    void DynamicBVH::Clear()
+    {
+        m_Nodes.clear();
+        m_Root = NullNode;
+        m_FreeList = NullNode;
+        m_ProxyCount = 0;
+    }
+
+    AABB DynamicBVH::Fatten(const AABB& bounds) const
+    {
+        // A small absolute part keeps flat and point-sized boxes from re-inserting on every move
+        glm::vec3 margin = (bounds.max - bounds.min) * m_FatMargin + glm::vec3(0.01f);
+        return AABB(bounds.min - margin, bounds.max + margin);
+    }
+
+    int32_t DynamicBVH::AllocateNode()
+    {
+        if (m_FreeList == NullNode)
+        {
+            m_Nodes.emplace_back();
+            return static_cast<int32_t>(m_Nodes.size() - 1);
+        }
+
+        int32_t node = m_FreeList;
+        m_FreeList = m_Nodes[node].parent;
+        m_Nodes[node] = Node();
+        return node;
+    }
+
+    void DynamicBVH::FreeNode(int32_t node)
+    {
+        m_Nodes[node].parent = m_FreeList;
+        m_Nodes[node].height = -1;
+        m_FreeList = node;
+    }
+
+    int32_t DynamicBVH::CreateProxy(const AABB& bounds, void* userData)
+    {
+        int32_t proxy = AllocateNode();
+        m_Nodes[proxy].bounds = Fatten(bounds);
+        m_Nodes[proxy].userData = userData;
+        m_Nodes[proxy].height = 0;
+        InsertLeaf(proxy);
+        m_ProxyCount++;
+        return proxy;
+    }
+
+    void DynamicBVH::DestroyProxy(int32_t proxy)
+    {
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        m_ProxyCount--;
+    }
+
+    bool DynamicBVH::MoveProxy(int32_t proxy, const AABB& bounds)
+    {
+        const AABB& fatBounds = m_Nodes[proxy].bounds;
+        if (fatBounds.Contains(bounds))
+        {
+            // Still inside, unless the object shrank so much that the fat box is mostly empty
+            glm::vec3 slack = (bounds.max - bounds.min) * (4.0f * m_FatMargin) + glm::vec3(0.04f);
+            AABB largest(bounds.min - slack, bounds.max + slack);
+            if (largest.Contains(fatBounds))
+            {
+                return false;
+            }
+        }
+
+        RemoveLeaf(proxy);
+        m_Nodes[proxy].bounds = Fatten(bounds);
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    void DynamicBVH::InsertLeaf(int32_t leaf)
+    {
+        if (m_Root == NullNode)
+        {
+            m_Root = leaf;
+            m_Nodes[leaf].parent = NullNode;
+            return;
+        }
+
+        // Walk down towards the sibling with the lowest surface area cost. Every
+        // node above the new leaf grows, which is the inherited part of the cost.
+        AABB leafBounds = m_Nodes[leaf].bounds;
+        int32_t index = m_Root;
+        while (!m_Nodes[index].IsLeaf())
+        {
+            const Node& node = m_Nodes[index];
+            float area = node.bounds.GetSurfaceArea();
+            float combinedArea = AABB::Union(node.bounds, leafBounds).GetSurfaceArea();
+
+            // Cost of making the leaf a sibling of this node
+            float cost = 2.0f * combinedArea;
+            // Minimum cost of pushing the leaf further down
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto childCost = [&](int32_t child) {
+                const AABB& childBounds = m_Nodes[child].bounds;
+                float unionArea = AABB::Union(leafBounds, childBounds).GetSurfaceArea();
+                if (m_Nodes[child].IsLeaf())
+                {
+                    return unionArea + inheritanceCost;
+                }
+                return unionArea - childBounds.GetSurfaceArea() + inheritanceCost;
+            };
+            float leftCost = childCost(node.left);
+            float rightCost = childCost(node.right);
+
+            if (cost < leftCost && cost < rightCost)
+            {
+                break;
+            }
+            index = leftCost < rightCost ? node.left : node.right;
+        }
+
+        int32_t sibling = index;
+        int32_t oldParent = m_Nodes[sibling].parent;
+        int32_t newParent = AllocateNode();
+        m_Nodes[newParent].parent = oldParent;
+        m_Nodes[newParent].bounds = AABB::Union(leafBounds, m_Nodes[sibling].bounds);
+        m_Nodes[newParent].height = m_Nodes[sibling].height + 1;
+        m_Nodes[newParent].left = sibling;
+        m_Nodes[newParent].right = leaf;
+        m_Nodes[sibling].parent = newParent;
+        m_Nodes[leaf].parent = newParent;
+
+        if (oldParent == NullNode)
+        {
+            m_Root = newParent;
+        }
+        else if (m_Nodes[oldParent].left == sibling)
+        {
+            m_Nodes[oldParent].left = newParent;
+        }
+        else
+        {
+            m_Nodes[oldParent].right = newParent;
+        }
+
+        Refit(m_Nodes[leaf].parent);
+    }
+
+    void DynamicBVH::RemoveLeaf(int32_t leaf)
+    {
+        if (leaf == m_Root)
+        {
+            m_Root = NullNode;
+            return;
+        }
+
+        int32_t parent = m_Nodes[leaf].parent;
+        int32_t grandParent = m_Nodes[parent].parent;
+        int32_t sibling = m_Nodes[parent].left == leaf ? m_Nodes[parent].right : m_Nodes[parent].left;
+
+        if (grandParent == NullNode)
+        {
+            m_Root = sibling;
+            m_Nodes[sibling].parent = NullNode;
+            FreeNode(parent);
+            return;
+        }
+
+        if (m_Nodes[grandParent].left == parent)
+        {
+            m_Nodes[grandParent].left = sibling;
+        }
+        else
+        {
+            m_Nodes[grandParent].right = sibling;
+        }
+        m_Nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        Refit(grandParent);
+    }
+
+    void DynamicBVH::Refit(int32_t index)
+    {
+        while (index != NullNode)
+        {
+            index = Balance(index);
+
+            Node& node = m_Nodes[index];
+            node.height = 1 + std::max(m_Nodes[node.left].height, m_Nodes[node.right].height);
+            node.bounds = AABB::Union(m_Nodes[node.left].bounds, m_Nodes[node.right].bounds);
+
+            index = node.parent;
+        }
+    }
+
+    // Performs a left or right rotation if node a is imbalanced and returns the new subtree root
+    int32_t DynamicBVH::Balance(int32_t a)
+    {
+        Node& nodeA = m_Nodes[a];
+        if (nodeA.IsLeaf() || nodeA.height < 2)
+        {
+            return a;
+        }
+
+        int32_t b = nodeA.left;
+        int32_t c = nodeA.right;
+        int32_t balance = m_Nodes[c].height - m_Nodes[b].height;
+
+        auto replaceChild = [this](int32_t parent, int32_t oldChild, int32_t newChild) {
+            if (parent == NullNode)
+            {
+                m_Root = newChild;
+            }
+            else if (m_Nodes[parent].left == oldChild)
+            {
+                m_Nodes[parent].left = newChild;
+            }
+            else
+            {
+                m_Nodes[parent].right = newChild;
+            }
+        };
+
+        // Rotate c up
+        if (balance > 1)
+        {
+            Node& nodeC = m_Nodes[c];
+            int32_t f = nodeC.left;
+            int32_t g = nodeC.right;
+
+            nodeC.left = a;
+            nodeC.parent = nodeA.parent;
+            nodeA.parent = c;
+            replaceChild(nodeC.parent, a, c);
+
+            // Keep the taller grandchild under c, hand the other one to a
+            int32_t keep = m_Nodes[f].height > m_Nodes[g].height ? f : g;
+            int32_t move = keep == f ? g : f;
+            nodeC.right = keep;
+            nodeA.right = move;
+            m_Nodes[move].parent = a;
+
+            nodeA.bounds = AABB::Union(m_Nodes[b].bounds, m_Nodes[move].bounds);
+            nodeC.bounds = AABB::Union(nodeA.bounds, m_Nodes[keep].bounds);
+            nodeA.height = 1 + std::max(m_Nodes[b].height, m_Nodes[move].height);
+            nodeC.height = 1 + std::max(nodeA.height, m_Nodes[keep].height);
+            return c;
+        }
+
+        // Rotate b up
+        if (balance < -1)
+        {
+            Node& nodeB = m_Nodes[b];
+            int32_t d = nodeB.left;
+            int32_t e = nodeB.right;
+
+            nodeB.left = a;
+            nodeB.parent = nodeA.parent;
+            nodeA.parent = b;
+            replaceChild(nodeB.parent, a, b);
+
+            int32_t keep = m_Nodes[d].height > m_Nodes[e].height ? d : e;
+            int32_t move = keep == d ? e : d;
+            nodeB.right = keep;
+            nodeA.left = move;
+            m_Nodes[move].parent = a;
+
+            nodeA.bounds = AABB::Union(m_Nodes[c].bounds, m_Nodes[move].bounds);
+            nodeB.bounds = AABB::Union(nodeA.bounds, m_Nodes[keep].bounds);
+            nodeA.height = 1 + std::max(m_Nodes[c].height, m_Nodes[move].height);
+            nodeB.height = 1 + std::max(nodeA.height, m_Nodes[keep].height);
+            return b;
+        }
+
+        return a;
+    }
+
+    void DynamicBVH::CollectLeaves(int32_t root, std::vector<void*>& outUserData) const
+    {
+        size_t base = m_Stack.size();
+        m_Stack.push_back(root);
+        while (m_Stack.size() > base)
+        {
+            int32_t index = m_Stack.back();
+            m_Stack.pop_back();
+            const Node& node = m_Nodes[index];
+            if (node.IsLeaf())
+            {
+                outUserData.push_back(node.userData);
+            }
+            else
+            {
+                m_Stack.push_back(node.left);
+                m_Stack.push_back(node.right);
+            }
+        }
+    }
+
+    void DynamicBVH::QueryOverlap(const AABB& bounds, std::vector<void*>& outUserData) const
+    {
+        if (m_Root == NullNode)
+        {
+            return;
+        }
+
+        m_Stack.clear();
+        m_Stack.push_back(m_Root);
+        while (!m_Stack.empty())
+        {
+            int32_t index = m_Stack.back();
+            m_Stack.pop_back();
+            const Node& node = m_Nodes[index];
+            if (!node.bounds.Overlaps(bounds))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                outUserData.push_back(node.userData);
+            }
+            else
+            {
+                m_Stack.push_back(node.left);
+                m_Stack.push_back(node.right);
+            }
+        }
+    }
+
+    void DynamicBVH::QueryFrustum(const Frustum& frustum, std::vector<void*>& outUserData) const
+    {
+        if (m_Root == NullNode)
+        {
+            return;
+        }
+
+        // Node index and plane mask share one stack entry: the low 6 bits are the
+        // planes the subtree still has to be tested against
+        constexpr uint32_t AllPlanes = (1u << Frustum::PlaneCount) - 1;
+        std::vector<int64_t>& pending = m_FrustumStack;
+        pending.clear();
+        pending.push_back((static_cast<int64_t>(m_Root) << 8) | AllPlanes);
+
+        m_Stack.clear();
+        while (!pending.empty())
+        {
+            int64_t entry = pending.back();
+            pending.pop_back();
+            int32_t index = static_cast<int32_t>(entry >> 8);
+            uint32_t mask = static_cast<uint32_t>(entry & 0xFF);
+            const Node& node = m_Nodes[index];
+
+            glm::vec3 center = node.bounds.GetCenter();
+            glm::vec3 extents = node.bounds.GetExtents();
+            bool outside = false;
+            for (uint32_t plane = 0; plane < Frustum::PlaneCount; plane++)
+            {
+                if (!(mask & (1u << plane)))
+                {
+                    continue;
+                }
+                const glm::vec4& p = frustum.planes[plane];
+                float distance = glm::dot(glm::vec3(p), center) + p.w;
+                float radius = glm::dot(glm::abs(glm::vec3(p)), extents);
+                if (distance + radius < 0.0f)
+                {
+                    outside = true;
+                    break;
+                }
+                if (distance - radius >= 0.0f)
+                {
+                    mask &= ~(1u << plane);
+                }
+            }
+            if (outside)
+            {
+                continue;
+            }
+
+            if (mask == 0)
+            {
+                CollectLeaves(index, outUserData);
+            }
+            else if (node.IsLeaf())
+            {
+                outUserData.push_back(node.userData);
+            }
+            else
+            {
+                pending.push_back((static_cast<int64_t>(node.left) << 8) | mask);
+                pending.push_back((static_cast<int64_t>(node.right) << 8) | mask);
+            }
+        }
+    }
+
+}
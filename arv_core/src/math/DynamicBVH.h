@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "AABB.h"
+#include "Frustum.h"
+
+namespace arv {
+
+    /**
+     * Incrementally updated bounding volume hierarchy over moving boxes.
+     *
+     * Every proxy is stored with a "fat" box, its bounds enlarged by a margin.
+     * Moving a proxy only touches the tree when its new bounds leave the fat box
+     * (or the fat box has become much too large). The leaf is then removed and
+     * re-inserted, and the ancestors are refitted and rebalanced with AVL
+     * rotations. Moving a few percent of the proxies per frame therefore costs
+     * O(k log n), not a rebuild.
+     *
+     * Insertion picks the sibling with the lowest surface area cost.
+     * Queries are not thread-safe: they share the traversal stacks.
+     */
+    class DynamicBVH {
+    public:
+        static constexpr int32_t NullNode = -1;
+
+        // fatMargin is relative to the box size
+        explicit DynamicBVH(float fatMargin = 0.1f);
+
+        // Returns the proxy id
+        int32_t CreateProxy(const AABB& bounds, void* userData);
+        void DestroyProxy(int32_t proxy);
+
+        // Returns true if the proxy had to be re-inserted
+        bool MoveProxy(int32_t proxy, const AABB& bounds);
+
+        void* GetUserData(int32_t proxy) const { return m_Nodes[proxy].userData; }
+        const AABB& GetFatBounds(int32_t proxy) const { return m_Nodes[proxy].bounds; }
+
+        void Clear();
+
+        uint32_t GetProxyCount() const { return m_ProxyCount; }
+        int32_t GetHeight() const { return m_Root == NullNode ? 0 : m_Nodes[m_Root].height; }
+
+        // Appends the user data of every proxy whose fat box overlaps bounds
+        void QueryOverlap(const AABB& bounds, std::vector<void*>& outUserData) const;
+
+        // Appends the user data of every proxy whose fat box intersects the frustum.
+        // Subtrees fully inside a plane stop testing it; subtrees fully inside all
+        // planes are collected without further tests.
+        void QueryFrustum(const Frustum& frustum, std::vector<void*>& outUserData) const;
+
+        // Visits proxies whose fat box the ray hits within maxDistance, nearer
+        // subtrees first. The callback is called as float(void* userData, float entryDistance)
+        // and returns the new maximum distance (return maxDistance to keep going,
+        // a hit distance to clip, or a negative value to stop).
+        template<typename Callback>
+        void QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const;
+
+    private:
+        struct Node {
+            AABB bounds;
+            void* userData = nullptr;
+            int32_t parent = NullNode;   // Next free node while on the free list
+            int32_t left = NullNode;
+            int32_t right = NullNode;
+            int32_t height = 0;          // Leaf = 0, free = -1
+
+            bool IsLeaf() const { return left == NullNode; }
+        };
+
+        AABB Fatten(const AABB& bounds) const;
+        int32_t AllocateNode();
+        void FreeNode(int32_t node);
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        void Refit(int32_t node);
+        int32_t Balance(int32_t node);
+        void CollectLeaves(int32_t node, std::vector<void*>& outUserData) const;
+
+        std::vector<Node> m_Nodes;
+        int32_t m_Root = NullNode;
+        int32_t m_FreeList = NullNode;
+        uint32_t m_ProxyCount = 0;
+        float m_FatMargin;
+
+        mutable std::vector<int32_t> m_Stack;
+        mutable std::vector<int64_t> m_FrustumStack;
+    };
+
+    template<typename Callback>
+    void DynamicBVH::QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const
+    {
+        if (m_Root == NullNode)
+        {
+            return;
+        }
+
+        glm::vec3 inverseDirection = 1.0f / direction;
+        float entry;
+        if (!m_Nodes[m_Root].bounds.IntersectRay(origin, inverseDirection, maxDistance, entry))
+        {
+            return;
+        }
+
+        m_Stack.clear();
+        m_Stack.push_back(m_Root);
+        while (!m_Stack.empty())
+        {
+            int32_t index = m_Stack.back();
+            m_Stack.pop_back();
+            const Node& node = m_Nodes[index];
+
+            if (!node.bounds.IntersectRay(origin, inverseDirection, maxDistance, entry))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                float newMax = callback(node.userData, entry);
+                if (newMax < 0.0f)
+                {
+                    return;
+                }
+                maxDistance = newMax < maxDistance ? newMax : maxDistance;
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited next
+            float leftEntry, rightEntry;
+            bool hitLeft = m_Nodes[node.left].bounds.IntersectRay(origin, inverseDirection, maxDistance, leftEntry);
+            bool hitRight = m_Nodes[node.right].bounds.IntersectRay(origin, inverseDirection, maxDistance, rightEntry);
+            if (hitLeft && hitRight)
+            {
+                bool leftFirst = leftEntry <= rightEntry;
+                m_Stack.push_back(leftFirst ? node.right : node.left);
+                m_Stack.push_back(leftFirst ? node.left : node.right);
+            }
+            else if (hitLeft)
+            {
+                m_Stack.push_back(node.left);
+            }
+            else if (hitRight)
+            {
+                m_Stack.push_back(node.right);
+            }
+        }
+    }
+
+}
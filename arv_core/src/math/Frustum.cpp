@@ -0,0 +1,162 @@
+#include "Frustum.h"
+#include "SimdLane.h"
+
+#include <cmath>
+
+namespace arv {
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Frustum //////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection)
+    {
+        // Gribb/Hartmann: each clip-space bound -w <= x,y,z <= w is a plane
+        // built from the matrix rows
+        auto row = [&viewProjection](int index) {
+            return glm::vec4(viewProjection[0][index], viewProjection[1][index],
+                             viewProjection[2][index], viewProjection[3][index]);
+        };
+
+        Frustum frustum;
+        frustum.planes[Left] = row(3) + row(0);
+        frustum.planes[Right] = row(3) - row(0);
+        frustum.planes[Bottom] = row(3) + row(1);
+        frustum.planes[Top] = row(3) - row(1);
+        frustum.planes[Near] = row(3) + row(2);
+        frustum.planes[Far] = row(3) - row(2);
+
+        for (glm::vec4& plane : frustum.planes)
+        {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+            {
+                plane /= length;
+            }
+        }
+        return frustum;
+    }
+
+    bool Frustum::IntersectsBox(const glm::vec3& center, const glm::vec3& extents) const
+    {
+        for (const glm::vec4& plane : planes)
+        {
+            glm::vec3 normal(plane);
+            float distance = glm::dot(normal, center) + plane.w;
+            float radius = glm::dot(glm::abs(normal), extents);
+            if (distance + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TransformBounds(const glm::mat4& model, const glm::vec3& localMin, const glm::vec3& localMax,
+                         glm::vec3& outCenter, glm::vec3& outExtents)
+    {
+        glm::vec3 center = (localMin + localMax) * 0.5f;
+        glm::vec3 extents = (localMax - localMin) * 0.5f;
+
+        // Arvo: the extents along each world axis are the absolute rows of the
+        // upper 3x3 applied to the local extents
+        glm::mat3 linear(model);
+        outCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+        outExtents = glm::abs(linear[0]) * extents.x + glm::abs(linear[1]) * extents.y + glm::abs(linear[2]) * extents.z;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    // BoxCullBatch /////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    struct BoxStreams {
+        const float* cx; const float* cy; const float* cz;
+        const float* ex; const float* ey; const float* ez;
+        uint8_t* visible;
+    };
+
+    // Tests L::Width boxes starting at index against all planes; a box is
+    // visible if its signed distance plus projected radius is never negative
+    template<typename L>
+    static uint32_t CullBlock(const BoxStreams& in, const Frustum& frustum, uint32_t index)
+    {
+        using T = typename L::Type;
+        constexpr uint32_t W = L::Width;
+
+        T cx = L::Load(in.cx + index);
+        T cy = L::Load(in.cy + index);
+        T cz = L::Load(in.cz + index);
+        T ex = L::Load(in.ex + index);
+        T ey = L::Load(in.ey + index);
+        T ez = L::Load(in.ez + index);
+
+        T minDistance = L::Set(1.0f);
+        for (const glm::vec4& plane : frustum.planes)
+        {
+            T distance = L::Add(L::Add(L::Mul(L::Set(plane.x), cx), L::Mul(L::Set(plane.y), cy)),
+                                L::Add(L::Mul(L::Set(plane.z), cz), L::Set(plane.w)));
+            T radius = L::Add(L::Add(L::Mul(L::Set(std::fabs(plane.x)), ex), L::Mul(L::Set(std::fabs(plane.y)), ey)),
+                              L::Mul(L::Set(std::fabs(plane.z)), ez));
+            minDistance = L::Min(minDistance, L::Add(distance, radius));
+        }
+
+        alignas(32) float lanes[W];
+        L::Store(lanes, minDistance);
+
+        uint32_t visibleCount = 0;
+        for (uint32_t lane = 0; lane < W; lane++)
+        {
+            uint8_t visible = lanes[lane] >= 0.0f ? 1 : 0;
+            in.visible[index + lane] = visible;
+            visibleCount += visible;
+        }
+        return visibleCount;
+    }
+
+    void BoxCullBatch::Clear()
+    {
+        m_CenterX.clear(); m_CenterY.clear(); m_CenterZ.clear();
+        m_ExtentX.clear(); m_ExtentY.clear(); m_ExtentZ.clear();
+    }
+
+    void BoxCullBatch::Reserve(uint32_t count)
+    {
+        m_CenterX.reserve(count); m_CenterY.reserve(count); m_CenterZ.reserve(count);
+        m_ExtentX.reserve(count); m_ExtentY.reserve(count); m_ExtentZ.reserve(count);
+        m_Visible.reserve(count);
+    }
+
+    uint32_t BoxCullBatch::Add(const glm::vec3& center, const glm::vec3& extents)
+    {
+        uint32_t index = GetCount();
+        m_CenterX.push_back(center.x); m_CenterY.push_back(center.y); m_CenterZ.push_back(center.z);
+        m_ExtentX.push_back(extents.x); m_ExtentY.push_back(extents.y); m_ExtentZ.push_back(extents.z);
+        return index;
+    }
+
+    uint32_t BoxCullBatch::Cull(const Frustum& frustum)
+    {
+        uint32_t count = GetCount();
+        m_Visible.resize(count);
+
+        BoxStreams streams;
+        streams.cx = m_CenterX.data(); streams.cy = m_CenterY.data(); streams.cz = m_CenterZ.data();
+        streams.ex = m_ExtentX.data(); streams.ey = m_ExtentY.data(); streams.ez = m_ExtentZ.data();
+        streams.visible = m_Visible.data();
+
+        uint32_t visibleCount = 0;
+        uint32_t index = 0;
+#if defined(ARV_SIMD_AVX2) || defined(ARV_SIMD_NEON)
+        for (; index + SimdLane::Width <= count; index += SimdLane::Width)
+        {
+            visibleCount += CullBlock<SimdLane>(streams, frustum, index);
+        }
+#endif
+        for (; index < count; index++)
+        {
+            visibleCount += CullBlock<ScalarLane>(streams, frustum, index);
+        }
+        return visibleCount;
+    }
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace arv {
+
+    /**
+     * View frustum as six planes (xyz = inward normal, w = distance) extracted
+     * from a view-projection matrix. A point p is inside a plane if
+     * dot(plane.xyz, p) + plane.w >= 0.
+     */
+    struct Frustum {
+        enum Plane { Left = 0, Right, Bottom, Top, Near, Far, PlaneCount };
+
+        glm::vec4 planes[PlaneCount];
+
+        static Frustum FromViewProjection(const glm::mat4& viewProjection);
+
+        // Conservative test: false only if the box is fully outside one plane
+        bool IntersectsBox(const glm::vec3& center, const glm::vec3& extents) const;
+    };
+
+    // World-space bounds (center + half extents) of a local AABB under an affine transform
+    void TransformBounds(const glm::mat4& model, const glm::vec3& localMin, const glm::vec3& localMax,
+                         glm::vec3& outCenter, glm::vec3& outExtents);
+
+    /**
+     * Axis-aligned boxes tested against a frustum in one pass.
+     *
+     * Boxes are stored as structure-of-arrays (center + half extents) so Cull()
+     * handles 8 (AVX2) or 4 (NEON) boxes per instruction, using the same lane
+     * kernels as TransformBatch.
+     */
+    class BoxCullBatch {
+    public:
+        void Clear();
+        void Reserve(uint32_t count);
+
+        // Returns the index of the new box
+        uint32_t Add(const glm::vec3& center, const glm::vec3& extents);
+
+        // Updates the visibility flags and returns the number of visible boxes
+        uint32_t Cull(const Frustum& frustum);
+
+        uint32_t GetCount() const { return static_cast<uint32_t>(m_CenterX.size()); }
+        bool IsVisible(uint32_t index) const { return m_Visible[index] != 0; }
+        glm::vec3 GetCenter(uint32_t index) const { return glm::vec3(m_CenterX[index], m_CenterY[index], m_CenterZ[index]); }
+        glm::vec3 GetExtents(uint32_t index) const { return glm::vec3(m_ExtentX[index], m_ExtentY[index], m_ExtentZ[index]); }
+
+    private:
+        std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+        std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+        std::vector<uint8_t> m_Visible;
+    };
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace arv {
+
+    struct Ray {
+        glm::vec3 origin{0.0f};
+        glm::vec3 direction{0.0f, 0.0f, -1.0f};  // Not necessarily normalized
+
+        glm::vec3 GetPoint(float distance) const { return origin + direction * distance; }
+
+        // Ray through a pixel (origin top-left) from the near to the far plane.
+        // The direction spans the whole depth range, so distances are in [0, 1].
+        static Ray FromScreenPoint(const glm::mat4& inverseViewProjection, const glm::vec2& pixel, const glm::vec2& viewportSize)
+        {
+            glm::vec2 ndc(2.0f * pixel.x / viewportSize.x - 1.0f, 1.0f - 2.0f * pixel.y / viewportSize.y);
+            glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+            glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+
+            Ray ray;
+            ray.origin = glm::vec3(nearPoint) / nearPoint.w;
+            ray.direction = glm::vec3(farPoint) / farPoint.w - ray.origin;
+            return ray;
+        }
+
+        // Same ray in the space of an affine transform's inverse; distances are preserved
+        Ray Transformed(const glm::mat4& transform) const
+        {
+            Ray ray;
+            ray.origin = glm::vec3(transform * glm::vec4(origin, 1.0f));
+            ray.direction = glm::vec3(transform * glm::vec4(direction, 0.0f));
+            return ray;
+        }
+    };
+
+}
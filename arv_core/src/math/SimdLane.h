@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ARV_SIMD_AVX2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ARV_SIMD_NEON 1
+#endif
+
+namespace arv {
+
+    // Lane types for the math kernels. Every kernel is written once against
+    // this minimal interface and instantiated for the widest lane type the
+    // compiler targets. The scalar lane also handles the tail of a batch so
+    // all elements see identical math.
+
+    struct ScalarLane {
+        using Type = float;
+        static constexpr uint32_t Width = 1;
+        static Type Load(const float* p) { return *p; }
+        static void Store(float* p, Type v) { *p = v; }
+        static Type Set(float v) { return v; }
+        static Type Add(Type a, Type b) { return a + b; }
+        static Type Sub(Type a, Type b) { return a - b; }
+        static Type Mul(Type a, Type b) { return a * b; }
+        static Type Div(Type a, Type b) { return a / b; }
+        static Type Min(Type a, Type b) { return std::min(a, b); }
+        static Type Max(Type a, Type b) { return std::max(a, b); }
+        static Type Floor(Type a) { return std::floor(a); }
+    };
+
+#if defined(ARV_SIMD_AVX2)
+    struct SimdLane {
+        using Type = __m256;
+        static constexpr uint32_t Width = 8;
+        static Type Load(const float* p) { return _mm256_loadu_ps(p); }
+        static void Store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+        static Type Set(float v) { return _mm256_set1_ps(v); }
+        static Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+        static Type Sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+        static Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+        static Type Div(Type a, Type b) { return _mm256_div_ps(a, b); }
+        static Type Min(Type a, Type b) { return _mm256_min_ps(a, b); }
+        static Type Max(Type a, Type b) { return _mm256_max_ps(a, b); }
+        static Type Floor(Type a) { return _mm256_floor_ps(a); }
+    };
+    static constexpr const char* SimdKernelName = "AVX2";
+#elif defined(ARV_SIMD_NEON)
+    struct SimdLane {
+        using Type = float32x4_t;
+        static constexpr uint32_t Width = 4;
+        static Type Load(const float* p) { return vld1q_f32(p); }
+        static void Store(float* p, Type v) { vst1q_f32(p, v); }
+        static Type Set(float v) { return vdupq_n_f32(v); }
+        static Type Add(Type a, Type b) { return vaddq_f32(a, b); }
+        static Type Sub(Type a, Type b) { return vsubq_f32(a, b); }
+        static Type Mul(Type a, Type b) { return vmulq_f32(a, b); }
+        static Type Div(Type a, Type b) { return vdivq_f32(a, b); }
+        static Type Min(Type a, Type b) { return vminq_f32(a, b); }
+        static Type Max(Type a, Type b) { return vmaxq_f32(a, b); }
+        static Type Floor(Type a) { return vrndmq_f32(a); }
+    };
+    static constexpr const char* SimdKernelName = "NEON";
+#else
+    static constexpr const char* SimdKernelName = "Scalar";
+#endif
+
+}
@@ -0,0 +1,213 @@
+#include "TransformBatch.h"
+#include "SimdLane.h"
+
+#include <cmath>
+
+namespace arv {
+
+    /////////////////////////////////////////////////////////////////////////////
+    // Kernels //////////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    // Branch-free sin/cos (Cephes polynomials on [-pi/4, pi/4]); the quadrant
+    // fix-up is done with floor() arithmetic so it maps onto any lane type.
+    template<typename L>
+    static void SinCos(typename L::Type x, typename L::Type& outSin, typename L::Type& outCos)
+    {
+        using T = typename L::Type;
+
+        T q = L::Floor(L::Add(L::Mul(x, L::Set(0.63661977236758134308f)), L::Set(0.5f)));
+
+        // x - q * pi/2 with pi/2 split in three parts to keep precision
+        T r = L::Sub(x, L::Mul(q, L::Set(1.5703125f)));
+        r = L::Sub(r, L::Mul(q, L::Set(4.837512969970703125e-4f)));
+        r = L::Sub(r, L::Mul(q, L::Set(7.54978995489188216e-8f)));
+
+        T z = L::Mul(r, r);
+
+        T sinPoly = L::Set(-1.9515295891e-4f);
+        sinPoly = L::Add(L::Mul(sinPoly, z), L::Set(8.3321608736e-3f));
+        sinPoly = L::Add(L::Mul(sinPoly, z), L::Set(-1.6666654611e-1f));
+        T sinR = L::Add(r, L::Mul(L::Mul(r, z), sinPoly));
+
+        T cosPoly = L::Set(2.443315711809948e-5f);
+        cosPoly = L::Add(L::Mul(cosPoly, z), L::Set(-1.388731625493765e-3f));
+        cosPoly = L::Add(L::Mul(cosPoly, z), L::Set(4.166664568298827e-2f));
+        T cosR = L::Add(L::Sub(L::Set(1.0f), L::Mul(z, L::Set(0.5f))), L::Mul(L::Mul(z, z), cosPoly));
+
+        // quadrant = q mod 4 in [0, 3]
+        T quadrant = L::Sub(q, L::Mul(L::Set(4.0f), L::Floor(L::Mul(q, L::Set(0.25f)))));
+        T odd = L::Sub(quadrant, L::Mul(L::Set(2.0f), L::Floor(L::Mul(quadrant, L::Set(0.5f)))));
+        T sinNegative = L::Floor(L::Mul(quadrant, L::Set(0.5f)));
+        T shifted = L::Add(quadrant, L::Set(1.0f));
+        shifted = L::Sub(shifted, L::Mul(L::Set(4.0f), L::Floor(L::Mul(shifted, L::Set(0.25f)))));
+        T cosNegative = L::Floor(L::Mul(shifted, L::Set(0.5f)));
+
+        T s = L::Add(sinR, L::Mul(odd, L::Sub(cosR, sinR)));
+        T c = L::Add(cosR, L::Mul(odd, L::Sub(sinR, cosR)));
+        outSin = L::Mul(s, L::Sub(L::Set(1.0f), L::Mul(L::Set(2.0f), sinNegative)));
+        outCos = L::Mul(c, L::Sub(L::Set(1.0f), L::Mul(L::Set(2.0f), cosNegative)));
+    }
+
+    struct TransformStreams {
+        const float* px; const float* py; const float* pz;
+        const float* rx; const float* ry; const float* rz;
+        const float* sx; const float* sy; const float* sz;
+        glm::mat4* models;
+        glm::mat4* mvps;
+    };
+
+    // Composes L::Width transforms starting at index
+    template<typename L>
+    static void ComposeBlock(const TransformStreams& in, const glm::mat4& viewProjection, uint32_t index)
+    {
+        using T = typename L::Type;
+        constexpr uint32_t W = L::Width;
+
+        const T toRadians = L::Set(0.01745329251994329577f);
+        T sinX, cosX, sinY, cosY, sinZ, cosZ;
+        SinCos<L>(L::Mul(L::Load(in.rx + index), toRadians), sinX, cosX);
+        SinCos<L>(L::Mul(L::Load(in.ry + index), toRadians), sinY, cosY);
+        SinCos<L>(L::Mul(L::Load(in.rz + index), toRadians), sinZ, cosZ);
+
+        T scaleX = L::Load(in.sx + index);
+        T scaleY = L::Load(in.sy + index);
+        T scaleZ = L::Load(in.sz + index);
+
+        // R = Ry * Rx * Rz, columns scaled by the object scale
+        T sxsz = L::Mul(sinX, sinZ);
+        T sxcz = L::Mul(sinX, cosZ);
+        T model[4][3];
+        model[0][0] = L::Mul(L::Add(L::Mul(cosY, cosZ), L::Mul(sinY, sxsz)), scaleX);
+        model[0][1] = L::Mul(L::Mul(cosX, sinZ), scaleX);
+        model[0][2] = L::Mul(L::Sub(L::Mul(cosY, sxsz), L::Mul(sinY, cosZ)), scaleX);
+        model[1][0] = L::Mul(L::Sub(L::Mul(sinY, sxcz), L::Mul(cosY, sinZ)), scaleY);
+        model[1][1] = L::Mul(L::Mul(cosX, cosZ), scaleY);
+        model[1][2] = L::Mul(L::Add(L::Mul(sinY, sinZ), L::Mul(cosY, sxcz)), scaleY);
+        model[2][0] = L::Mul(L::Mul(sinY, cosX), scaleZ);
+        model[2][1] = L::Mul(L::Sub(L::Set(0.0f), sinX), scaleZ);
+        model[2][2] = L::Mul(L::Mul(cosY, cosX), scaleZ);
+        model[3][0] = L::Load(in.px + index);
+        model[3][1] = L::Load(in.py + index);
+        model[3][2] = L::Load(in.pz + index);
+
+        // MVP = VP * M, with VP broadcast across the lanes
+        T mvp[4][4];
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                T value = L::Add(L::Add(L::Mul(L::Set(viewProjection[0][row]), model[column][0]),
+                                        L::Mul(L::Set(viewProjection[1][row]), model[column][1])),
+                                 L::Mul(L::Set(viewProjection[2][row]), model[column][2]));
+                if (column == 3)
+                {
+                    value = L::Add(value, L::Set(viewProjection[3][row]));
+                }
+                mvp[column][row] = value;
+            }
+        }
+
+        // Transpose SoA lanes back into one matrix per object
+        alignas(32) float modelLanes[4][3][W];
+        alignas(32) float mvpLanes[4][4][W];
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                L::Store(modelLanes[column][row], model[column][row]);
+            }
+            for (int row = 0; row < 4; row++)
+            {
+                L::Store(mvpLanes[column][row], mvp[column][row]);
+            }
+        }
+
+        for (uint32_t lane = 0; lane < W; lane++)
+        {
+            glm::mat4& outModel = in.models[index + lane];
+            glm::mat4& outMVP = in.mvps[index + lane];
+            for (int column = 0; column < 4; column++)
+            {
+                outModel[column] = glm::vec4(modelLanes[column][0][lane], modelLanes[column][1][lane],
+                                             modelLanes[column][2][lane], column == 3 ? 1.0f : 0.0f);
+                outMVP[column] = glm::vec4(mvpLanes[column][0][lane], mvpLanes[column][1][lane],
+                                           mvpLanes[column][2][lane], mvpLanes[column][3][lane]);
+            }
+        }
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    // TransformBatch ///////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+
+    glm::mat4 ComposeModelMatrix(const glm::vec3& position, const glm::vec3& rotationDegrees, const glm::vec3& scale)
+    {
+        TransformStreams streams;
+        glm::mat4 model, mvp;
+        streams.px = &position.x; streams.py = &position.y; streams.pz = &position.z;
+        streams.rx = &rotationDegrees.x; streams.ry = &rotationDegrees.y; streams.rz = &rotationDegrees.z;
+        streams.sx = &scale.x; streams.sy = &scale.y; streams.sz = &scale.z;
+        streams.models = &model;
+        streams.mvps = &mvp;
+        ComposeBlock<ScalarLane>(streams, glm::mat4(1.0f), 0);
+        return model;
+    }
+
+    void TransformBatch::Clear()
+    {
+        m_PositionX.clear(); m_PositionY.clear(); m_PositionZ.clear();
+        m_RotationX.clear(); m_RotationY.clear(); m_RotationZ.clear();
+        m_ScaleX.clear(); m_ScaleY.clear(); m_ScaleZ.clear();
+    }
+
+    void TransformBatch::Reserve(uint32_t count)
+    {
+        m_PositionX.reserve(count); m_PositionY.reserve(count); m_PositionZ.reserve(count);
+        m_RotationX.reserve(count); m_RotationY.reserve(count); m_RotationZ.reserve(count);
+        m_ScaleX.reserve(count); m_ScaleY.reserve(count); m_ScaleZ.reserve(count);
+        m_Models.reserve(count);
+        m_MVPs.reserve(count);
+    }
+
+    uint32_t TransformBatch::Add(const glm::vec3& position, const glm::vec3& rotationDegrees, const glm::vec3& scale)
+    {
+        uint32_t index = GetCount();
+        m_PositionX.push_back(position.x); m_PositionY.push_back(position.y); m_PositionZ.push_back(position.z);
+        m_RotationX.push_back(rotationDegrees.x); m_RotationY.push_back(rotationDegrees.y); m_RotationZ.push_back(rotationDegrees.z);
+        m_ScaleX.push_back(scale.x); m_ScaleY.push_back(scale.y); m_ScaleZ.push_back(scale.z);
+        return index;
+    }
+
+    void TransformBatch::Compose(const glm::mat4& viewProjection)
+    {
+        uint32_t count = GetCount();
+        m_Models.resize(count);
+        m_MVPs.resize(count);
+
+        TransformStreams streams;
+        streams.px = m_PositionX.data(); streams.py = m_PositionY.data(); streams.pz = m_PositionZ.data();
+        streams.rx = m_RotationX.data(); streams.ry = m_RotationY.data(); streams.rz = m_RotationZ.data();
+        streams.sx = m_ScaleX.data(); streams.sy = m_ScaleY.data(); streams.sz = m_ScaleZ.data();
+        streams.models = m_Models.data();
+        streams.mvps = m_MVPs.data();
+
+        uint32_t index = 0;
+#if defined(ARV_SIMD_AVX2) || defined(ARV_SIMD_NEON)
+        for (; index + SimdLane::Width <= count; index += SimdLane::Width)
+        {
+            ComposeBlock<SimdLane>(streams, viewProjection, index);
+        }
+#endif
+        for (; index < count; index++)
+        {
+            ComposeBlock<ScalarLane>(streams, viewProjection, index);
+        }
+    }
+
+    const char* TransformBatch::GetKernelName()
+    {
+        return SimdKernelName;
+    }
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace arv {
+
+    // Model matrix with the same convention as the rest of the engine:
+    // translate * rotateY * rotateX * rotateZ * scale, Euler angles in degrees
+    glm::mat4 ComposeModelMatrix(const glm::vec3& position, const glm::vec3& rotationDegrees, const glm::vec3& scale);
+
+    /**
+     * Builds model and model-view-projection matrices for many objects at once.
+     *
+     * Transforms are stored as structure-of-arrays so Compose() can process
+     * 8 (AVX2) or 4 (NEON) objects per instruction, including a vectorized
+     * sin/cos for the Euler angles. The kernel is picked at compile time;
+     * the scalar path produces the same results on other targets.
+     */
+    class TransformBatch {
+    public:
+        void Clear();
+        void Reserve(uint32_t count);
+
+        // Returns the index of the new entry
+        uint32_t Add(const glm::vec3& position, const glm::vec3& rotationDegrees, const glm::vec3& scale);
+
+        // Composes all model matrices and multiplies them with viewProjection
+        void Compose(const glm::mat4& viewProjection);
+
+        uint32_t GetCount() const { return static_cast<uint32_t>(m_PositionX.size()); }
+        const glm::mat4& GetModelMatrix(uint32_t index) const { return m_Models[index]; }
+        const glm::mat4& GetMVP(uint32_t index) const { return m_MVPs[index]; }
+
+        // Name of the kernel compiled into this build ("AVX2", "NEON" or "Scalar")
+        static const char* GetKernelName();
+
+    private:
+        std::vector<float> m_PositionX, m_PositionY, m_PositionZ;
+        std::vector<float> m_RotationX, m_RotationY, m_RotationZ;
+        std::vector<float> m_ScaleX, m_ScaleY, m_ScaleZ;
+
+        std::vector<glm::mat4> m_Models;
+        std::vector<glm::mat4> m_MVPs;
+    };
+
+}
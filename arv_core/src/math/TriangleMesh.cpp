@@ -0,0 +1,239 @@
+#include "TriangleMesh.h"
+#include "SimdLane.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace arv {
+
+    // Spreads the low 10 bits of v so there are two zero bits between each
+    static uint32_t ExpandBits(uint32_t v)
+    {
+        v = (v * 0x00010001u) & 0xFF0000FFu;
+        v = (v * 0x00000101u) & 0x0F00F00Fu;
+        v = (v * 0x00000011u) & 0xC30C30C3u;
+        v = (v * 0x00000005u) & 0x49249249u;
+        return v;
+    }
+
+    static uint32_t MortonCode(const glm::vec3& normalized)
+    {
+        glm::vec3 scaled = glm::clamp(normalized * 1024.0f, 0.0f, 1023.0f);
+        return (ExpandBits(static_cast<uint32_t>(scaled.x)) << 2) |
+               (ExpandBits(static_cast<uint32_t>(scaled.y)) << 1) |
+               ExpandBits(static_cast<uint32_t>(scaled.z));
+    }
+
+    struct RayLanes {
+        float ox, oy, oz;
+        float dx, dy, dz;
+    };
+
+    // Moller-Trumbore on L::Width triangles of a block starting at lane offset.
+    // Writes the determinant, the hit distance and a score that is >= 0 when
+    // the barycentrics are inside the triangle and t is in [0, maxDistance].
+    template<typename L>
+    static void IntersectLanes(const float* const* streams, uint32_t offset, const RayLanes& ray, float maxDistance,
+                               float* outDet, float* outT, float* outScore)
+    {
+        using T = typename L::Type;
+
+        T v0x = L::Load(streams[0] + offset), v0y = L::Load(streams[1] + offset), v0z = L::Load(streams[2] + offset);
+        T e1x = L::Load(streams[3] + offset), e1y = L::Load(streams[4] + offset), e1z = L::Load(streams[5] + offset);
+        T e2x = L::Load(streams[6] + offset), e2y = L::Load(streams[7] + offset), e2z = L::Load(streams[8] + offset);
+
+        T dx = L::Set(ray.dx), dy = L::Set(ray.dy), dz = L::Set(ray.dz);
+
+        // p = d x e2
+        T px = L::Sub(L::Mul(dy, e2z), L::Mul(dz, e2y));
+        T py = L::Sub(L::Mul(dz, e2x), L::Mul(dx, e2z));
+        T pz = L::Sub(L::Mul(dx, e2y), L::Mul(dy, e2x));
+        T det = L::Add(L::Add(L::Mul(e1x, px), L::Mul(e1y, py)), L::Mul(e1z, pz));
+        T inverseDet = L::Div(L::Set(1.0f), det);
+
+        // s = o - v0, q = s x e1
+        T sx = L::Sub(L::Set(ray.ox), v0x);
+        T sy = L::Sub(L::Set(ray.oy), v0y);
+        T sz = L::Sub(L::Set(ray.oz), v0z);
+        T qx = L::Sub(L::Mul(sy, e1z), L::Mul(sz, e1y));
+        T qy = L::Sub(L::Mul(sz, e1x), L::Mul(sx, e1z));
+        T qz = L::Sub(L::Mul(sx, e1y), L::Mul(sy, e1x));
+
+        T u = L::Mul(L::Add(L::Add(L::Mul(sx, px), L::Mul(sy, py)), L::Mul(sz, pz)), inverseDet);
+        T v = L::Mul(L::Add(L::Add(L::Mul(dx, qx), L::Mul(dy, qy)), L::Mul(dz, qz)), inverseDet);
+        T t = L::Mul(L::Add(L::Add(L::Mul(e2x, qx), L::Mul(e2y, qy)), L::Mul(e2z, qz)), inverseDet);
+
+        T one = L::Set(1.0f);
+        T score = L::Min(L::Min(u, v), L::Min(L::Sub(one, L::Add(u, v)), t));
+        score = L::Min(score, L::Sub(L::Set(maxDistance), t));
+
+        L::Store(outDet + offset, det);
+        L::Store(outT + offset, t);
+        L::Store(outScore + offset, score);
+    }
+
+    void TriangleMesh::Clear()
+    {
+        m_Blocks.clear();
+        m_Clusters.clear();
+        m_Bounds = AABB();
+        m_TriangleCount = 0;
+    }
+
+    void TriangleMesh::Build(const float* positions, uint32_t stride, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+    {
+        Clear();
+
+        auto vertex = [positions, stride](uint32_t index) {
+            const float* p = positions + static_cast<size_t>(index) * stride;
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+
+        uint32_t triangleCount = indexCount / 3;
+        if (triangleCount == 0 || vertexCount == 0)
+        {
+            return;
+        }
+
+        m_Bounds = AABB(vertex(0), vertex(0));
+        for (uint32_t i = 1; i < vertexCount; i++)
+        {
+            m_Bounds.min = glm::min(m_Bounds.min, vertex(i));
+            m_Bounds.max = glm::max(m_Bounds.max, vertex(i));
+        }
+
+        // Sort triangles along a Morton curve so clusters are spatially compact
+        glm::vec3 size = m_Bounds.max - m_Bounds.min;
+        glm::vec3 inverseSize(size.x > 0.0f ? 1.0f / size.x : 0.0f,
+                              size.y > 0.0f ? 1.0f / size.y : 0.0f,
+                              size.z > 0.0f ? 1.0f / size.z : 0.0f);
+
+        std::vector<std::pair<uint32_t, uint32_t>> order;
+        order.reserve(triangleCount);
+        for (uint32_t triangle = 0; triangle < triangleCount; triangle++)
+        {
+            const uint32_t* tri = indices + triangle * 3;
+            if (tri[0] >= vertexCount || tri[1] >= vertexCount || tri[2] >= vertexCount)
+            {
+                continue;
+            }
+            glm::vec3 centroid = (vertex(tri[0]) + vertex(tri[1]) + vertex(tri[2])) * (1.0f / 3.0f);
+            order.emplace_back(MortonCode((centroid - m_Bounds.min) * inverseSize), triangle);
+        }
+        std::sort(order.begin(), order.end());
+
+        m_TriangleCount = static_cast<uint32_t>(order.size());
+        uint32_t blockCount = (m_TriangleCount + BlockWidth - 1) / BlockWidth;
+        m_Blocks.assign(blockCount, Block{});
+        m_Clusters.reserve((blockCount + BlocksPerCluster - 1) / BlocksPerCluster);
+
+        for (uint32_t sorted = 0; sorted < m_TriangleCount; sorted++)
+        {
+            const uint32_t* tri = indices + order[sorted].second * 3;
+            glm::vec3 v0 = vertex(tri[0]);
+            glm::vec3 v1 = vertex(tri[1]);
+            glm::vec3 v2 = vertex(tri[2]);
+
+            uint32_t blockIndex = sorted / BlockWidth;
+            uint32_t lane = sorted % BlockWidth;
+            Block& block = m_Blocks[blockIndex];
+            block.v0x[lane] = v0.x; block.v0y[lane] = v0.y; block.v0z[lane] = v0.z;
+            block.e1x[lane] = v1.x - v0.x; block.e1y[lane] = v1.y - v0.y; block.e1z[lane] = v1.z - v0.z;
+            block.e2x[lane] = v2.x - v0.x; block.e2y[lane] = v2.y - v0.y; block.e2z[lane] = v2.z - v0.z;
+
+            AABB triangleBounds(glm::min(v0, glm::min(v1, v2)), glm::max(v0, glm::max(v1, v2)));
+            uint32_t clusterIndex = blockIndex / BlocksPerCluster;
+            if (clusterIndex == m_Clusters.size())
+            {
+                Cluster cluster;
+                cluster.bounds = triangleBounds;
+                cluster.firstBlock = blockIndex;
+                m_Clusters.push_back(cluster);
+            }
+            Cluster& cluster = m_Clusters[clusterIndex];
+            cluster.bounds = AABB::Union(cluster.bounds, triangleBounds);
+            cluster.blockCount = blockIndex - cluster.firstBlock + 1;
+        }
+    }
+
+    bool TriangleMesh::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& outDistance) const
+    {
+        if (m_TriangleCount == 0)
+        {
+            return false;
+        }
+
+        glm::vec3 inverseDirection = 1.0f / direction;
+        float entry;
+        if (!m_Bounds.IntersectRay(origin, inverseDirection, maxDistance, entry))
+        {
+            return false;
+        }
+
+        m_ClusterHits.clear();
+        for (uint32_t i = 0; i < m_Clusters.size(); i++)
+        {
+            if (m_Clusters[i].bounds.IntersectRay(origin, inverseDirection, maxDistance, entry))
+            {
+                m_ClusterHits.emplace_back(entry, i);
+            }
+        }
+        std::sort(m_ClusterHits.begin(), m_ClusterHits.end());
+
+        RayLanes ray{origin.x, origin.y, origin.z, direction.x, direction.y, direction.z};
+        float closest = maxDistance;
+        bool hit = false;
+
+        alignas(32) float det[BlockWidth];
+        alignas(32) float t[BlockWidth];
+        alignas(32) float score[BlockWidth];
+
+        for (const auto& [clusterEntry, clusterIndex] : m_ClusterHits)
+        {
+            if (clusterEntry > closest)
+            {
+                break;
+            }
+
+            const Cluster& cluster = m_Clusters[clusterIndex];
+            for (uint32_t b = 0; b < cluster.blockCount; b++)
+            {
+                const Block& block = m_Blocks[cluster.firstBlock + b];
+                const float* streams[9] = {
+                    block.v0x, block.v0y, block.v0z,
+                    block.e1x, block.e1y, block.e1z,
+                    block.e2x, block.e2y, block.e2z
+                };
+
+                uint32_t offset = 0;
+#if defined(ARV_SIMD_AVX2) || defined(ARV_SIMD_NEON)
+                for (; offset < BlockWidth; offset += SimdLane::Width)
+                {
+                    IntersectLanes<SimdLane>(streams, offset, ray, closest, det, t, score);
+                }
+#endif
+                for (; offset < BlockWidth; offset++)
+                {
+                    IntersectLanes<ScalarLane>(streams, offset, ray, closest, det, t, score);
+                }
+
+                // Degenerate triangles and rays parallel to the plane have det == 0
+                for (uint32_t lane = 0; lane < BlockWidth; lane++)
+                {
+                    if (std::fabs(det[lane]) > 1e-30f && score[lane] >= 0.0f && t[lane] < closest)
+                    {
+                        closest = t[lane];
+                        hit = true;
+                    }
+                }
+            }
+        }
+
+        if (hit)
+        {
+            outDistance = closest;
+        }
+        return hit;
+    }
+
+}
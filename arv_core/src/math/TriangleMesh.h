@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "AABB.h"
+
+namespace arv {
+
+    /**
+     * CPU-side copy of a triangle mesh laid out for ray casts.
+     *
+     * Triangles are sorted along a Morton curve of their centroids and stored
+     * as structure-of-arrays blocks of 8 (first vertex plus two edges), so the
+     * Moller-Trumbore test runs on 8 (AVX2) or 4 (NEON) triangles per
+     * instruction. Every 64 consecutive triangles form a cluster with its own
+     * bounds; a ray only tests the clusters it enters, nearest first.
+     */
+    class TriangleMesh {
+    public:
+        static constexpr uint32_t BlockWidth = 8;
+        static constexpr uint32_t BlocksPerCluster = 8;
+
+        TriangleMesh() = default;
+
+        // positions points at the first vertex; stride is in floats (3 for tightly packed positions)
+        void Build(const float* positions, uint32_t stride, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+        void Clear();
+
+        bool IsEmpty() const { return m_TriangleCount == 0; }
+        uint32_t GetTriangleCount() const { return m_TriangleCount; }
+        const AABB& GetBounds() const { return m_Bounds; }
+
+        // Closest hit along origin + t * direction with t in [0, maxDistance].
+        // Triangles are two-sided. Returns false if nothing was hit.
+        bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float& outDistance) const;
+
+    private:
+        // One block of 8 triangles: v0, e1 = v1 - v0, e2 = v2 - v0 per axis.
+        // Unused slots are degenerate (zero edges) and never hit.
+        struct Block {
+            float v0x[BlockWidth], v0y[BlockWidth], v0z[BlockWidth];
+            float e1x[BlockWidth], e1y[BlockWidth], e1z[BlockWidth];
+            float e2x[BlockWidth], e2y[BlockWidth], e2z[BlockWidth];
+        };
+
+        struct Cluster {
+            AABB bounds;
+            uint32_t firstBlock = 0;
+            uint32_t blockCount = 0;
+        };
+
+        std::vector<Block> m_Blocks;
+        std::vector<Cluster> m_Clusters;
+        AABB m_Bounds;
+        uint32_t m_TriangleCount = 0;
+
+        mutable std::vector<std::pair<float, uint32_t>> m_ClusterHits;
+    };
+
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#define ARV_SIMD_F16C 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ARV_SIMD_NEON_F16 1
+#endif
+
+namespace arv {
+
+    // IEEE 754 binary16, round to nearest even. Out-of-range values become
+    // infinity; NaN stays NaN.
+    inline uint16_t FloatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+        if (magnitude >= 0x7F800000u) {
+            // Inf or NaN; keep NaNs quiet
+            return static_cast<uint16_t>(sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x0200u : 0u));
+        }
+        if (magnitude >= 0x477FF000u) {
+            // Rounds to or past 65520
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        }
+        if (magnitude < 0x38800000u) {
+            // Subnormal half: shift the mantissa, with the implicit bit, into place
+            if (magnitude < 0x33000000u) {
+                return static_cast<uint16_t>(sign);
+            }
+            uint32_t exponent = magnitude >> 23;
+            uint32_t mantissa = (magnitude & 0x007FFFFFu) | 0x00800000u;
+            uint32_t shift = 126 - exponent;
+            uint32_t half = mantissa >> shift;
+            uint32_t remainder = mantissa & ((1u << shift) - 1);
+            uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+                half++;
+            }
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        // Normal: rebias the exponent and round the mantissa from 23 to 10 bits
+        uint32_t half = (magnitude - 0x38000000u) >> 13;
+        uint32_t remainder = magnitude & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    inline float HalfToFloat(uint16_t half)
+    {
+        uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        uint32_t exponent = (half >> 10) & 0x1Fu;
+        uint32_t mantissa = half & 0x03FFu;
+
+        uint32_t bits;
+        if (exponent == 0x1Fu) {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        } else if (exponent != 0) {
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        } else if (mantissa != 0) {
+            // Subnormal half: normalize
+            exponent = 113;
+            while ((mantissa & 0x0400u) == 0) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x03FFu) << 13);
+        } else {
+            bits = sign;
+        }
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // FloatToHalf() over an array: eight values per instruction with F16C,
+    // four with NEON, the scalar version for the rest. The hardware rounds to
+    // nearest even like the scalar version; only NaN payloads may differ.
+    inline void FloatToHalf(const float* values, uint16_t* halves, size_t count)
+    {
+        size_t i = 0;
+#if defined(ARV_SIMD_F16C)
+        for (; i + 8 <= count; i += 8) {
+            __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(halves + i), packed);
+        }
+#elif defined(ARV_SIMD_NEON_F16)
+        for (; i + 4 <= count; i += 4) {
+            vst1_u16(halves + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(values + i))));
+        }
+#endif
+        for (; i < count; i++) {
+            halves[i] = FloatToHalf(values[i]);
+        }
+    }
+
+    inline void HalfToFloat(const uint16_t* halves, float* values, size_t count)
+    {
+        size_t i = 0;
+#if defined(ARV_SIMD_F16C)
+        for (; i + 8 <= count; i += 8) {
+            __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halves + i));
+            _mm256_storeu_ps(values + i, _mm256_cvtph_ps(packed));
+        }
+#elif defined(ARV_SIMD_NEON_F16)
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(values + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(halves + i))));
+        }
+#endif
+        for (; i < count; i++) {
+            values[i] = HalfToFloat(halves[i]);
+        }
+    }
+
+    // Unit vector to a point in [-1, 1]^2: the octahedron |x| + |y| + |z| = 1
+    // with its lower half folded over the diagonals
+    inline glm::vec2 OctahedralEncode(const glm::vec3& n)
+    {
+        float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (l1 <= 0.0f) {
+            return glm::vec2(0.0f);
+        }
+        glm::vec2 p(n.x / l1, n.y / l1);
+        if (n.z < 0.0f) {
+            p = glm::vec2((1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+        }
+        return p;
+    }
+
+    // Inverse of OctahedralEncode; matches the GLSL decode in ObjAssetRO
+    inline glm::vec3 OctahedralDecode(const glm::vec2& e)
+    {
+        glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    inline int16_t FloatToSnorm16(float value)
+    {
+        return static_cast<int16_t>(std::lround(glm::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    inline uint16_t FloatToUnorm16(float value)
+    {
+        return static_cast<uint16_t>(std::lround(glm::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+}
@@ -0,0 +1,268 @@
+#include "CookedMesh.h"
+#include "ARVBase.h"
+#include "utils/SourceStamp.h"
+
+#include <cstring>
+
+namespace arv {
+
+    namespace {
+
+        constexpr char MeshFileMagic[8] = { 'A', 'R', 'V', 'M', 'E', 'S', 'H', '\0' };
+
+        struct MeshFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t vertexStride;
+            uint64_t sourceSize;
+            int64_t sourceModifiedTime;
+            uint64_t sourceHash;
+            uint32_t vertexCount;
+            uint32_t indexCount;
+            uint32_t submeshCount;
+            uint32_t materialCount;
+            uint32_t lodCount;
+            float boundsMin[3];
+            float boundsMax[3];
+            uint64_t vertexOffset;
+            uint64_t indexOffset;
+            uint64_t submeshOffset;
+            uint64_t lodOffset;
+            uint64_t materialOffset;  // Each material is a uint32_t length followed by the characters
+        };
+        static_assert(sizeof(MeshSubmesh) == 12, "MeshSubmesh is stored as is");
+        static_assert(sizeof(MeshLod) == 20, "MeshLod is stored as is");
+
+    }
+
+    bool CookedMesh::Load(const std::string& cachePath, const std::string& sourcePath)
+    {
+        MappedFile file;
+        if (!file.Open(cachePath)) {
+            return false;
+        }
+
+        MeshFileHeader header;
+        if (file.GetSize() < sizeof(header)) {
+            ARV_LOG_WARN("CookedMesh::Load() - {} is truncated", cachePath);
+            return false;
+        }
+        std::memcpy(&header, file.GetData(), sizeof(header));
+
+        if (std::memcmp(header.magic, MeshFileMagic, sizeof(MeshFileMagic)) != 0 ||
+            header.version != Version || header.vertexStride != VertexStride) {
+            ARV_LOG_INFO("CookedMesh::Load() - {} has an unknown format or version, ignoring it", cachePath);
+            return false;
+        }
+
+        SourceStamp cooked;
+        cooked.size = header.sourceSize;
+        cooked.modifiedTime = header.sourceModifiedTime;
+        cooked.hash = header.sourceHash;
+        if (!cooked.Matches(sourcePath)) {
+            ARV_LOG_INFO("CookedMesh::Load() - {} is out of date", cachePath);
+            return false;
+        }
+
+        uint64_t fileSize = file.GetSize();
+        uint64_t vertexBytes = uint64_t(header.vertexCount) * VertexStride * sizeof(float);
+        uint64_t indexBytes = uint64_t(header.indexCount) * sizeof(uint32_t);
+        uint64_t submeshBytes = uint64_t(header.submeshCount) * sizeof(MeshSubmesh);
+        uint64_t lodBytes = uint64_t(header.lodCount) * sizeof(MeshLod);
+        if (header.lodCount == 0 ||
+            !SectionInFile(header.vertexOffset, vertexBytes, fileSize) ||
+            !SectionInFile(header.indexOffset, indexBytes, fileSize) ||
+            !SectionInFile(header.submeshOffset, submeshBytes, fileSize) ||
+            !SectionInFile(header.lodOffset, lodBytes, fileSize) ||
+            !SectionInFile(header.materialOffset, 0, fileSize)) {
+            ARV_LOG_WARN("CookedMesh::Load() - {} is corrupt", cachePath);
+            return false;
+        }
+
+        const MeshLod* lods = reinterpret_cast<const MeshLod*>(file.GetData() + header.lodOffset);
+        const MeshSubmesh* submeshes = reinterpret_cast<const MeshSubmesh*>(file.GetData() + header.submeshOffset);
+        for (uint32_t i = 0; i < header.lodCount; i++) {
+            if (uint64_t(lods[i].firstIndex) + lods[i].indexCount > header.indexCount ||
+                uint64_t(lods[i].firstSubmesh) + lods[i].submeshCount > header.submeshCount) {
+                ARV_LOG_WARN("CookedMesh::Load() - {} is corrupt", cachePath);
+                return false;
+            }
+
+            // Submeshes draw straight from the shared buffers, so they must stay inside their LOD
+            for (uint32_t s = lods[i].firstSubmesh; s < lods[i].firstSubmesh + lods[i].submeshCount; s++) {
+                const MeshSubmesh& submesh = submeshes[s];
+                if (submesh.firstIndex < lods[i].firstIndex ||
+                    uint64_t(submesh.firstIndex) + submesh.indexCount > uint64_t(lods[i].firstIndex) + lods[i].indexCount) {
+                    ARV_LOG_WARN("CookedMesh::Load() - {} is corrupt", cachePath);
+                    return false;
+                }
+            }
+        }
+
+        // An index past the vertices would make every backend read out of bounds
+        const uint32_t* indices = reinterpret_cast<const uint32_t*>(file.GetData() + header.indexOffset);
+        for (uint32_t i = 0; i < header.indexCount; i++) {
+            if (indices[i] >= header.vertexCount) {
+                ARV_LOG_WARN("CookedMesh::Load() - {} is corrupt", cachePath);
+                return false;
+            }
+        }
+
+        std::vector<std::string> materialTextures;
+        materialTextures.reserve(header.materialCount);
+        uint64_t cursor = header.materialOffset;
+        for (uint32_t i = 0; i < header.materialCount; i++) {
+            uint32_t length = 0;
+            if (fileSize - cursor < sizeof(length)) {
+                ARV_LOG_WARN("CookedMesh::Load() - {} is corrupt", cachePath);
+                return false;
+            }
+            std::memcpy(&length, file.GetData() + cursor, sizeof(length));
+            cursor += sizeof(length);
+            if (fileSize - cursor < length) {
+                ARV_LOG_WARN("CookedMesh::Load() - {} is corrupt", cachePath);
+                return false;
+            }
+            materialTextures.emplace_back(reinterpret_cast<const char*>(file.GetData() + cursor), length);
+            cursor += length;
+        }
+
+        Clear();
+        m_File = std::move(file);
+
+        // Sections are 16-byte aligned and the mapping is page aligned
+        const std::byte* data = m_File.GetData();
+        m_Vertices = reinterpret_cast<const float*>(data + header.vertexOffset);
+        m_Indices = reinterpret_cast<const uint32_t*>(data + header.indexOffset);
+        m_Submeshes = reinterpret_cast<const MeshSubmesh*>(data + header.submeshOffset);
+        m_Lods = reinterpret_cast<const MeshLod*>(data + header.lodOffset);
+        m_VertexCount = header.vertexCount;
+        m_IndexCount = header.indexCount;
+        m_SubmeshCount = header.submeshCount;
+        m_LodCount = header.lodCount;
+        m_MaterialTextures = std::move(materialTextures);
+        m_BoundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+        m_BoundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+        return true;
+    }
+
+    void CookedMesh::Assign(std::vector<float> vertices, std::vector<uint32_t> indices,
+                            std::vector<MeshSubmesh> submeshes, std::vector<std::string> materialTextures,
+                            std::vector<MeshLod> lods)
+    {
+        Clear();
+
+        m_OwnedVertices = std::move(vertices);
+        m_OwnedIndices = std::move(indices);
+        m_OwnedSubmeshes = std::move(submeshes);
+        m_OwnedLods = std::move(lods);
+        m_MaterialTextures = std::move(materialTextures);
+
+        if (m_OwnedLods.empty()) {
+            MeshLod lod;
+            lod.indexCount = static_cast<uint32_t>(m_OwnedIndices.size());
+            lod.submeshCount = static_cast<uint32_t>(m_OwnedSubmeshes.size());
+            m_OwnedLods.push_back(lod);
+        }
+
+        m_Vertices = m_OwnedVertices.data();
+        m_Indices = m_OwnedIndices.data();
+        m_Submeshes = m_OwnedSubmeshes.data();
+        m_Lods = m_OwnedLods.data();
+        m_VertexCount = static_cast<uint32_t>(m_OwnedVertices.size() / VertexStride);
+        m_IndexCount = static_cast<uint32_t>(m_OwnedIndices.size());
+        m_SubmeshCount = static_cast<uint32_t>(m_OwnedSubmeshes.size());
+        m_LodCount = static_cast<uint32_t>(m_OwnedLods.size());
+
+        if (m_VertexCount > 0) {
+            m_BoundsMin = glm::vec3(m_Vertices[0], m_Vertices[1], m_Vertices[2]);
+            m_BoundsMax = m_BoundsMin;
+            for (uint32_t i = 1; i < m_VertexCount; i++) {
+                glm::vec3 position(m_Vertices[i * VertexStride + 0],
+                                   m_Vertices[i * VertexStride + 1],
+                                   m_Vertices[i * VertexStride + 2]);
+                m_BoundsMin = glm::min(m_BoundsMin, position);
+                m_BoundsMax = glm::max(m_BoundsMax, position);
+            }
+        }
+    }
+
+    bool CookedMesh::Write(const std::string& cachePath, const std::string& sourcePath) const
+    {
+        MeshFileHeader header = {};
+        std::memcpy(header.magic, MeshFileMagic, sizeof(MeshFileMagic));
+        header.version = Version;
+        header.vertexStride = VertexStride;
+
+        SourceStamp stamp;
+        if (!SourceStamp::Read(sourcePath, stamp)) {
+            ARV_LOG_WARN("CookedMesh::Write() - Cannot read source {}", sourcePath);
+            return false;
+        }
+        header.sourceSize = stamp.size;
+        header.sourceModifiedTime = stamp.modifiedTime;
+        header.sourceHash = stamp.hash;
+
+        header.vertexCount = m_VertexCount;
+        header.indexCount = m_IndexCount;
+        header.submeshCount = m_SubmeshCount;
+        header.lodCount = m_LodCount;
+        header.materialCount = static_cast<uint32_t>(m_MaterialTextures.size());
+        for (int axis = 0; axis < 3; axis++) {
+            header.boundsMin[axis] = m_BoundsMin[axis];
+            header.boundsMax[axis] = m_BoundsMax[axis];
+        }
+
+        uint64_t vertexBytes = uint64_t(m_VertexCount) * VertexStride * sizeof(float);
+        uint64_t indexBytes = uint64_t(m_IndexCount) * sizeof(uint32_t);
+        uint64_t submeshBytes = uint64_t(m_SubmeshCount) * sizeof(MeshSubmesh);
+        uint64_t lodBytes = uint64_t(m_LodCount) * sizeof(MeshLod);
+        header.vertexOffset = AlignSection(sizeof(header));
+        header.indexOffset = AlignSection(header.vertexOffset + vertexBytes);
+        header.submeshOffset = AlignSection(header.indexOffset + indexBytes);
+        header.lodOffset = AlignSection(header.submeshOffset + submeshBytes);
+        header.materialOffset = AlignSection(header.lodOffset + lodBytes);
+
+        return WriteCacheFile(cachePath, [&](std::ostream& out) {
+            const char padding[SectionAlignment] = {};
+            auto writeSection = [&](uint64_t offset, const void* data, uint64_t size) {
+                uint64_t position = static_cast<uint64_t>(out.tellp());
+                out.write(padding, static_cast<std::streamsize>(offset - position));
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            writeSection(header.vertexOffset, m_Vertices, vertexBytes);
+            writeSection(header.indexOffset, m_Indices, indexBytes);
+            writeSection(header.submeshOffset, m_Submeshes, submeshBytes);
+            writeSection(header.lodOffset, m_Lods, lodBytes);
+            writeSection(header.materialOffset, nullptr, 0);
+            for (const std::string& texture : m_MaterialTextures) {
+                uint32_t length = static_cast<uint32_t>(texture.size());
+                out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                out.write(texture.data(), length);
+            }
+        });
+    }
+
+    void CookedMesh::Clear()
+    {
+        m_File.Close();
+        m_OwnedVertices = {};
+        m_OwnedIndices = {};
+        m_OwnedSubmeshes = {};
+        m_OwnedLods = {};
+        m_MaterialTextures.clear();
+        m_Vertices = nullptr;
+        m_Indices = nullptr;
+        m_Submeshes = nullptr;
+        m_Lods = nullptr;
+        m_VertexCount = 0;
+        m_IndexCount = 0;
+        m_SubmeshCount = 0;
+        m_LodCount = 0;
+        m_BoundsMin = glm::vec3(0.0f);
+        m_BoundsMax = glm::vec3(0.0f);
+    }
+
+}
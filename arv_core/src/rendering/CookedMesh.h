@@ -0,0 +1,105 @@
+#pragma once
+
+#include "utils/MappedFile.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    // Contiguous index range drawn with one material
+    struct MeshSubmesh {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        int32_t materialIndex = -1;  // Into CookedMesh::GetMaterialTextures(), -1 for none
+    };
+
+    // One level of detail: a slice of the index buffer and of the submesh table
+    struct MeshLod {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        uint32_t firstSubmesh = 0;
+        uint32_t submeshCount = 0;
+        float error = 0.0f;  // Simplification error relative to the bounding sphere radius
+    };
+
+    /**
+     * Mesh in its final GPU layout, optionally backed by a .arvmesh cache file.
+     *
+     * The cache holds the interleaved vertex buffer (position, texcoord, normal),
+     * the 32-bit index buffer, submesh ranges, the level-of-detail table, bounds
+     * and the diffuse texture of each material, stamped with the size, modification time and content hash
+     * of the source file. Load() maps the file and points straight into it, so
+     * a cached mesh costs one mmap and no parsing or copying.
+     *
+     * All LODs share the vertex buffer. Their indices and submeshes are stored
+     * back to back, LOD 0 first; GetIndexCount() and GetSubmeshCount() cover
+     * LOD 0 and GetLod() locates the others.
+     *
+     * Only the source passed to Write() is stamped; files it references (an
+     * OBJ's .mtl) are not, so delete the cache after editing those.
+     */
+    class CookedMesh {
+    public:
+        static constexpr uint32_t Version = 4;  // 4: submeshes grouped by material
+        static constexpr uint32_t VertexStride = 8;  // Floats per vertex
+
+        CookedMesh() = default;
+        CookedMesh(const CookedMesh&) = delete;
+        CookedMesh& operator=(const CookedMesh&) = delete;
+
+        // Maps cachePath if it was cooked from sourcePath as it is on disk now
+        bool Load(const std::string& cachePath, const std::string& sourcePath);
+
+        // Takes a freshly built mesh and computes its bounds. Without a LOD
+        // table the whole index buffer becomes LOD 0.
+        void Assign(std::vector<float> vertices, std::vector<uint32_t> indices,
+                    std::vector<MeshSubmesh> submeshes, std::vector<std::string> materialTextures,
+                    std::vector<MeshLod> lods = {});
+
+        // Writes the mesh to cachePath, stamped with sourcePath, through
+        // WriteCacheFile(), so readers never see a partial cache.
+        bool Write(const std::string& cachePath, const std::string& sourcePath) const;
+
+        void Clear();
+
+        bool IsEmpty() const { return m_LodCount == 0 || m_Lods[0].indexCount == 0; }
+        bool IsMapped() const { return m_File.IsOpen(); }
+
+        const float* GetVertices() const { return m_Vertices; }
+        uint32_t GetVertexCount() const { return m_VertexCount; }
+        const uint32_t* GetIndices() const { return m_Indices; }
+        uint32_t GetIndexCount() const { return m_LodCount > 0 ? m_Lods[0].indexCount : 0; }
+        uint32_t GetTotalIndexCount() const { return m_IndexCount; }  // All LODs
+        const MeshSubmesh* GetSubmeshes() const { return m_Submeshes; }
+        uint32_t GetSubmeshCount() const { return m_LodCount > 0 ? m_Lods[0].submeshCount : 0; }
+        uint32_t GetLodCount() const { return m_LodCount; }
+        const MeshLod& GetLod(uint32_t lod) const { return m_Lods[lod]; }
+        const std::vector<std::string>& GetMaterialTextures() const { return m_MaterialTextures; }
+        const glm::vec3& GetBoundsMin() const { return m_BoundsMin; }
+        const glm::vec3& GetBoundsMax() const { return m_BoundsMax; }
+
+    private:
+        MappedFile m_File;
+        std::vector<float> m_OwnedVertices;
+        std::vector<uint32_t> m_OwnedIndices;
+        std::vector<MeshSubmesh> m_OwnedSubmeshes;
+        std::vector<MeshLod> m_OwnedLods;
+
+        // Into m_File when mapped, into the owned vectors otherwise
+        const float* m_Vertices = nullptr;
+        const uint32_t* m_Indices = nullptr;
+        const MeshSubmesh* m_Submeshes = nullptr;
+        const MeshLod* m_Lods = nullptr;
+        uint32_t m_VertexCount = 0;
+        uint32_t m_IndexCount = 0;    // All LODs
+        uint32_t m_SubmeshCount = 0;  // All LODs
+        uint32_t m_LodCount = 0;
+
+        std::vector<std::string> m_MaterialTextures;
+        glm::vec3 m_BoundsMin = glm::vec3(0.0f);
+        glm::vec3 m_BoundsMax = glm::vec3(0.0f);
+    };
+
+}
@@ -0,0 +1,280 @@
+#include "CookedTexture.h"
+#include "ARVBase.h"
+#include "rendering/MipChain.h"
+#include "rendering/TextureCompressor.h"
+#include "utils/SourceStamp.h"
+#include "utils/Stopwatch.h"
+
+#include <stb_image.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace arv {
+
+    namespace {
+
+        constexpr char TextureFileMagic[8] = { 'A', 'R', 'V', 'T', 'E', 'X', '\0', '\0' };
+
+        constexpr uint32_t TextureFileSrgb = 1u << 0;
+        constexpr uint32_t TextureFileBottomUp = 1u << 1;
+
+        struct TextureFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t format;        // TextureFormat
+            uint64_t sourceSize;
+            int64_t sourceModifiedTime;
+            uint64_t sourceHash;
+            uint32_t mipLevels;     // TextureSpecification::mipLevels it was cooked with
+            uint32_t flags;         // TextureFile* bits
+            uint32_t levelCount;
+            uint32_t reserved;
+            uint64_t levelIndexOffset;
+        };
+
+        struct TextureFileLevel {
+            uint64_t offset;
+            uint64_t size;
+            uint32_t width;
+            uint32_t height;
+        };
+        static_assert(sizeof(TextureFileLevel) == 24, "TextureFileLevel is stored as is");
+
+    }
+
+    std::string CookedTexture::GetCachePath(const std::string& sourcePath, TextureFormat format, bool bottomUp)
+    {
+        std::string name = GetTextureFormatName(format);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        std::filesystem::path path(sourcePath);
+        path.replace_extension("." + name + (bottomUp ? ".flipped" : "") + ".arvtex");
+        return path.string();
+    }
+
+    bool CookedTexture::LoadOrCook(const std::string& sourcePath, const TextureSpecification& spec, bool bottomUp,
+                                   ThreadPool& pool)
+    {
+        std::string cachePath = GetCachePath(sourcePath, spec.format, bottomUp);
+        if (Load(cachePath, sourcePath, spec, bottomUp)) {
+            return true;
+        }
+        if (!TextureCompressor::CanEncode(spec.format)) {
+            ARV_LOG_WARN("CookedTexture::LoadOrCook() - No {} cache for {} and no encoder for the format",
+                         GetTextureFormatName(spec.format), sourcePath);
+            return false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (!Cook(sourcePath, spec, bottomUp, pool)) {
+            return false;
+        }
+        double cookMs = MillisecondsSince(start);
+
+        Write(cachePath, sourcePath);
+
+        size_t uncompressed = 0;
+        for (const TextureMipLevel& level : m_Levels) {
+            uncompressed += GetTextureLevelSize(TextureFormat::RGBA8, level.width, level.height);
+        }
+        ARV_LOG_INFO("CookedTexture: Cooked {} in {:.1f} ms - {}x{} {}, {} levels, {} KB (RGBA8: {} KB)",
+                     cachePath, cookMs, GetWidth(), GetHeight(), GetTextureFormatName(m_Format),
+                     m_Levels.size(), GetDataSize() / 1024, uncompressed / 1024);
+        return true;
+    }
+
+    bool CookedTexture::Load(const std::string& cachePath, const std::string& sourcePath,
+                             const TextureSpecification& spec, bool bottomUp)
+    {
+        MappedFile file;
+        if (!file.Open(cachePath)) {
+            return false;
+        }
+
+        TextureFileHeader header;
+        if (file.GetSize() < sizeof(header)) {
+            ARV_LOG_WARN("CookedTexture::Load() - {} is truncated", cachePath);
+            return false;
+        }
+        std::memcpy(&header, file.GetData(), sizeof(header));
+
+        if (std::memcmp(header.magic, TextureFileMagic, sizeof(TextureFileMagic)) != 0 || header.version != Version) {
+            ARV_LOG_INFO("CookedTexture::Load() - {} has an unknown format or version, ignoring it", cachePath);
+            return false;
+        }
+
+        uint32_t flags = (spec.srgb ? TextureFileSrgb : 0) | (bottomUp ? TextureFileBottomUp : 0);
+        if (header.format != static_cast<uint32_t>(spec.format) || header.mipLevels != spec.mipLevels ||
+            header.flags != flags) {
+            ARV_LOG_INFO("CookedTexture::Load() - {} was cooked with other settings", cachePath);
+            return false;
+        }
+
+        SourceStamp cooked;
+        cooked.size = header.sourceSize;
+        cooked.modifiedTime = header.sourceModifiedTime;
+        cooked.hash = header.sourceHash;
+        if (!cooked.Matches(sourcePath)) {
+            ARV_LOG_INFO("CookedTexture::Load() - {} is out of date", cachePath);
+            return false;
+        }
+
+        uint64_t fileSize = file.GetSize();
+        if (header.levelCount == 0 || header.levelCount > 32 ||
+            !SectionInFile(header.levelIndexOffset, uint64_t(header.levelCount) * sizeof(TextureFileLevel), fileSize)) {
+            ARV_LOG_WARN("CookedTexture::Load() - {} is corrupt", cachePath);
+            return false;
+        }
+
+        const auto* index = reinterpret_cast<const TextureFileLevel*>(file.GetData() + header.levelIndexOffset);
+        std::vector<TextureMipLevel> levels(header.levelCount);
+        for (uint32_t i = 0; i < header.levelCount; i++) {
+            if (index[i].width == 0 || index[i].height == 0 ||
+                index[i].size != GetTextureLevelSize(spec.format, index[i].width, index[i].height) ||
+                !SectionInFile(index[i].offset, index[i].size, fileSize)) {
+                ARV_LOG_WARN("CookedTexture::Load() - {} is corrupt", cachePath);
+                return false;
+            }
+            levels[i].width = index[i].width;
+            levels[i].height = index[i].height;
+            levels[i].pixels = file.GetData() + index[i].offset;
+        }
+
+        // The levels point into the mapping, which moves along without relocating
+        Clear();
+        m_File = std::move(file);
+        m_Levels = std::move(levels);
+        m_Format = spec.format;
+        m_MipLevels = spec.mipLevels;
+        m_Srgb = spec.srgb;
+        m_BottomUp = bottomUp;
+        return true;
+    }
+
+    bool CookedTexture::Cook(const std::string& sourcePath, const TextureSpecification& spec, bool bottomUp,
+                             ThreadPool& pool)
+    {
+        // Rows top to bottom; the flag is per thread, so loaders on other threads
+        // don't affect it
+        stbi_set_flip_vertically_on_load_thread(0);
+        int width = 0, height = 0, channels = 0;
+        unsigned char* data = stbi_load(sourcePath.c_str(), &width, &height, &channels, 4);
+        if (!data) {
+            ARV_LOG_ERROR("CookedTexture::Cook() - Failed to load {}", sourcePath);
+            return false;
+        }
+
+        MipChain chain = MipChain::Build(data, width, height, spec);
+
+        std::vector<std::vector<uint8_t>> encoded(chain.GetLevelCount());
+        std::vector<uint8_t> flipped;
+        bool success = true;
+        for (uint32_t i = 0; i < chain.GetLevelCount() && success; i++) {
+            const TextureMipLevel& level = chain.GetLevels()[i];
+            const uint8_t* pixels = static_cast<const uint8_t*>(level.pixels);
+            if (bottomUp) {
+                const size_t rowBytes = static_cast<size_t>(level.width) * 4;
+                flipped.resize(rowBytes * level.height);
+                for (uint32_t y = 0; y < level.height; y++) {
+                    std::memcpy(flipped.data() + (level.height - 1 - y) * rowBytes, pixels + y * rowBytes, rowBytes);
+                }
+                pixels = flipped.data();
+            }
+            success = TextureCompressor::EncodeLevel(spec.format, pixels, level.width, level.height, encoded[i], pool);
+        }
+        stbi_image_free(data);
+
+        if (!success) {
+            ARV_LOG_ERROR("CookedTexture::Cook() - Cannot encode {} as {}", sourcePath, GetTextureFormatName(spec.format));
+            return false;
+        }
+
+        Clear();
+        size_t size = 0;
+        std::vector<size_t> offsets(encoded.size());
+        for (size_t i = 0; i < encoded.size(); i++) {
+            offsets[i] = size;
+            size = AlignSection(size + encoded[i].size());
+        }
+        m_OwnedData.resize(size);
+        m_Levels.resize(encoded.size());
+        for (size_t i = 0; i < encoded.size(); i++) {
+            std::memcpy(m_OwnedData.data() + offsets[i], encoded[i].data(), encoded[i].size());
+            m_Levels[i].width = chain.GetLevels()[i].width;
+            m_Levels[i].height = chain.GetLevels()[i].height;
+            m_Levels[i].pixels = m_OwnedData.data() + offsets[i];
+        }
+        m_Format = spec.format;
+        m_MipLevels = spec.mipLevels;
+        m_Srgb = spec.srgb;
+        m_BottomUp = bottomUp;
+        return true;
+    }
+
+    bool CookedTexture::Write(const std::string& cachePath, const std::string& sourcePath) const
+    {
+        TextureFileHeader header = {};
+        std::memcpy(header.magic, TextureFileMagic, sizeof(TextureFileMagic));
+        header.version = Version;
+        header.format = static_cast<uint32_t>(m_Format);
+
+        SourceStamp stamp;
+        if (!SourceStamp::Read(sourcePath, stamp)) {
+            ARV_LOG_WARN("CookedTexture::Write() - Cannot read source {}", sourcePath);
+            return false;
+        }
+        header.sourceSize = stamp.size;
+        header.sourceModifiedTime = stamp.modifiedTime;
+        header.sourceHash = stamp.hash;
+
+        header.mipLevels = m_MipLevels;
+        header.flags = (m_Srgb ? TextureFileSrgb : 0) | (m_BottomUp ? TextureFileBottomUp : 0);
+        header.levelCount = static_cast<uint32_t>(m_Levels.size());
+        header.levelIndexOffset = AlignSection(sizeof(header));
+
+        std::vector<TextureFileLevel> index(m_Levels.size());
+        uint64_t offset = AlignSection(header.levelIndexOffset + index.size() * sizeof(TextureFileLevel));
+        for (size_t i = 0; i < m_Levels.size(); i++) {
+            index[i].offset = offset;
+            index[i].size = GetTextureLevelSize(m_Format, m_Levels[i].width, m_Levels[i].height);
+            index[i].width = m_Levels[i].width;
+            index[i].height = m_Levels[i].height;
+            offset = AlignSection(offset + index[i].size);
+        }
+
+        return WriteCacheFile(cachePath, [&](std::ostream& out) {
+            const char padding[SectionAlignment] = {};
+            auto writeSection = [&](uint64_t sectionOffset, const void* data, uint64_t size) {
+                uint64_t position = static_cast<uint64_t>(out.tellp());
+                out.write(padding, static_cast<std::streamsize>(sectionOffset - position));
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            writeSection(header.levelIndexOffset, index.data(), index.size() * sizeof(TextureFileLevel));
+            for (size_t i = 0; i < m_Levels.size(); i++) {
+                writeSection(index[i].offset, m_Levels[i].pixels, index[i].size);
+            }
+        });
+    }
+
+    void CookedTexture::Clear()
+    {
+        m_File.Close();
+        m_OwnedData.clear();
+        m_Levels.clear();
+    }
+
+    size_t CookedTexture::GetDataSize() const
+    {
+        size_t size = 0;
+        for (const TextureMipLevel& level : m_Levels) {
+            size += GetTextureLevelSize(m_Format, level.width, level.height);
+        }
+        return size;
+    }
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include "utils/MappedFile.h"
+#include "utils/ThreadPool.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * Block-compressed texture with its mip chain, optionally backed by a
+     * .arvtex cache file.
+     *
+     * Like KTX2, the file is a header and a level index followed by the
+     * levels, level 0 first, each 16-byte aligned. It is stamped with the
+     * source image like a CookedMesh and records the format and the mip and
+     * sRGB settings it was cooked with. Load() maps the file and points the
+     * levels into it, so the whole chain reaches the GPU in one
+     * Texture2D::SetMipData() call without being copied.
+     *
+     * Compressed blocks can't be flipped, so the rows are stored in the
+     * order of the backend that cooked them (see
+     * RenderingAPI::UsesBottomLeftTextureOrigin()) and each order has its own
+     * file.
+     */
+    class CookedTexture {
+    public:
+        static constexpr uint32_t Version = 1;
+
+        CookedTexture() = default;
+        CookedTexture(const CookedTexture&) = delete;
+        CookedTexture& operator=(const CookedTexture&) = delete;
+
+        // "<source without extension>.<format>[.flipped].arvtex", next to the source
+        static std::string GetCachePath(const std::string& sourcePath, TextureFormat format, bool bottomUp);
+
+        // Maps the cache of sourcePath, or cooks the image and writes the cache
+        // if there is none that matches. Safe to call from worker threads;
+        // encoding runs on pool.
+        bool LoadOrCook(const std::string& sourcePath, const TextureSpecification& spec, bool bottomUp,
+                        ThreadPool& pool);
+
+        // Maps cachePath if it was cooked from sourcePath as it is on disk now,
+        // in spec's format and with its mip and sRGB settings
+        bool Load(const std::string& cachePath, const std::string& sourcePath,
+                  const TextureSpecification& spec, bool bottomUp);
+
+        // Decodes the image, builds its mips and encodes every level in spec's format
+        bool Cook(const std::string& sourcePath, const TextureSpecification& spec, bool bottomUp, ThreadPool& pool);
+
+        // Written under a temporary name and renamed, like CookedMesh::Write()
+        bool Write(const std::string& cachePath, const std::string& sourcePath) const;
+
+        void Clear();
+
+        bool IsEmpty() const { return m_Levels.empty(); }
+        bool IsMapped() const { return m_File.IsOpen(); }
+
+        TextureFormat GetFormat() const { return m_Format; }
+        uint32_t GetWidth() const { return m_Levels.empty() ? 0 : m_Levels[0].width; }
+        uint32_t GetHeight() const { return m_Levels.empty() ? 0 : m_Levels[0].height; }
+        const TextureMipLevel* GetLevels() const { return m_Levels.data(); }
+        uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_Levels.size()); }
+        // Bytes of all levels
+        size_t GetDataSize() const;
+
+    private:
+        MappedFile m_File;
+        std::vector<uint8_t> m_OwnedData;  // Levels of a cooked texture, at their file alignment
+
+        // Into m_File when mapped, into m_OwnedData otherwise
+        std::vector<TextureMipLevel> m_Levels;
+        TextureFormat m_Format = TextureFormat::RGBA8;
+        uint32_t m_MipLevels = 0;  // TextureSpecification::mipLevels it was cooked with
+        bool m_Srgb = true;
+        bool m_BottomUp = false;
+    };
+
+}
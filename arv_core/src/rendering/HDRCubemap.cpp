@@ -0,0 +1,323 @@
+#include "HDRCubemap.h"
+#include "ARVBase.h"
+#include "math/VertexPacking.h"
+#include "utils/SourceStamp.h"
+#include "utils/Stopwatch.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace arv {
+
+    namespace {
+
+        constexpr char CubeFileMagic[8] = { 'A', 'R', 'V', 'C', 'U', 'B', 'E', '\0' };
+        constexpr float PI = 3.14159265358979323846f;
+
+        struct CubeFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t requestedFaceSize;
+            uint64_t sourceSize;
+            int64_t sourceModifiedTime;
+            uint64_t sourceHash;
+            uint32_t faceSize;
+            uint32_t levelCount;
+            uint64_t texelOffset;   // Every level's six faces, level 0 first
+        };
+
+        glm::vec4 EquirectTexel(const uint16_t* texels, size_t index)
+        {
+            const uint16_t* texel = texels + index * 4;
+            return glm::vec4(HalfToFloat(texel[0]), HalfToFloat(texel[1]), HalfToFloat(texel[2]), HalfToFloat(texel[3]));
+        }
+
+        // Bilinear, wrapping around horizontally and clamped at the poles,
+        // with the mapping the equirect skybox shader used
+        glm::vec4 SampleEquirect(const HDRImage& image, const glm::vec3& direction)
+        {
+            glm::vec3 dir = glm::normalize(direction);
+            float u = std::atan2(dir.z, dir.x) / (2.0f * PI) + 0.5f;
+            float v = 0.5f - std::asin(std::max(-1.0f, std::min(1.0f, dir.y))) / PI;
+
+            int width = static_cast<int>(image.GetWidth());
+            int height = static_cast<int>(image.GetHeight());
+            float x = u * width - 0.5f;
+            float y = v * height - 0.5f;
+            float fx = std::floor(x);
+            float fy = std::floor(y);
+            float tx = x - fx;
+            float ty = y - fy;
+
+            int x0 = static_cast<int>(fx) % width;
+            x0 = x0 < 0 ? x0 + width : x0;
+            int x1 = x0 + 1 == width ? 0 : x0 + 1;
+            int y0 = std::max(0, std::min(height - 1, static_cast<int>(fy)));
+            int y1 = std::max(0, std::min(height - 1, static_cast<int>(fy) + 1));
+
+            const uint16_t* texels = image.GetTexels();
+            size_t row0 = static_cast<size_t>(y0) * width;
+            size_t row1 = static_cast<size_t>(y1) * width;
+            glm::vec4 top = EquirectTexel(texels, row0 + x0) * (1.0f - tx) + EquirectTexel(texels, row0 + x1) * tx;
+            glm::vec4 bottom = EquirectTexel(texels, row1 + x0) * (1.0f - tx) + EquirectTexel(texels, row1 + x1) * tx;
+            return top * (1.0f - ty) + bottom * ty;
+        }
+
+    }
+
+    std::string HDRCubemap::GetCachePath(const std::string& sourcePath)
+    {
+        std::filesystem::path path(sourcePath);
+        path.replace_extension(".arvcube");
+        return path.string();
+    }
+
+    glm::vec3 HDRCubemap::GetDirection(uint32_t face, float s, float t)
+    {
+        float a = 2.0f * s - 1.0f;
+        float b = 2.0f * t - 1.0f;
+        switch (face) {
+            case 0: return glm::vec3(1.0f, -b, -a);
+            case 1: return glm::vec3(-1.0f, -b, a);
+            case 2: return glm::vec3(a, 1.0f, b);
+            case 3: return glm::vec3(a, -1.0f, -b);
+            case 4: return glm::vec3(a, -b, 1.0f);
+            default: return glm::vec3(-a, -b, -1.0f);
+        }
+    }
+
+    uint32_t HDRCubemap::FindFace(const glm::vec3& direction, float& s, float& t)
+    {
+        glm::vec3 magnitude = glm::abs(direction);
+        uint32_t face;
+        float major, sc, tc;
+        if (magnitude.x >= magnitude.y && magnitude.x >= magnitude.z) {
+            face = direction.x > 0.0f ? 0 : 1;
+            major = magnitude.x;
+            sc = direction.x > 0.0f ? -direction.z : direction.z;
+            tc = -direction.y;
+        } else if (magnitude.y >= magnitude.z) {
+            face = direction.y > 0.0f ? 2 : 3;
+            major = magnitude.y;
+            sc = direction.x;
+            tc = direction.y > 0.0f ? direction.z : -direction.z;
+        } else {
+            face = direction.z > 0.0f ? 4 : 5;
+            major = magnitude.z;
+            sc = direction.z > 0.0f ? direction.x : -direction.x;
+            tc = -direction.y;
+        }
+
+        major = std::max(major, 1e-20f);
+        s = 0.5f * (sc / major + 1.0f);
+        t = 0.5f * (tc / major + 1.0f);
+        return face;
+    }
+
+    bool HDRCubemap::Load(const std::string& path, uint32_t faceSize, bool useCache, ThreadPool& pool)
+    {
+        std::string cachePath = GetCachePath(path);
+        if (useCache && LoadCache(cachePath, path, faceSize)) {
+            ARV_LOG_INFO("HDRCubemap: Mapped {} ({}x{} faces, {} levels)", cachePath, m_FaceSize, m_FaceSize, GetLevelCount());
+            return true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        // The equirect is only needed to convert, so it isn't cached itself
+        HDRImage equirect;
+        if (!equirect.Load(path, false, pool) || !Convert(equirect, faceSize, pool)) {
+            return false;
+        }
+        double convertMs = MillisecondsSince(start);
+
+        if (useCache) {
+            WriteCache(cachePath, path);
+        }
+
+        ARV_LOG_INFO("HDRCubemap: Converted {} in {:.1f} ms ({}x{} faces, {} levels, {} KB as RGBA16F)",
+                     path, convertMs, m_FaceSize, m_FaceSize, GetLevelCount(), GetTexelCount() * sizeof(uint16_t) / 1024);
+        return true;
+    }
+
+    bool HDRCubemap::Convert(const HDRImage& equirect, uint32_t faceSize, ThreadPool& pool)
+    {
+        if (equirect.IsEmpty()) {
+            ARV_LOG_ERROR("HDRCubemap::Convert() - The equirect image is empty");
+            return false;
+        }
+
+        Clear();
+        m_RequestedFaceSize = faceSize;
+        m_FaceSize = faceSize > 0 ? faceSize : std::max(1u, std::min(equirect.GetWidth() / 4, MaxFaceSize));
+        ComputeLevelOffsets();
+        m_OwnedTexels.resize(GetTexelCount());
+        uint16_t* texels = m_OwnedTexels.data();
+
+        // Level 0, one face row per item; texel centers are sampled
+        const uint32_t size = m_FaceSize;
+        pool.ParallelFor(FaceCount * size, [&](uint32_t begin, uint32_t end) {
+            std::vector<float> row(static_cast<size_t>(size) * 4);
+            for (uint32_t r = begin; r < end; r++) {
+                uint32_t face = r / size;
+                uint32_t y = r % size;
+                float t = (y + 0.5f) / size;
+                for (uint32_t x = 0; x < size; x++) {
+                    glm::vec4 color = SampleEquirect(equirect, GetDirection(face, (x + 0.5f) / size, t));
+                    std::memcpy(&row[static_cast<size_t>(x) * 4], &color[0], sizeof(color));
+                }
+                FloatToHalf(row.data(), texels + (static_cast<size_t>(face) * size + y) * size * 4, row.size());
+            }
+        }, 4);
+
+        // Each further level averages 2x2 texels of the one above
+        for (uint32_t level = 1; level < GetLevelCount(); level++) {
+            const uint32_t sourceSize = GetLevelSize(level - 1);
+            const uint32_t targetSize = GetLevelSize(level);
+            const uint16_t* source = texels + m_LevelOffsets[level - 1];
+            uint16_t* target = texels + m_LevelOffsets[level];
+
+            pool.ParallelFor(FaceCount * targetSize, [&](uint32_t begin, uint32_t end) {
+                std::vector<float> rows(static_cast<size_t>(sourceSize) * 8);
+                std::vector<float> row(static_cast<size_t>(targetSize) * 4);
+                for (uint32_t r = begin; r < end; r++) {
+                    uint32_t face = r / targetSize;
+                    uint32_t y = r % targetSize;
+                    uint32_t y0 = std::min(y * 2, sourceSize - 1);
+                    uint32_t y1 = std::min(y * 2 + 1, sourceSize - 1);
+                    const uint16_t* faceTexels = source + static_cast<size_t>(face) * sourceSize * sourceSize * 4;
+                    HalfToFloat(faceTexels + static_cast<size_t>(y0) * sourceSize * 4, rows.data(), sourceSize * 4);
+                    HalfToFloat(faceTexels + static_cast<size_t>(y1) * sourceSize * 4, rows.data() + sourceSize * 4,
+                                sourceSize * 4);
+
+                    for (uint32_t x = 0; x < targetSize; x++) {
+                        size_t x0 = std::min(x * 2, sourceSize - 1) * 4;
+                        size_t x1 = std::min(x * 2 + 1, sourceSize - 1) * 4;
+                        const float* top = rows.data();
+                        const float* bottom = rows.data() + sourceSize * 4;
+                        for (uint32_t c = 0; c < 4; c++) {
+                            row[x * 4 + c] = 0.25f * (top[x0 + c] + top[x1 + c] + bottom[x0 + c] + bottom[x1 + c]);
+                        }
+                    }
+                    FloatToHalf(row.data(), target + (static_cast<size_t>(face) * targetSize + y) * targetSize * 4,
+                                row.size());
+                }
+            }, 16);
+        }
+
+        m_Texels = m_OwnedTexels.data();
+        return true;
+    }
+
+    bool HDRCubemap::LoadCache(const std::string& cachePath, const std::string& sourcePath, uint32_t faceSize)
+    {
+        MappedFile file;
+        if (!file.Open(cachePath)) {
+            return false;
+        }
+
+        CubeFileHeader header;
+        if (file.GetSize() < sizeof(header)) {
+            ARV_LOG_WARN("HDRCubemap::LoadCache() - {} is truncated", cachePath);
+            return false;
+        }
+        std::memcpy(&header, file.GetData(), sizeof(header));
+
+        if (std::memcmp(header.magic, CubeFileMagic, sizeof(CubeFileMagic)) != 0 || header.version != Version) {
+            ARV_LOG_INFO("HDRCubemap::LoadCache() - {} has an unknown format or version, ignoring it", cachePath);
+            return false;
+        }
+
+        SourceStamp converted;
+        converted.size = header.sourceSize;
+        converted.modifiedTime = header.sourceModifiedTime;
+        converted.hash = header.sourceHash;
+        if (header.requestedFaceSize != faceSize || !converted.Matches(sourcePath)) {
+            ARV_LOG_INFO("HDRCubemap::LoadCache() - {} is out of date", cachePath);
+            return false;
+        }
+
+        Clear();
+        m_FaceSize = header.faceSize;
+        ComputeLevelOffsets();
+        uint64_t texelBytes = GetTexelCount() * sizeof(uint16_t);
+        if (header.faceSize == 0 || header.levelCount != GetLevelCount() ||
+            header.texelOffset % SectionAlignment != 0 || header.texelOffset > file.GetSize() ||
+            texelBytes > file.GetSize() - header.texelOffset) {
+            ARV_LOG_WARN("HDRCubemap::LoadCache() - {} is corrupt", cachePath);
+            Clear();
+            return false;
+        }
+
+        m_File = std::move(file);
+        m_Texels = reinterpret_cast<const uint16_t*>(m_File.GetData() + header.texelOffset);
+        m_RequestedFaceSize = faceSize;
+        return true;
+    }
+
+    bool HDRCubemap::WriteCache(const std::string& cachePath, const std::string& sourcePath) const
+    {
+        CubeFileHeader header = {};
+        std::memcpy(header.magic, CubeFileMagic, sizeof(CubeFileMagic));
+        header.version = Version;
+        header.requestedFaceSize = m_RequestedFaceSize;
+
+        SourceStamp stamp;
+        if (!SourceStamp::Read(sourcePath, stamp)) {
+            ARV_LOG_WARN("HDRCubemap::WriteCache() - Cannot read source {}", sourcePath);
+            return false;
+        }
+        header.sourceSize = stamp.size;
+        header.sourceModifiedTime = stamp.modifiedTime;
+        header.sourceHash = stamp.hash;
+        header.faceSize = m_FaceSize;
+        header.levelCount = GetLevelCount();
+        header.texelOffset = AlignSection(sizeof(header));
+
+        return WriteCacheFile(cachePath, [&](std::ostream& out) {
+            const char padding[SectionAlignment] = {};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(padding, static_cast<std::streamsize>(header.texelOffset - sizeof(header)));
+            out.write(reinterpret_cast<const char*>(m_Texels),
+                      static_cast<std::streamsize>(GetTexelCount() * sizeof(uint16_t)));
+        });
+    }
+
+    void HDRCubemap::Clear()
+    {
+        m_File.Close();
+        m_OwnedTexels.clear();
+        m_Texels = nullptr;
+        m_LevelOffsets.clear();
+        m_FaceSize = 0;
+        m_RequestedFaceSize = 0;
+    }
+
+    const uint16_t* HDRCubemap::GetFace(uint32_t level, uint32_t face) const
+    {
+        size_t size = GetLevelSize(level);
+        return m_Texels + m_LevelOffsets[level] + face * size * size * 4;
+    }
+
+    void HDRCubemap::ComputeLevelOffsets()
+    {
+        m_LevelOffsets.clear();
+        size_t offset = 0;
+        for (uint32_t size = m_FaceSize; size > 0; size /= 2) {
+            m_LevelOffsets.push_back(offset);
+            offset += static_cast<size_t>(FaceCount) * size * size * 4;
+        }
+    }
+
+    size_t HDRCubemap::GetTexelCount() const
+    {
+        if (m_LevelOffsets.empty()) {
+            return 0;
+        }
+        size_t last = GetLevelSize(GetLevelCount() - 1);
+        return m_LevelOffsets.back() + FaceCount * last * last * 4;
+    }
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "rendering/HDRImage.h"
+#include "utils/MappedFile.h"
+#include "utils/ThreadPool.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * Mip-mapped RGBA16F cubemap converted from an equirectangular HDR image,
+     * so a skybox samples it with one cube lookup instead of computing atan
+     * and asin per pixel.
+     *
+     * Faces follow the OpenGL/Metal order +X, -X, +Y, -Y, +Z, -Z with rows top
+     * to bottom. Level 0 is bilinearly resampled from the equirect on the
+     * thread pool and every further level is a 2x2 box filter of the one
+     * above. The result is cached in a .arvcube file next to the source,
+     * stamped with it like an HDRImage cache, so later loads are one mmap.
+     */
+    class HDRCubemap {
+    public:
+        static constexpr uint32_t Version = 1;
+        static constexpr uint32_t FaceCount = 6;
+        // Face size picked for faceSize 0 is a quarter of the equirect width, at most this
+        static constexpr uint32_t MaxFaceSize = 2048;
+
+        HDRCubemap() = default;
+        HDRCubemap(const HDRCubemap&) = delete;
+        HDRCubemap& operator=(const HDRCubemap&) = delete;
+
+        // "<source without extension>.arvcube", next to the source
+        static std::string GetCachePath(const std::string& sourcePath);
+
+        // Direction through face coordinates s, t in [0, 1] (t down), not normalized
+        static glm::vec3 GetDirection(uint32_t face, float s, float t);
+        // Face a direction points into and its coordinates on it
+        static uint32_t FindFace(const glm::vec3& direction, float& s, float& t);
+
+        // Maps the cache of path if it matches, otherwise decodes and converts
+        // path and, with useCache, writes the cache for the next load
+        bool Load(const std::string& path, uint32_t faceSize = 0, bool useCache = true,
+                  ThreadPool& pool = ThreadPool::Global());
+
+        // Resamples an equirect image into faces of faceSize (0 picks one) and builds the mips
+        bool Convert(const HDRImage& equirect, uint32_t faceSize = 0, ThreadPool& pool = ThreadPool::Global());
+
+        // Maps cachePath if it was converted from sourcePath as it is on disk now
+        // with the same requested face size
+        bool LoadCache(const std::string& cachePath, const std::string& sourcePath, uint32_t faceSize);
+
+        // Written under a temporary name and renamed, like CookedMesh::Write()
+        bool WriteCache(const std::string& cachePath, const std::string& sourcePath) const;
+
+        void Clear();
+
+        bool IsEmpty() const { return m_Texels == nullptr; }
+        bool IsMapped() const { return m_File.IsOpen(); }
+
+        uint32_t GetFaceSize() const { return m_FaceSize; }
+        uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_LevelOffsets.size()); }
+        uint32_t GetLevelSize(uint32_t level) const { return std::max(m_FaceSize >> level, 1u); }
+        // Four halves per texel, GetLevelSize(level) squared texels
+        const uint16_t* GetFace(uint32_t level, uint32_t face) const;
+
+    private:
+        void ComputeLevelOffsets();
+        size_t GetTexelCount() const;  // Halves of all levels and faces
+
+        MappedFile m_File;
+        std::vector<uint16_t> m_OwnedTexels;
+        const uint16_t* m_Texels = nullptr;  // Into m_File when mapped, into m_OwnedTexels otherwise
+        std::vector<size_t> m_LevelOffsets;  // In halves, of face 0 of each level
+        uint32_t m_FaceSize = 0;
+        uint32_t m_RequestedFaceSize = 0;    // faceSize Convert() was called with
+    };
+
+}
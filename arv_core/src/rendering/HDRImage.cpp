@@ -0,0 +1,292 @@
+#include "HDRImage.h"
+#include "ARVBase.h"
+#include "math/VertexPacking.h"
+#include "utils/SourceStamp.h"
+#include "utils/Stopwatch.h"
+
+#include <tinyexr.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace arv {
+
+    namespace {
+
+        constexpr char HDRFileMagic[8] = { 'A', 'R', 'V', 'H', 'D', 'R', '\0', '\0' };
+        constexpr uint16_t HalfOne = 0x3C00;
+
+        struct HDRFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t reserved;
+            uint64_t sourceSize;
+            int64_t sourceModifiedTime;
+            uint64_t sourceHash;
+            uint32_t width;
+            uint32_t height;
+            uint64_t texelOffset;   // width * height RGBA16F texels
+        };
+
+        // EXR channel an output channel is read from; a constant if there is none
+        struct ChannelSource {
+            int plane = -1;
+            int pixelType = TINYEXR_PIXELTYPE_HALF;
+            uint16_t constant = 0;
+        };
+
+        // Interleaves count texels starting at offset in each channel plane
+        void ConvertTexels(unsigned char* const* planes, const ChannelSource* sources, size_t offset, size_t count,
+                           uint16_t* target, std::vector<uint16_t>& halves, std::vector<float>& floats)
+        {
+            halves.resize(count);
+            floats.resize(count);
+            for (uint32_t c = 0; c < 4; c++) {
+                const ChannelSource& source = sources[c];
+                if (source.plane < 0) {
+                    for (size_t i = 0; i < count; i++) {
+                        target[i * 4 + c] = source.constant;
+                    }
+                    continue;
+                }
+
+                const uint16_t* values = halves.data();
+                const unsigned char* plane = planes[source.plane];
+                if (source.pixelType == TINYEXR_PIXELTYPE_HALF) {
+                    values = reinterpret_cast<const uint16_t*>(plane) + offset;
+                } else if (source.pixelType == TINYEXR_PIXELTYPE_FLOAT) {
+                    FloatToHalf(reinterpret_cast<const float*>(plane) + offset, halves.data(), count);
+                } else {
+                    const uint32_t* integers = reinterpret_cast<const uint32_t*>(plane) + offset;
+                    for (size_t i = 0; i < count; i++) {
+                        floats[i] = static_cast<float>(integers[i]);
+                    }
+                    FloatToHalf(floats.data(), halves.data(), count);
+                }
+                for (size_t i = 0; i < count; i++) {
+                    target[i * 4 + c] = values[i];
+                }
+            }
+        }
+
+    }
+
+    std::string HDRImage::GetCachePath(const std::string& sourcePath)
+    {
+        std::filesystem::path path(sourcePath);
+        path.replace_extension(".arvhdr");
+        return path.string();
+    }
+
+    bool HDRImage::Load(const std::string& path, bool useCache, ThreadPool& pool)
+    {
+        std::string cachePath = GetCachePath(path);
+        if (useCache && LoadCache(cachePath, path)) {
+            ARV_LOG_INFO("HDRImage: Mapped {} ({}x{})", cachePath, m_Width, m_Height);
+            return true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (!Decode(path, pool)) {
+            return false;
+        }
+        double decodeMs = MillisecondsSince(start);
+
+        if (useCache) {
+            WriteCache(cachePath, path);
+        }
+
+        ARV_LOG_INFO("HDRImage: Decoded {} in {:.1f} ms ({}x{}, {} KB as RGBA16F)",
+                     path, decodeMs, m_Width, m_Height, static_cast<size_t>(m_Width) * m_Height * 8 / 1024);
+        return true;
+    }
+
+    bool HDRImage::Decode(const std::string& path, ThreadPool& pool)
+    {
+        MappedFile file;
+        if (!file.Open(path)) {
+            ARV_LOG_ERROR("HDRImage::Decode() - Cannot open {}", path);
+            return false;
+        }
+        const auto* data = reinterpret_cast<const unsigned char*>(file.GetData());
+
+        EXRVersion version;
+        if (ParseEXRVersionFromMemory(&version, data, file.GetSize()) != TINYEXR_SUCCESS ||
+            version.multipart || version.non_image) {
+            ARV_LOG_ERROR("HDRImage::Decode() - {} is not a single-part EXR image", path);
+            return false;
+        }
+
+        EXRHeader header;
+        InitEXRHeader(&header);
+        const char* error = nullptr;
+        if (ParseEXRHeaderFromMemory(&header, &version, data, file.GetSize(), &error) != TINYEXR_SUCCESS) {
+            ARV_LOG_ERROR("HDRImage::Decode() - Failed to read {} ({})", path, error ? error : "unknown error");
+            FreeEXRErrorMessage(error);
+            FreeEXRHeader(&header);
+            return false;
+        }
+
+        // Half channels stay half, which is what the texels are stored as
+        EXRImage image;
+        InitEXRImage(&image);
+        if (LoadEXRImageFromMemory(&image, &header, data, file.GetSize(), &error) != TINYEXR_SUCCESS) {
+            ARV_LOG_ERROR("HDRImage::Decode() - Failed to decode {} ({})", path, error ? error : "unknown error");
+            FreeEXRErrorMessage(error);
+            FreeEXRHeader(&header);
+            return false;
+        }
+
+        ChannelSource sources[4];
+        sources[3].constant = HalfOne;
+        const char* names[4] = { "R", "G", "B", "A" };
+        for (int i = 0; i < header.num_channels; i++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                if (std::strcmp(header.channels[i].name, names[c]) == 0) {
+                    sources[c].plane = i;
+                    sources[c].pixelType = header.requested_pixel_types[i];
+                }
+            }
+        }
+        if (header.num_channels == 1) {
+            for (uint32_t c = 0; c < 3; c++) {
+                sources[c].plane = 0;
+                sources[c].pixelType = header.requested_pixel_types[0];
+            }
+        }
+
+        bool success = sources[0].plane >= 0 || sources[1].plane >= 0 || sources[2].plane >= 0;
+        if (!success) {
+            ARV_LOG_ERROR("HDRImage::Decode() - {} has no R, G or B channel", path);
+        } else {
+            Clear();
+            m_Width = static_cast<uint32_t>(image.width);
+            m_Height = static_cast<uint32_t>(image.height);
+            m_OwnedTexels.resize(static_cast<size_t>(m_Width) * m_Height * 4);
+            uint16_t* texels = m_OwnedTexels.data();
+            const size_t width = m_Width;
+            const size_t height = m_Height;
+
+            if (header.tiled) {
+                // Level 0 tiles; a partial tile at the edge is allocated at full size
+                const size_t tileWidth = static_cast<size_t>(header.tile_size_x);
+                const size_t tileHeight = static_cast<size_t>(header.tile_size_y);
+                pool.ParallelFor(static_cast<uint32_t>(image.num_tiles), [&](uint32_t begin, uint32_t end) {
+                    std::vector<uint16_t> halves;
+                    std::vector<float> floats;
+                    for (uint32_t t = begin; t < end; t++) {
+                        const EXRTile& tile = image.tiles[t];
+                        if (tile.level_x != 0 || tile.level_y != 0) {
+                            continue;
+                        }
+                        size_t x = static_cast<size_t>(tile.offset_x) * tileWidth;
+                        size_t y = static_cast<size_t>(tile.offset_y) * tileHeight;
+                        if (x >= width || y >= height) {
+                            continue;
+                        }
+                        size_t count = std::min(tileWidth, width - x);
+                        size_t rows = std::min(tileHeight, height - y);
+                        for (size_t row = 0; row < rows; row++) {
+                            ConvertTexels(tile.images, sources, row * tileWidth, count,
+                                          texels + ((y + row) * width + x) * 4, halves, floats);
+                        }
+                    }
+                });
+            } else {
+                pool.ParallelFor(m_Height, [&](uint32_t begin, uint32_t end) {
+                    std::vector<uint16_t> halves;
+                    std::vector<float> floats;
+                    for (uint32_t y = begin; y < end; y++) {
+                        ConvertTexels(image.images, sources, y * width, width, texels + y * width * 4, halves, floats);
+                    }
+                }, 16);
+            }
+            m_Texels = m_OwnedTexels.data();
+        }
+
+        FreeEXRImage(&image);
+        FreeEXRHeader(&header);
+        return success;
+    }
+
+    bool HDRImage::LoadCache(const std::string& cachePath, const std::string& sourcePath)
+    {
+        MappedFile file;
+        if (!file.Open(cachePath)) {
+            return false;
+        }
+
+        HDRFileHeader header;
+        if (file.GetSize() < sizeof(header)) {
+            ARV_LOG_WARN("HDRImage::LoadCache() - {} is truncated", cachePath);
+            return false;
+        }
+        std::memcpy(&header, file.GetData(), sizeof(header));
+
+        if (std::memcmp(header.magic, HDRFileMagic, sizeof(HDRFileMagic)) != 0 || header.version != Version) {
+            ARV_LOG_INFO("HDRImage::LoadCache() - {} has an unknown format or version, ignoring it", cachePath);
+            return false;
+        }
+
+        SourceStamp converted;
+        converted.size = header.sourceSize;
+        converted.modifiedTime = header.sourceModifiedTime;
+        converted.hash = header.sourceHash;
+        if (!converted.Matches(sourcePath)) {
+            ARV_LOG_INFO("HDRImage::LoadCache() - {} is out of date", cachePath);
+            return false;
+        }
+
+        uint64_t texelBytes = uint64_t(header.width) * header.height * 4 * sizeof(uint16_t);
+        if (header.width == 0 || header.height == 0 || header.texelOffset % SectionAlignment != 0 ||
+            header.texelOffset > file.GetSize() || texelBytes > file.GetSize() - header.texelOffset) {
+            ARV_LOG_WARN("HDRImage::LoadCache() - {} is corrupt", cachePath);
+            return false;
+        }
+
+        Clear();
+        m_File = std::move(file);
+        m_Texels = reinterpret_cast<const uint16_t*>(m_File.GetData() + header.texelOffset);
+        m_Width = header.width;
+        m_Height = header.height;
+        return true;
+    }
+
+    bool HDRImage::WriteCache(const std::string& cachePath, const std::string& sourcePath) const
+    {
+        HDRFileHeader header = {};
+        std::memcpy(header.magic, HDRFileMagic, sizeof(HDRFileMagic));
+        header.version = Version;
+
+        SourceStamp stamp;
+        if (!SourceStamp::Read(sourcePath, stamp)) {
+            ARV_LOG_WARN("HDRImage::WriteCache() - Cannot read source {}", sourcePath);
+            return false;
+        }
+        header.sourceSize = stamp.size;
+        header.sourceModifiedTime = stamp.modifiedTime;
+        header.sourceHash = stamp.hash;
+        header.width = m_Width;
+        header.height = m_Height;
+        header.texelOffset = AlignSection(sizeof(header));
+
+        return WriteCacheFile(cachePath, [&](std::ostream& out) {
+            const char padding[SectionAlignment] = {};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(padding, static_cast<std::streamsize>(header.texelOffset - sizeof(header)));
+            out.write(reinterpret_cast<const char*>(m_Texels),
+                      static_cast<std::streamsize>(static_cast<size_t>(m_Width) * m_Height * 4 * sizeof(uint16_t)));
+        });
+    }
+
+    void HDRImage::Clear()
+    {
+        m_File.Close();
+        m_OwnedTexels.clear();
+        m_Texels = nullptr;
+        m_Width = 0;
+        m_Height = 0;
+    }
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "utils/MappedFile.h"
+#include "utils/ThreadPool.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * OpenEXR image as RGBA16F texels, rows top to bottom, which is the
+     * format the GPU backends sample HDR textures in.
+     *
+     * tinyexr decompresses the chunks (scanline blocks or tiles) on its worker
+     * threads. Half channels are kept as they are; float channels are
+     * converted with the F16C/NEON FloatToHalf() while rows are interleaved on
+     * the thread pool. Uploads then move half the bytes of float RGBA.
+     *
+     * The converted texels can be cached in a .arvhdr file next to the source,
+     * stamped with it like a CookedMesh, so a cached load is one mmap.
+     */
+    class HDRImage {
+    public:
+        static constexpr uint32_t Version = 1;
+
+        HDRImage() = default;
+        HDRImage(const HDRImage&) = delete;
+        HDRImage& operator=(const HDRImage&) = delete;
+
+        // "<source without extension>.arvhdr", next to the source
+        static std::string GetCachePath(const std::string& sourcePath);
+
+        // Maps the cache of path if it matches, otherwise decodes path and,
+        // with useCache, writes the cache for the next load
+        bool Load(const std::string& path, bool useCache = true, ThreadPool& pool = ThreadPool::Global());
+
+        // Decodes an EXR file; R, G, B and A are taken by name, a single channel is grey
+        bool Decode(const std::string& path, ThreadPool& pool = ThreadPool::Global());
+
+        // Maps cachePath if it was converted from sourcePath as it is on disk now
+        bool LoadCache(const std::string& cachePath, const std::string& sourcePath);
+
+        // Written under a temporary name and renamed, like CookedMesh::Write()
+        bool WriteCache(const std::string& cachePath, const std::string& sourcePath) const;
+
+        void Clear();
+
+        bool IsEmpty() const { return m_Texels == nullptr; }
+        bool IsMapped() const { return m_File.IsOpen(); }
+
+        uint32_t GetWidth() const { return m_Width; }
+        uint32_t GetHeight() const { return m_Height; }
+        // Four halves per texel
+        const uint16_t* GetTexels() const { return m_Texels; }
+
+    private:
+        MappedFile m_File;
+        std::vector<uint16_t> m_OwnedTexels;
+        const uint16_t* m_Texels = nullptr;  // Into m_File when mapped, into m_OwnedTexels otherwise
+        uint32_t m_Width = 0;
+        uint32_t m_Height = 0;
+    };
+
+}
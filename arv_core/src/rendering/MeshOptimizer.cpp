@@ -0,0 +1,411 @@
+#include "MeshOptimizer.h"
+#include "ARVBase.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace arv {
+
+    namespace {
+
+        // FIFO cache emulation with timestamps: a vertex is resident while fewer
+        // than cacheSize misses happened since it was loaded
+        class FifoCache {
+        public:
+            FifoCache(uint32_t vertexCount, uint32_t cacheSize)
+                : m_Timestamps(vertexCount, 0), m_CacheSize(cacheSize), m_Time(cacheSize + 1) {}
+
+            // Returns true on a miss
+            bool Access(uint32_t vertex)
+            {
+                if (m_Time - m_Timestamps[vertex] > m_CacheSize) {
+                    m_Timestamps[vertex] = m_Time++;
+                    return true;
+                }
+                return false;
+            }
+
+            // Evicts everything without touching the timestamps
+            void Flush() { m_Time += m_CacheSize + 1; }
+
+        private:
+            std::vector<uint32_t> m_Timestamps;
+            uint32_t m_CacheSize;
+            uint32_t m_Time;
+        };
+
+        // Triangle lists per vertex in compressed rows
+        struct VertexAdjacency {
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> triangles;
+
+            VertexAdjacency(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount)
+                : offsets(size_t(vertexCount) + 1, 0), triangles(indexCount)
+            {
+                for (uint32_t i = 0; i < indexCount; i++) {
+                    offsets[indices[i] + 1]++;
+                }
+                for (uint32_t v = 0; v < vertexCount; v++) {
+                    offsets[v + 1] += offsets[v];
+                }
+                std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+                for (uint32_t i = 0; i < indexCount; i++) {
+                    triangles[cursor[indices[i]]++] = i / 3;
+                }
+            }
+
+            uint32_t Begin(uint32_t vertex) const { return offsets[vertex]; }
+            uint32_t End(uint32_t vertex) const { return offsets[vertex + 1]; }
+        };
+
+        constexpr uint32_t InvalidVertex = ~0u;
+
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                                       uint32_t cacheSize)
+    {
+        VertexCacheStats stats;
+        if (indexCount < 3 || vertexCount == 0) {
+            return stats;
+        }
+
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<uint8_t> referenced(vertexCount, 0);
+        uint32_t misses = 0;
+        uint32_t uniqueVertices = 0;
+
+        for (uint32_t i = 0; i < indexCount; i++) {
+            uint32_t vertex = indices[i];
+            misses += cache.Access(vertex) ? 1 : 0;
+            if (!referenced[vertex]) {
+                referenced[vertex] = 1;
+                uniqueVertices++;
+            }
+        }
+
+        stats.acmr = float(misses) / float(indexCount / 3);
+        stats.atvr = float(misses) / float(uniqueVertices);
+        return stats;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                            uint32_t cacheSize)
+    {
+        uint32_t triangleCount = indexCount / 3;
+        if (triangleCount == 0 || vertexCount == 0) {
+            return;
+        }
+
+        VertexAdjacency adjacency(indices, triangleCount * 3, vertexCount);
+
+        std::vector<uint32_t> liveTriangles(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            liveTriangles[v] = adjacency.End(v) - adjacency.Begin(v);
+        }
+
+        std::vector<uint32_t> cacheTime(vertexCount, 0);
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> deadEnd;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> output;
+        deadEnd.reserve(triangleCount * 3);
+        output.reserve(triangleCount * 3);
+
+        uint32_t time = cacheSize + 1;
+        uint32_t scanCursor = 0;
+        uint32_t fanning = 0;
+
+        while (fanning != InvalidVertex) {
+            // Emit every remaining triangle around the fanning vertex
+            candidates.clear();
+            for (uint32_t a = adjacency.Begin(fanning); a < adjacency.End(fanning); a++) {
+                uint32_t triangle = adjacency.triangles[a];
+                if (emitted[triangle]) {
+                    continue;
+                }
+                emitted[triangle] = 1;
+
+                for (uint32_t k = 0; k < 3; k++) {
+                    uint32_t vertex = indices[triangle * 3 + k];
+                    output.push_back(vertex);
+                    deadEnd.push_back(vertex);
+                    candidates.push_back(vertex);
+                    liveTriangles[vertex]--;
+                    if (time - cacheTime[vertex] > cacheSize) {
+                        cacheTime[vertex] = time++;
+                    }
+                }
+            }
+
+            // Next fanning vertex: the oldest candidate that will still be in
+            // the cache after its own fan is emitted
+            uint32_t best = InvalidVertex;
+            int64_t bestPriority = -1;
+            for (uint32_t vertex : candidates) {
+                if (liveTriangles[vertex] == 0) {
+                    continue;
+                }
+                int64_t priority = 0;
+                if (time - cacheTime[vertex] + 2 * liveTriangles[vertex] <= cacheSize) {
+                    priority = time - cacheTime[vertex];
+                }
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    best = vertex;
+                }
+            }
+
+            if (best == InvalidVertex) {
+                // Dead end: prefer recently used vertices, then fall back to
+                // the first vertex in index order that still has triangles
+                while (!deadEnd.empty()) {
+                    uint32_t vertex = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (liveTriangles[vertex] > 0) {
+                        best = vertex;
+                        break;
+                    }
+                }
+                while (best == InvalidVertex && scanCursor < vertexCount) {
+                    if (liveTriangles[scanCursor] > 0) {
+                        best = scanCursor;
+                    }
+                    scanCursor++;
+                }
+            }
+
+            fanning = best;
+        }
+
+        std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(uint32_t* indices, uint32_t indexCount, const float* positions, uint32_t stride,
+                                         uint32_t vertexCount, float threshold, uint32_t cacheSize)
+    {
+        uint32_t triangleCount = indexCount / 3;
+        if (triangleCount < 2 || vertexCount == 0) {
+            return;
+        }
+
+        // Per-triangle cache misses in the current order
+        std::vector<uint8_t> triangleMisses(triangleCount);
+        {
+            FifoCache cache(vertexCount, cacheSize);
+            for (uint32_t t = 0; t < triangleCount; t++) {
+                triangleMisses[t] = uint8_t(cache.Access(indices[t * 3 + 0]))
+                                  + uint8_t(cache.Access(indices[t * 3 + 1]))
+                                  + uint8_t(cache.Access(indices[t * 3 + 2]));
+            }
+        }
+
+        // Hard boundaries: triangles that miss on all three vertices start a
+        // new strip of locality, so cutting there costs nothing
+        std::vector<uint32_t> hardClusters;
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            if (t == 0 || triangleMisses[t] == 3) {
+                hardClusters.push_back(t);
+            }
+        }
+        hardClusters.push_back(triangleCount);
+
+        // Soft boundaries: within a hard cluster, cut wherever the running
+        // ACMR (measured with a cache flushed at the cut) is already within
+        // threshold of the cluster's ACMR
+        std::vector<uint32_t> clusters;
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t c = 0; c + 1 < hardClusters.size(); c++) {
+            uint32_t begin = hardClusters[c];
+            uint32_t end = hardClusters[c + 1];
+
+            uint32_t clusterMisses = 0;
+            for (uint32_t t = begin; t < end; t++) {
+                clusterMisses += triangleMisses[t];
+            }
+            float limit = float(clusterMisses) / float(end - begin) * threshold;
+
+            cache.Flush();
+            clusters.push_back(begin);
+            uint32_t start = begin;
+            uint32_t misses = 0;
+            for (uint32_t t = begin; t < end; t++) {
+                for (uint32_t k = 0; k < 3; k++) {
+                    misses += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+                }
+                if (t + 1 < end && float(misses) / float(t + 1 - start) <= limit) {
+                    clusters.push_back(t + 1);
+                    start = t + 1;
+                    misses = 0;
+                    cache.Flush();
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+        uint32_t clusterCount = uint32_t(clusters.size() - 1);
+
+        // Mesh centroid over triangle area
+        auto position = [&](uint32_t vertex) {
+            const float* p = positions + size_t(vertex) * stride;
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+
+        std::vector<glm::vec3> clusterCentroid(clusterCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> clusterNormal(clusterCount, glm::vec3(0.0f));
+        std::vector<float> clusterArea(clusterCount, 0.0f);
+        glm::vec3 meshCentroid(0.0f);
+        float meshArea = 0.0f;
+
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++) {
+                glm::vec3 a = position(indices[t * 3 + 0]);
+                glm::vec3 b = position(indices[t * 3 + 1]);
+                glm::vec3 d = position(indices[t * 3 + 2]);
+                glm::vec3 normal = glm::cross(b - a, d - a);
+                float area = glm::length(normal);
+                glm::vec3 center = (a + b + d) / 3.0f;
+
+                clusterCentroid[c] += center * area;
+                clusterNormal[c] += normal;
+                clusterArea[c] += area;
+            }
+            meshCentroid += clusterCentroid[c];
+            meshArea += clusterArea[c];
+        }
+        if (meshArea > 0.0f) {
+            meshCentroid /= meshArea;
+        }
+
+        // Clusters facing away from the centre are likely in front of the
+        // ones facing inward from any viewpoint, so they draw first
+        std::vector<float> sortKey(clusterCount, 0.0f);
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            float normalLength = glm::length(clusterNormal[c]);
+            if (clusterArea[c] <= 0.0f || normalLength <= 0.0f) {
+                continue;
+            }
+            glm::vec3 centroid = clusterCentroid[c] / clusterArea[c];
+            sortKey[c] = glm::dot(centroid - meshCentroid, clusterNormal[c] / normalLength);
+        }
+
+        std::vector<uint32_t> order(clusterCount);
+        for (uint32_t c = 0; c < clusterCount; c++) {
+            order[c] = c;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return sortKey[a] > sortKey[b];
+        });
+
+        std::vector<uint32_t> output;
+        output.reserve(size_t(triangleCount) * 3);
+        for (uint32_t c : order) {
+            output.insert(output.end(), indices + size_t(clusters[c]) * 3, indices + size_t(clusters[c + 1]) * 3);
+        }
+        std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+    }
+
+    uint32_t MeshOptimizer::OptimizeVertexFetch(float* vertices, uint32_t stride, uint32_t vertexCount,
+                                                uint32_t* indices, uint32_t indexCount)
+    {
+        std::vector<uint32_t> remap(vertexCount, InvalidVertex);
+        uint32_t next = 0;
+        for (uint32_t i = 0; i < indexCount; i++) {
+            uint32_t& slot = remap[indices[i]];
+            if (slot == InvalidVertex) {
+                slot = next++;
+            }
+            indices[i] = slot;
+        }
+
+        std::vector<float> reordered(size_t(next) * stride);
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            if (remap[v] != InvalidVertex) {
+                std::memcpy(&reordered[size_t(remap[v]) * stride], vertices + size_t(v) * stride, stride * sizeof(float));
+            }
+        }
+        std::memcpy(vertices, reordered.data(), reordered.size() * sizeof(float));
+        return next;
+    }
+
+    void MeshOptimizer::OptimizeTriangleOrder(const float* vertices, uint32_t vertexCount, uint32_t* indices,
+                                              const MeshSubmesh* submeshes, uint32_t submeshCount)
+    {
+        constexpr uint32_t stride = CookedMesh::VertexStride;
+
+        // Each submesh is optimized on its own compact vertex range so the work
+        // stays proportional to the submesh, not the whole mesh
+        std::vector<uint32_t> globalToLocal(vertexCount, InvalidVertex);
+        std::vector<uint32_t> localToGlobal;
+        std::vector<uint32_t> localIndices;
+        std::vector<float> localPositions;
+
+        for (uint32_t s = 0; s < submeshCount; s++) {
+            const MeshSubmesh& submesh = submeshes[s];
+            uint32_t count = submesh.indexCount - submesh.indexCount % 3;
+            if (count < 3) {
+                continue;
+            }
+            uint32_t* range = indices + submesh.firstIndex;
+
+            localToGlobal.clear();
+            localIndices.resize(count);
+            for (uint32_t i = 0; i < count; i++) {
+                uint32_t& local = globalToLocal[range[i]];
+                if (local == InvalidVertex) {
+                    local = uint32_t(localToGlobal.size());
+                    localToGlobal.push_back(range[i]);
+                }
+                localIndices[i] = local;
+            }
+            uint32_t localCount = uint32_t(localToGlobal.size());
+
+            localPositions.resize(size_t(localCount) * 3);
+            for (uint32_t v = 0; v < localCount; v++) {
+                std::memcpy(&localPositions[size_t(v) * 3], vertices + size_t(localToGlobal[v]) * stride, 3 * sizeof(float));
+            }
+
+            OptimizeVertexCache(localIndices.data(), count, localCount);
+            OptimizeOverdraw(localIndices.data(), count, localPositions.data(), 3, localCount);
+
+            for (uint32_t i = 0; i < count; i++) {
+                range[i] = localToGlobal[localIndices[i]];
+            }
+            for (uint32_t global : localToGlobal) {
+                globalToLocal[global] = InvalidVertex;
+            }
+        }
+    }
+
+    void MeshOptimizer::Optimize(std::vector<float>& vertices, std::vector<uint32_t>& indices,
+                                 const std::vector<MeshSubmesh>& submeshes)
+    {
+        constexpr uint32_t stride = CookedMesh::VertexStride;
+        uint32_t vertexCount = uint32_t(vertices.size() / stride);
+        uint32_t indexCount = uint32_t(indices.size());
+        if (indexCount < 3 || vertexCount == 0) {
+            return;
+        }
+
+        VertexCacheStats before = AnalyzeVertexCache(indices.data(), indexCount, vertexCount);
+
+        std::vector<MeshSubmesh> ranges;
+        for (const MeshSubmesh& submesh : submeshes) {
+            if (submesh.firstIndex + submesh.indexCount <= indexCount) {
+                ranges.push_back(submesh);
+            }
+        }
+        if (submeshes.empty()) {
+            ranges.push_back({ 0, indexCount, -1 });
+        }
+        OptimizeTriangleOrder(vertices.data(), vertexCount, indices.data(), ranges.data(), uint32_t(ranges.size()));
+
+        uint32_t keptVertices = OptimizeVertexFetch(vertices.data(), stride, vertexCount, indices.data(), indexCount);
+        vertices.resize(size_t(keptVertices) * stride);
+
+        VertexCacheStats after = AnalyzeVertexCache(indices.data(), indexCount, keptVertices);
+        ARV_LOG_INFO("MeshOptimizer::Optimize() - {} triangles: ACMR {} -> {}, ATVR {} -> {}",
+                     indexCount / 3, before.acmr, after.acmr, before.atvr, after.atvr);
+    }
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CookedMesh.h"
+#include <cstdint>
+#include <vector>
+
+namespace arv {
+
+    struct VertexCacheStats {
+        float acmr = 0.0f;  // Cache misses per triangle; 0.5 is the ideal for large closed meshes
+        float atvr = 0.0f;  // Cache misses per referenced vertex; 1.0 is ideal
+    };
+
+    /**
+     * Index and vertex reordering for GPU efficiency, run when a mesh is cooked.
+     *
+     *  1. OptimizeVertexCache: Tipsify (Sander et al. 2007) triangle order for a
+     *     FIFO post-transform cache.
+     *  2. OptimizeOverdraw: splits that order into clusters and sorts clusters so
+     *     outward-facing ones draw first, which helps early-z, while keeping the
+     *     cache miss ratio within the given threshold.
+     *  3. OptimizeVertexFetch: renumbers vertices in order of first use so
+     *     vertex fetches walk the buffer linearly; unused vertices are dropped.
+     *
+     * Everything is single-threaded with stable tie-breaking, so the same input
+     * always gives the same output and cooked files are reproducible.
+     */
+    class MeshOptimizer {
+    public:
+        static constexpr uint32_t CacheSize = 16;
+
+        static VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                                   uint32_t cacheSize = CacheSize);
+
+        // Reorders triangles in place; indices must be < vertexCount
+        static void OptimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount,
+                                        uint32_t cacheSize = CacheSize);
+
+        // Reorders triangles in place. positions has stride floats per vertex.
+        // threshold bounds the ACMR of each cluster relative to the input order.
+        static void OptimizeOverdraw(uint32_t* indices, uint32_t indexCount, const float* positions, uint32_t stride,
+                                     uint32_t vertexCount, float threshold = 1.05f, uint32_t cacheSize = CacheSize);
+
+        // Reorders vertices (stride floats each) in place and rewrites the
+        // indices; returns the number of vertices kept
+        static uint32_t OptimizeVertexFetch(float* vertices, uint32_t stride, uint32_t vertexCount,
+                                            uint32_t* indices, uint32_t indexCount);
+
+        // Vertex cache and overdraw ordering of each submesh's triangles, in
+        // place; vertices are in the CookedMesh layout
+        static void OptimizeTriangleOrder(const float* vertices, uint32_t vertexCount, uint32_t* indices,
+                                          const MeshSubmesh* submeshes, uint32_t submeshCount);
+
+        // All three steps on a mesh in the CookedMesh layout. Triangles never
+        // move between submeshes.
+        static void Optimize(std::vector<float>& vertices, std::vector<uint32_t>& indices,
+                             const std::vector<MeshSubmesh>& submeshes);
+    };
+
+}
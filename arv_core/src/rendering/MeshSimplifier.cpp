@@ -0,0 +1,576 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "ARVBase.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <tuple>
+
+namespace arv {
+
+    namespace {
+
+        constexpr uint32_t MinLodTriangles = 32;
+        // Border planes are weighted by squared edge length times this, which
+        // keeps silhouettes and material boundaries in place
+        constexpr double BorderWeight = 10.0;
+
+        // Sum of squared distances to a set of weighted planes
+        struct Quadric {
+            double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+            double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+            double c = 0.0;
+            double area = 0.0;  // Triangle area folded in, to turn the sum into a mean distance
+
+            void AddPlane(const glm::vec3& normal, float distance, double weight)
+            {
+                double x = normal.x, y = normal.y, z = normal.z, d = distance;
+                a00 += weight * x * x; a01 += weight * x * y; a02 += weight * x * z;
+                a11 += weight * y * y; a12 += weight * y * z; a22 += weight * z * z;
+                b0 += weight * x * d; b1 += weight * y * d; b2 += weight * z * d;
+                c += weight * d * d;
+            }
+
+            void Add(const Quadric& other)
+            {
+                a00 += other.a00; a01 += other.a01; a02 += other.a02;
+                a11 += other.a11; a12 += other.a12; a22 += other.a22;
+                b0 += other.b0; b1 += other.b1; b2 += other.b2;
+                c += other.c;
+                area += other.area;
+            }
+
+            double Evaluate(const glm::vec3& p) const
+            {
+                double x = p.x, y = p.y, z = p.z;
+                double result = x * (a00 * x + a01 * y + a02 * z)
+                              + y * (a01 * x + a11 * y + a12 * z)
+                              + z * (a02 * x + a12 * y + a22 * z)
+                              + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+                return result > 0.0 ? result : 0.0;
+            }
+        };
+
+        struct Collapse {
+            float cost;
+            uint32_t from;  // Position ids
+            uint32_t to;
+        };
+
+        bool CollapseLess(const Collapse& a, const Collapse& b)
+        {
+            return std::tie(a.cost, a.from, a.to) < std::tie(b.cost, b.from, b.to);
+        }
+
+        /**
+         * Works on positions: vertices (wedges) with the same position share a
+         * position id, quadric and adjacency, and a collapse moves every wedge
+         * of the source position onto the matching wedge of the target.
+         */
+        class Simplifier {
+        public:
+            Simplifier(const float* vertices, uint32_t vertexCount, const uint32_t* indices,
+                       const MeshSubmesh* submeshes, uint32_t submeshCount);
+
+            // Collapses edges until at most target triangles remain or no
+            // collapse is allowed
+            void Reduce(uint32_t target);
+
+            // Appends the remaining triangles, grouped by the input submeshes
+            void Emit(std::vector<uint32_t>& indices, std::vector<MeshSubmesh>& submeshes) const;
+
+            uint32_t GetTriangleCount() const { return m_LiveTriangles; }
+            // Largest mean surface distance introduced by any collapse so far
+            float GetError() const { return static_cast<float>(m_Error); }
+
+        private:
+            uint32_t PositionOf(uint32_t corner) const { return m_WedgePosition[m_Corners[corner]]; }
+            void BuildAdjacency();
+            bool TryCollapse(const Collapse& collapse);
+
+            std::vector<uint32_t> m_WedgePosition;
+            std::vector<glm::vec3> m_Positions;
+            std::vector<Quadric> m_Quadrics;
+            std::vector<uint8_t> m_Border;
+
+            std::vector<uint32_t> m_Corners;  // Wedge per triangle corner
+            std::vector<uint32_t> m_TriangleSubmesh;
+            std::vector<uint8_t> m_Alive;
+            std::vector<MeshSubmesh> m_Submeshes;
+            uint32_t m_LiveTriangles = 0;
+            double m_Error = 0.0;
+
+            // Position -> live triangles, rebuilt every pass
+            std::vector<uint32_t> m_AdjacencyOffsets;
+            std::vector<uint32_t> m_Adjacency;
+
+            // Positions touched by a collapse in the current pass
+            std::vector<uint32_t> m_LockPass;
+            uint32_t m_Pass = 0;
+
+            std::vector<Collapse> m_Candidates;
+            std::vector<std::pair<uint32_t, uint32_t>> m_WedgeMap;
+            std::vector<uint32_t> m_Shared;
+            std::vector<uint32_t> m_NeighborsFrom;
+            std::vector<uint32_t> m_NeighborsTo;
+        };
+
+        Simplifier::Simplifier(const float* vertices, uint32_t vertexCount, const uint32_t* indices,
+                               const MeshSubmesh* submeshes, uint32_t submeshCount)
+            : m_Submeshes(submeshes, submeshes + submeshCount)
+        {
+            constexpr uint32_t stride = CookedMesh::VertexStride;
+
+            // Weld wedges by exact position, in a fixed order
+            auto positionBits = [&](uint32_t vertex) {
+                std::array<uint32_t, 3> bits;
+                std::memcpy(bits.data(), vertices + size_t(vertex) * stride, sizeof(bits));
+                return bits;
+            };
+            std::vector<uint32_t> order(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; v++) {
+                order[v] = v;
+            }
+            std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                auto bitsA = positionBits(a);
+                auto bitsB = positionBits(b);
+                return bitsA != bitsB ? bitsA < bitsB : a < b;
+            });
+            m_WedgePosition.resize(vertexCount);
+            for (uint32_t i = 0; i < vertexCount; i++) {
+                if (i == 0 || positionBits(order[i]) != positionBits(order[i - 1])) {
+                    const float* p = vertices + size_t(order[i]) * stride;
+                    m_Positions.emplace_back(p[0], p[1], p[2]);
+                }
+                m_WedgePosition[order[i]] = static_cast<uint32_t>(m_Positions.size() - 1);
+            }
+            uint32_t positionCount = static_cast<uint32_t>(m_Positions.size());
+
+            for (uint32_t s = 0; s < submeshCount; s++) {
+                const MeshSubmesh& submesh = submeshes[s];
+                for (uint32_t i = 0; i + 3 <= submesh.indexCount; i += 3) {
+                    for (uint32_t k = 0; k < 3; k++) {
+                        m_Corners.push_back(indices[submesh.firstIndex + i + k]);
+                    }
+                    m_TriangleSubmesh.push_back(s);
+                }
+            }
+            uint32_t triangleCount = static_cast<uint32_t>(m_TriangleSubmesh.size());
+
+            // Triangles already degenerate after welding are left out of every LOD
+            m_Alive.assign(triangleCount, 0);
+            for (uint32_t t = 0; t < triangleCount; t++) {
+                uint32_t p0 = PositionOf(t * 3), p1 = PositionOf(t * 3 + 1), p2 = PositionOf(t * 3 + 2);
+                if (p0 != p1 && p1 != p2 && p0 != p2) {
+                    m_Alive[t] = 1;
+                    m_LiveTriangles++;
+                }
+            }
+
+            m_Quadrics.resize(positionCount);
+            m_Border.assign(positionCount, 0);
+            m_LockPass.assign(positionCount, 0);
+
+            std::vector<glm::vec3> triangleNormals(triangleCount, glm::vec3(0.0f));
+            for (uint32_t t = 0; t < triangleCount; t++) {
+                if (!m_Alive[t]) {
+                    continue;
+                }
+                const glm::vec3& p0 = m_Positions[PositionOf(t * 3)];
+                glm::vec3 normal = glm::cross(m_Positions[PositionOf(t * 3 + 1)] - p0, m_Positions[PositionOf(t * 3 + 2)] - p0);
+                float doubleArea = glm::length(normal);
+                if (doubleArea <= 0.0f) {
+                    continue;
+                }
+                normal /= doubleArea;
+                triangleNormals[t] = normal;
+                for (uint32_t k = 0; k < 3; k++) {
+                    Quadric& quadric = m_Quadrics[PositionOf(t * 3 + k)];
+                    quadric.AddPlane(normal, -glm::dot(normal, p0), 0.5 * doubleArea);
+                    quadric.area += 0.5 * doubleArea;
+                }
+            }
+
+            // Border edges: used by one triangle, by more than two, or by two
+            // triangles of different submeshes
+            struct EdgeRef {
+                uint32_t low, high, submesh, corner;
+            };
+            std::vector<EdgeRef> edges;
+            edges.reserve(size_t(m_LiveTriangles) * 3);
+            for (uint32_t t = 0; t < triangleCount; t++) {
+                if (!m_Alive[t]) {
+                    continue;
+                }
+                for (uint32_t k = 0; k < 3; k++) {
+                    uint32_t a = PositionOf(t * 3 + k);
+                    uint32_t b = PositionOf(t * 3 + (k + 1) % 3);
+                    edges.push_back({ std::min(a, b), std::max(a, b), m_TriangleSubmesh[t], t * 3 + k });
+                }
+            }
+            std::sort(edges.begin(), edges.end(), [](const EdgeRef& a, const EdgeRef& b) {
+                return std::tie(a.low, a.high, a.submesh, a.corner) < std::tie(b.low, b.high, b.submesh, b.corner);
+            });
+
+            size_t begin = 0;
+            while (begin < edges.size()) {
+                size_t end = begin + 1;
+                while (end < edges.size() && edges[end].low == edges[begin].low && edges[end].high == edges[begin].high) {
+                    end++;
+                }
+                bool border = end - begin != 2 || edges[begin].submesh != edges[begin + 1].submesh;
+                if (border) {
+                    m_Border[edges[begin].low] = 1;
+                    m_Border[edges[begin].high] = 1;
+
+                    for (size_t e = begin; e < end; e++) {
+                        uint32_t corner = edges[e].corner;
+                        uint32_t triangle = corner / 3;
+                        uint32_t from = PositionOf(corner);
+                        uint32_t to = PositionOf(triangle * 3 + (corner % 3 + 1) % 3);
+                        glm::vec3 direction = m_Positions[to] - m_Positions[from];
+                        glm::vec3 planeNormal = glm::cross(direction, triangleNormals[triangle]);
+                        float length = glm::length(planeNormal);
+                        if (length <= 0.0f) {
+                            continue;
+                        }
+                        planeNormal /= length;
+                        double weight = double(glm::dot(direction, direction)) * BorderWeight;
+                        float distance = -glm::dot(planeNormal, m_Positions[from]);
+                        m_Quadrics[from].AddPlane(planeNormal, distance, weight);
+                        m_Quadrics[to].AddPlane(planeNormal, distance, weight);
+                    }
+                }
+                begin = end;
+            }
+        }
+
+        void Simplifier::BuildAdjacency()
+        {
+            uint32_t positionCount = static_cast<uint32_t>(m_Positions.size());
+            uint32_t triangleCount = static_cast<uint32_t>(m_Alive.size());
+
+            m_AdjacencyOffsets.assign(size_t(positionCount) + 1, 0);
+            for (uint32_t t = 0; t < triangleCount; t++) {
+                if (m_Alive[t]) {
+                    for (uint32_t k = 0; k < 3; k++) {
+                        m_AdjacencyOffsets[PositionOf(t * 3 + k) + 1]++;
+                    }
+                }
+            }
+            for (uint32_t p = 0; p < positionCount; p++) {
+                m_AdjacencyOffsets[p + 1] += m_AdjacencyOffsets[p];
+            }
+
+            m_Adjacency.resize(m_AdjacencyOffsets[positionCount]);
+            std::vector<uint32_t> cursor(m_AdjacencyOffsets.begin(), m_AdjacencyOffsets.end() - 1);
+            for (uint32_t t = 0; t < triangleCount; t++) {
+                if (m_Alive[t]) {
+                    for (uint32_t k = 0; k < 3; k++) {
+                        m_Adjacency[cursor[PositionOf(t * 3 + k)]++] = t;
+                    }
+                }
+            }
+        }
+
+        bool Simplifier::TryCollapse(const Collapse& collapse)
+        {
+            uint32_t from = collapse.from;
+            uint32_t to = collapse.to;
+            if (m_LockPass[from] == m_Pass || m_LockPass[to] == m_Pass) {
+                return false;
+            }
+
+            // Triangles on the edge vanish; pair up the wedges on either end
+            m_Shared.clear();
+            m_WedgeMap.clear();
+            for (uint32_t a = m_AdjacencyOffsets[from]; a < m_AdjacencyOffsets[from + 1]; a++) {
+                uint32_t triangle = m_Adjacency[a];
+                int fromCorner = -1;
+                int toCorner = -1;
+                for (int k = 0; k < 3; k++) {
+                    uint32_t position = PositionOf(triangle * 3 + k);
+                    if (position == from) {
+                        fromCorner = k;
+                    } else if (position == to) {
+                        toCorner = k;
+                    }
+                }
+                if (toCorner < 0) {
+                    continue;
+                }
+                m_Shared.push_back(triangle);
+
+                uint32_t fromWedge = m_Corners[triangle * 3 + fromCorner];
+                uint32_t toWedge = m_Corners[triangle * 3 + toCorner];
+                auto mapped = std::find_if(m_WedgeMap.begin(), m_WedgeMap.end(),
+                                           [&](const auto& pair) { return pair.first == fromWedge; });
+                if (mapped == m_WedgeMap.end()) {
+                    m_WedgeMap.emplace_back(fromWedge, toWedge);
+                } else if (mapped->second != toWedge) {
+                    return false;
+                }
+            }
+
+            if (m_Shared.empty() || m_Shared.size() > 2) {
+                return false;
+            }
+            if (m_Border[from]) {
+                // Border vertices only slide along a border edge
+                bool borderEdge = m_Shared.size() == 1 ||
+                                  m_TriangleSubmesh[m_Shared[0]] != m_TriangleSubmesh[m_Shared[1]];
+                if (!borderEdge) {
+                    return false;
+                }
+            }
+
+            // Every wedge moved must have a partner on the edge, otherwise the
+            // collapse would drag a seam across the surface
+            m_NeighborsFrom.clear();
+            for (uint32_t a = m_AdjacencyOffsets[from]; a < m_AdjacencyOffsets[from + 1]; a++) {
+                uint32_t triangle = m_Adjacency[a];
+                for (uint32_t k = 0; k < 3; k++) {
+                    uint32_t position = PositionOf(triangle * 3 + k);
+                    if (position == from) {
+                        uint32_t wedge = m_Corners[triangle * 3 + k];
+                        auto mapped = std::find_if(m_WedgeMap.begin(), m_WedgeMap.end(),
+                                                   [&](const auto& pair) { return pair.first == wedge; });
+                        if (mapped == m_WedgeMap.end()) {
+                            return false;
+                        }
+                    } else if (position != to) {
+                        m_NeighborsFrom.push_back(position);
+                    }
+                }
+            }
+
+            // Link condition: the two ends may only share the vertices opposite
+            // the edge, or the collapse pinches the surface
+            m_NeighborsTo.clear();
+            for (uint32_t a = m_AdjacencyOffsets[to]; a < m_AdjacencyOffsets[to + 1]; a++) {
+                uint32_t triangle = m_Adjacency[a];
+                for (uint32_t k = 0; k < 3; k++) {
+                    uint32_t position = PositionOf(triangle * 3 + k);
+                    if (position != from && position != to) {
+                        m_NeighborsTo.push_back(position);
+                    }
+                }
+            }
+            std::sort(m_NeighborsFrom.begin(), m_NeighborsFrom.end());
+            m_NeighborsFrom.erase(std::unique(m_NeighborsFrom.begin(), m_NeighborsFrom.end()), m_NeighborsFrom.end());
+            std::sort(m_NeighborsTo.begin(), m_NeighborsTo.end());
+            m_NeighborsTo.erase(std::unique(m_NeighborsTo.begin(), m_NeighborsTo.end()), m_NeighborsTo.end());
+
+            size_t common = 0;
+            for (size_t i = 0, j = 0; i < m_NeighborsFrom.size() && j < m_NeighborsTo.size();) {
+                if (m_NeighborsFrom[i] < m_NeighborsTo[j]) {
+                    i++;
+                } else if (m_NeighborsTo[j] < m_NeighborsFrom[i]) {
+                    j++;
+                } else {
+                    common++;
+                    i++;
+                    j++;
+                }
+            }
+            if (common != m_Shared.size()) {
+                return false;
+            }
+
+            // No remaining triangle may flip
+            const glm::vec3& target = m_Positions[to];
+            for (uint32_t a = m_AdjacencyOffsets[from]; a < m_AdjacencyOffsets[from + 1]; a++) {
+                uint32_t triangle = m_Adjacency[a];
+                if (std::find(m_Shared.begin(), m_Shared.end(), triangle) != m_Shared.end()) {
+                    continue;
+                }
+                glm::vec3 before[3];
+                glm::vec3 after[3];
+                for (uint32_t k = 0; k < 3; k++) {
+                    uint32_t position = PositionOf(triangle * 3 + k);
+                    before[k] = m_Positions[position];
+                    after[k] = position == from ? target : before[k];
+                }
+                glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+                if (glm::dot(normalBefore, normalAfter) <= 0.0f) {
+                    return false;
+                }
+            }
+
+            for (uint32_t a = m_AdjacencyOffsets[from]; a < m_AdjacencyOffsets[from + 1]; a++) {
+                uint32_t triangle = m_Adjacency[a];
+                if (std::find(m_Shared.begin(), m_Shared.end(), triangle) != m_Shared.end()) {
+                    m_Alive[triangle] = 0;
+                    m_LiveTriangles--;
+                    continue;
+                }
+                for (uint32_t k = 0; k < 3; k++) {
+                    uint32_t& wedge = m_Corners[triangle * 3 + k];
+                    if (m_WedgePosition[wedge] == from) {
+                        wedge = std::find_if(m_WedgeMap.begin(), m_WedgeMap.end(),
+                                             [&](const auto& pair) { return pair.first == wedge; })->second;
+                    }
+                }
+            }
+
+            m_Quadrics[to].Add(m_Quadrics[from]);
+            double area = std::max(m_Quadrics[to].area, 1e-12);
+            m_Error = std::max(m_Error, std::sqrt(double(collapse.cost) / area));
+
+            // The adjacency of these positions is stale until the next pass
+            m_LockPass[from] = m_Pass;
+            m_LockPass[to] = m_Pass;
+            for (uint32_t neighbor : m_NeighborsFrom) {
+                m_LockPass[neighbor] = m_Pass;
+            }
+            return true;
+        }
+
+        void Simplifier::Reduce(uint32_t target)
+        {
+            while (m_LiveTriangles > target) {
+                BuildAdjacency();
+
+                // One direction per triangle edge; the neighbouring triangle
+                // contributes the other direction of interior edges
+                m_Candidates.clear();
+                uint32_t triangleCount = static_cast<uint32_t>(m_Alive.size());
+                for (uint32_t t = 0; t < triangleCount; t++) {
+                    if (!m_Alive[t]) {
+                        continue;
+                    }
+                    for (uint32_t k = 0; k < 3; k++) {
+                        uint32_t from = PositionOf(t * 3 + k);
+                        uint32_t to = PositionOf(t * 3 + (k + 1) % 3);
+                        if (m_Border[from] && !m_Border[to]) {
+                            continue;
+                        }
+                        Quadric quadric = m_Quadrics[from];
+                        quadric.Add(m_Quadrics[to]);
+                        m_Candidates.push_back({ static_cast<float>(quadric.Evaluate(m_Positions[to])), from, to });
+                    }
+                }
+                if (m_Candidates.empty()) {
+                    break;
+                }
+
+                // Only the cheapest edges are tried each pass; each collapse
+                // removes about two triangles
+                size_t budget = std::min(m_Candidates.size(), size_t(m_LiveTriangles - target));
+                std::nth_element(m_Candidates.begin(), m_Candidates.begin() + budget, m_Candidates.end(), CollapseLess);
+                std::sort(m_Candidates.begin(), m_Candidates.begin() + budget, CollapseLess);
+
+                m_Pass++;
+                uint32_t liveBefore = m_LiveTriangles;
+                uint32_t collapsed = 0;
+                for (size_t i = 0; i < budget && m_LiveTriangles > target; i++) {
+                    collapsed += TryCollapse(m_Candidates[i]) ? 1 : 0;
+                }
+                if (collapsed == 0) {
+                    // Every cheap edge was rejected; try the rest once before giving up
+                    std::sort(m_Candidates.begin() + budget, m_Candidates.end(), CollapseLess);
+                    for (size_t i = budget; i < m_Candidates.size() && m_LiveTriangles > target; i++) {
+                        collapsed += TryCollapse(m_Candidates[i]) ? 1 : 0;
+                    }
+                    if (collapsed == 0) {
+                        break;
+                    }
+                }
+
+                // Meshes that resist simplification (triangle soups, many tiny
+                // parts) make a little progress per pass for a very long time
+                if (uint64_t(liveBefore - m_LiveTriangles) * 100 < uint64_t(liveBefore - target)) {
+                    break;
+                }
+            }
+        }
+
+        void Simplifier::Emit(std::vector<uint32_t>& indices, std::vector<MeshSubmesh>& submeshes) const
+        {
+            uint32_t triangle = 0;
+            for (uint32_t s = 0; s < m_Submeshes.size(); s++) {
+                MeshSubmesh submesh = m_Submeshes[s];
+                submesh.firstIndex = static_cast<uint32_t>(indices.size());
+                uint32_t end = triangle + m_Submeshes[s].indexCount / 3;
+                for (; triangle < end; triangle++) {
+                    if (m_Alive[triangle]) {
+                        indices.insert(indices.end(), m_Corners.begin() + triangle * 3, m_Corners.begin() + triangle * 3 + 3);
+                    }
+                }
+                submesh.indexCount = static_cast<uint32_t>(indices.size()) - submesh.firstIndex;
+                if (submesh.indexCount > 0) {
+                    submeshes.push_back(submesh);
+                }
+            }
+        }
+
+    }
+
+    void MeshSimplifier::GenerateLods(const std::vector<float>& vertices, std::vector<uint32_t>& indices,
+                                      std::vector<MeshSubmesh>& submeshes, std::vector<MeshLod>& lods,
+                                      const std::vector<float>& ratios)
+    {
+        constexpr uint32_t stride = CookedMesh::VertexStride;
+        uint32_t vertexCount = static_cast<uint32_t>(vertices.size() / stride);
+
+        lods.clear();
+        MeshLod base;
+        base.indexCount = static_cast<uint32_t>(indices.size());
+        base.submeshCount = static_cast<uint32_t>(submeshes.size());
+        lods.push_back(base);
+
+        uint32_t triangleCount = base.indexCount / 3;
+        if (vertexCount == 0 || triangleCount < MinLodTriangles * 2) {
+            return;
+        }
+
+        glm::vec3 boundsMin(vertices[0], vertices[1], vertices[2]);
+        glm::vec3 boundsMax = boundsMin;
+        for (uint32_t v = 1; v < vertexCount; v++) {
+            glm::vec3 position(vertices[v * stride], vertices[v * stride + 1], vertices[v * stride + 2]);
+            boundsMin = glm::min(boundsMin, position);
+            boundsMax = glm::max(boundsMax, position);
+        }
+        float radius = 0.5f * glm::length(boundsMax - boundsMin);
+        if (radius <= 0.0f) {
+            return;
+        }
+
+        Simplifier simplifier(vertices.data(), vertexCount, indices.data(), submeshes.data(), base.submeshCount);
+        uint32_t previous = triangleCount;
+
+        for (float ratio : ratios) {
+            uint32_t target = static_cast<uint32_t>(triangleCount * ratio);
+            if (target < MinLodTriangles) {
+                break;
+            }
+            simplifier.Reduce(target);
+
+            // A level that isn't clearly smaller than the last one is not worth its memory
+            uint32_t reached = simplifier.GetTriangleCount();
+            if (uint64_t(reached) * 20 > uint64_t(previous) * 17) {
+                break;
+            }
+            previous = reached;
+
+            MeshLod lod;
+            lod.firstIndex = static_cast<uint32_t>(indices.size());
+            lod.firstSubmesh = static_cast<uint32_t>(submeshes.size());
+            simplifier.Emit(indices, submeshes);
+            lod.indexCount = static_cast<uint32_t>(indices.size()) - lod.firstIndex;
+            lod.submeshCount = static_cast<uint32_t>(submeshes.size()) - lod.firstSubmesh;
+            lod.error = simplifier.GetError() / radius;
+
+            MeshOptimizer::OptimizeTriangleOrder(vertices.data(), vertexCount, indices.data(),
+                                                 submeshes.data() + lod.firstSubmesh, lod.submeshCount);
+
+            ARV_LOG_INFO("MeshSimplifier::GenerateLods() - LOD {}: {} triangles, error {}",
+                         lods.size(), reached, lod.error);
+            lods.push_back(lod);
+        }
+    }
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CookedMesh.h"
+#include <cstdint>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * Level-of-detail generation by quadric error metric simplification
+     * (Garland & Heckbert 1997).
+     *
+     * Edges are collapsed onto one of their vertices, so every level indexes
+     * the original vertex buffer and a LOD only costs index memory. Vertices
+     * split by a UV or normal seam collapse together along the seam, open
+     * borders and borders between submeshes only move along themselves, and
+     * collapses that would fold a triangle over are skipped.
+     *
+     * Each pass collapses the cheapest independent edges; ties are broken by
+     * vertex index, so the same mesh always gives the same chain.
+     */
+    class MeshSimplifier {
+    public:
+        // Appends one level per ratio (of the LOD 0 triangle count) to indices
+        // and submeshes, which hold LOD 0 on entry, and fills lods with LOD 0
+        // followed by the new levels. The chain ends early when a level would
+        // be too small or no longer shrinks the mesh.
+        static void GenerateLods(const std::vector<float>& vertices, std::vector<uint32_t>& indices,
+                                 std::vector<MeshSubmesh>& submeshes, std::vector<MeshLod>& lods,
+                                 const std::vector<float>& ratios = { 0.5f, 0.25f, 0.125f, 0.0625f });
+    };
+
+}
@@ -0,0 +1,201 @@
+#include "MipChain.h"
+#include "math/SimdLane.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace arv {
+
+    namespace {
+
+        // Source texels a destination texel averages along one axis
+        struct Taps {
+            uint32_t first = 0;
+            uint32_t count = 0;
+            float weight[3] = { 0.0f, 0.0f, 0.0f };
+        };
+
+        void ComputeTaps(uint32_t sourceSize, std::vector<Taps>& taps) {
+            uint32_t size = std::max(1u, sourceSize / 2);
+            taps.resize(size);
+            for (uint32_t i = 0; i < size; i++) {
+                Taps& t = taps[i];
+                if (sourceSize == 1) {
+                    t.first = 0;
+                    t.count = 1;
+                    t.weight[0] = 1.0f;
+                } else if (sourceSize % 2 == 0) {
+                    t.first = 2 * i;
+                    t.count = 2;
+                    t.weight[0] = 0.5f;
+                    t.weight[1] = 0.5f;
+                } else {
+                    // Each of the n destination texels covers (2n + 1) / n source
+                    // texels, so the outer two are only partly inside it
+                    float n = static_cast<float>(size);
+                    float scale = 1.0f / (2.0f * n + 1.0f);
+                    t.first = 2 * i;
+                    t.count = 3;
+                    t.weight[0] = (n - i) * scale;
+                    t.weight[1] = n * scale;
+                    t.weight[2] = (i + 1) * scale;
+                }
+            }
+        }
+
+        const std::array<float, 256>& SrgbToLinearTable() {
+            static const std::array<float, 256> table = []() {
+                std::array<float, 256> values{};
+                for (uint32_t i = 0; i < 256; i++) {
+                    float c = i / 255.0f;
+                    values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        const std::array<float, 256>& UnormToFloatTable() {
+            static const std::array<float, 256> table = []() {
+                std::array<float, 256> values{};
+                for (uint32_t i = 0; i < 256; i++) {
+                    values[i] = i / 255.0f;
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        // 4096 steps keep the darkest encoded values within one step of exact
+        constexpr uint32_t LinearToSrgbSteps = 4096;
+
+        const std::array<uint8_t, LinearToSrgbSteps>& LinearToSrgbTable() {
+            static const std::array<uint8_t, LinearToSrgbSteps> table = []() {
+                std::array<uint8_t, LinearToSrgbSteps> values{};
+                for (uint32_t i = 0; i < LinearToSrgbSteps; i++) {
+                    float c = i / static_cast<float>(LinearToSrgbSteps - 1);
+                    float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+                    values[i] = static_cast<uint8_t>(std::min(255.0f, s * 255.0f + 0.5f));
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        uint8_t EncodeSrgb(float value) {
+            float scaled = std::min(std::max(value, 0.0f), 1.0f) * (LinearToSrgbSteps - 1) + 0.5f;
+            return LinearToSrgbTable()[static_cast<uint32_t>(scaled)];
+        }
+
+        uint8_t EncodeUnorm(float value) {
+            return static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+
+        // accum += row * weight; the bulk of the filter's arithmetic
+        void AccumulateRow(float* accum, const float* row, float weight, size_t count) {
+            size_t i = 0;
+#if defined(ARV_SIMD_AVX2) || defined(ARV_SIMD_NEON)
+            SimdLane::Type w = SimdLane::Set(weight);
+            for (; i + SimdLane::Width <= count; i += SimdLane::Width) {
+                SimdLane::Store(accum + i, SimdLane::Add(SimdLane::Load(accum + i),
+                                                         SimdLane::Mul(SimdLane::Load(row + i), w)));
+            }
+#endif
+            for (; i < count; i++) {
+                accum[i] += row[i] * weight;
+            }
+        }
+
+        void Downsample(const TextureMipLevel& source, const TextureMipLevel& target, bool srgb) {
+            const float* colorTable = srgb ? SrgbToLinearTable().data() : UnormToFloatTable().data();
+            const float* alphaTable = UnormToFloatTable().data();
+
+            std::vector<Taps> xTaps, yTaps;
+            ComputeTaps(source.width, xTaps);
+            ComputeTaps(source.height, yTaps);
+
+            const size_t rowFloats = static_cast<size_t>(source.width) * 4;
+            std::vector<float> decoded(rowFloats);
+            std::vector<float> accum(rowFloats);
+
+            const uint8_t* sourceTexels = static_cast<const uint8_t*>(source.pixels);
+            uint8_t* targetTexels = static_cast<uint8_t*>(const_cast<void*>(target.pixels));
+
+            for (uint32_t y = 0; y < target.height; y++) {
+                // Vertical pass over whole rows, in linear light
+                std::fill(accum.begin(), accum.end(), 0.0f);
+                const Taps& ty = yTaps[y];
+                for (uint32_t k = 0; k < ty.count; k++) {
+                    const uint8_t* row = sourceTexels + (ty.first + k) * rowFloats;
+                    for (size_t i = 0; i < rowFloats; i += 4) {
+                        decoded[i] = colorTable[row[i]];
+                        decoded[i + 1] = colorTable[row[i + 1]];
+                        decoded[i + 2] = colorTable[row[i + 2]];
+                        decoded[i + 3] = alphaTable[row[i + 3]];
+                    }
+                    AccumulateRow(accum.data(), decoded.data(), ty.weight[k], rowFloats);
+                }
+
+                // Horizontal pass, then back to 8 bits
+                uint8_t* out = targetTexels + static_cast<size_t>(y) * target.width * 4;
+                for (uint32_t x = 0; x < target.width; x++) {
+                    const Taps& tx = xTaps[x];
+                    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    for (uint32_t k = 0; k < tx.count; k++) {
+                        const float* texel = accum.data() + (tx.first + k) * 4;
+                        for (int c = 0; c < 4; c++) {
+                            sum[c] += texel[c] * tx.weight[k];
+                        }
+                    }
+                    for (int c = 0; c < 3; c++) {
+                        out[x * 4 + c] = srgb ? EncodeSrgb(sum[c]) : EncodeUnorm(sum[c]);
+                    }
+                    out[x * 4 + 3] = EncodeUnorm(sum[3]);
+                }
+            }
+        }
+
+    }
+
+    uint32_t MipChain::GetLevelCount(uint32_t width, uint32_t height, uint32_t requestedLevels) {
+        uint32_t size = std::max(width, height);
+        uint32_t full = 1;
+        while (size > 1) {
+            size /= 2;
+            full++;
+        }
+        return requestedLevels == 0 ? full : std::min(requestedLevels, full);
+    }
+
+    MipChain MipChain::Build(const void* pixels, uint32_t width, uint32_t height, const TextureSpecification& spec) {
+        MipChain chain;
+        if (!pixels || width == 0 || height == 0) {
+            return chain;
+        }
+
+        uint32_t count = GetLevelCount(width, height, spec.mipLevels);
+        chain.m_Levels.resize(count);
+        chain.m_Levels[0] = { width, height, pixels };
+
+        // Sized up front so the level pointers stay valid
+        size_t storageSize = 0;
+        for (uint32_t i = 1; i < count; i++) {
+            TextureMipLevel& level = chain.m_Levels[i];
+            level.width = std::max(1u, chain.m_Levels[i - 1].width / 2);
+            level.height = std::max(1u, chain.m_Levels[i - 1].height / 2);
+            storageSize += static_cast<size_t>(level.width) * level.height * 4;
+        }
+        chain.m_Storage.resize(storageSize);
+
+        size_t offset = 0;
+        for (uint32_t i = 1; i < count; i++) {
+            TextureMipLevel& level = chain.m_Levels[i];
+            level.pixels = chain.m_Storage.data() + offset;
+            offset += static_cast<size_t>(level.width) * level.height * 4;
+            Downsample(chain.m_Levels[i - 1], level, spec.srgb);
+        }
+        return chain;
+    }
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include <cstdint>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * RGBA8 mip chain built on the CPU, so every backend samples the same
+     * texels instead of whatever its driver's mip generation produces.
+     *
+     * Each level is a box filter of the previous one, in linear light for sRGB
+     * textures. Odd sizes use the three-tap polyphase box, so no source row or
+     * column is dropped and the result doesn't depend on which way up the rows
+     * are stored. Level sizes halve and round down, as GPUs expect.
+     *
+     * Level 0 points at the source pixels, which must outlive the chain. The
+     * levels point into the chain's own storage, so chains move but don't copy.
+     */
+    class MipChain {
+    public:
+        MipChain() = default;
+        MipChain(MipChain&&) = default;
+        MipChain& operator=(MipChain&&) = default;
+        MipChain(const MipChain&) = delete;
+        MipChain& operator=(const MipChain&) = delete;
+
+        // Levels for a width x height texture; requestedLevels 0 means the full chain
+        static uint32_t GetLevelCount(uint32_t width, uint32_t height, uint32_t requestedLevels = 0);
+
+        // pixels are RGBA8; spec gives the level count and whether they are sRGB
+        static MipChain Build(const void* pixels, uint32_t width, uint32_t height, const TextureSpecification& spec);
+
+        const TextureMipLevel* GetLevels() const { return m_Levels.data(); }
+        uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_Levels.size()); }
+
+    private:
+        std::vector<TextureMipLevel> m_Levels;
+        std::vector<uint8_t> m_Storage;  // Levels 1 and up
+    };
+
+}
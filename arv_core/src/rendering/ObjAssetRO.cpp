@@ -1,124 +1,102 @@
 #include "ObjAssetRO.h"
 #include "ARVApplication.h"
 #include "rendering/ShaderSource.h"
-#include "CoreShaderSource.h"
 #include "utils/AssetPath.h"
+#include "utils/Stopwatch.h"
+#include "ObjParser.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "QuantizedVertex.h"
+#include "ResourceCache.h"
+#include "ShaderLibrary.h"
 #include "ARVBase.h"
 
-#define TINYOBJLOADER_IMPLEMENTATION
-#include "tiny_obj_loader.h"
-
-#include <unordered_map>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <map>
 
 namespace arv {
 
-    ObjAssetRO::ObjAssetRO(const std::string& pathFragment) {
-
-        ARVApplication* app = ARVApplication::Get();
+    static constexpr UniformId PositionScaleUniform("u_PositionScale");
+    static constexpr UniformId PositionOffsetUniform("u_PositionOffset");
 
-        // Build paths - use lowercase for the obj filename
-        m_AssetPath = AssetPath::Resolve("objects/" + pathFragment);
-        std::string lowercaseName = pathFragment;
-        std::transform(lowercaseName.begin(), lowercaseName.end(), lowercaseName.begin(),
-                       [](unsigned char c) { return std::tolower(c); });
-        std::string objPath = m_AssetPath + "/" + lowercaseName + ".obj";
+    bool ObjAssetRO::MeshAsset::CookObj(const std::string& objPath, const std::string& cachePath) {
 
         ARV_LOG_INFO("ObjAssetRO: Loading OBJ from {}", objPath);
 
-        // Load OBJ file using tinyobjloader
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
-        std::string warn, err;
-
-        // Use the asset folder as the material search path
-        bool success = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
-                                         objPath.c_str(), (m_AssetPath + "/").c_str());
-
-        if (!warn.empty()) {
-            ARV_LOG_INFO("ObjAssetRO warning: {}", warn);
+        auto parseStart = std::chrono::steady_clock::now();
+        ObjMeshData parsed;
+        if (!ObjParser::Parse(objPath, parsed)) {
+            ARV_LOG_ERROR("ObjAssetRO: Failed to load OBJ file: {}", objPath);
+            return false;
         }
+        double parseMs = MillisecondsSince(parseStart);
 
-        if (!err.empty()) {
-            ARV_LOG_ERROR("ObjAssetRO error: {}", err);
-        }
+        // Reorder once here so every later load maps GPU-friendly data
+        auto optimizeStart = std::chrono::steady_clock::now();
+        MeshOptimizer::Optimize(parsed.vertices, parsed.indices, parsed.submeshes);
+        double optimizeMs = MillisecondsSince(optimizeStart);
 
-        if (!success) {
-            ARV_LOG_ERROR("ObjAssetRO: Failed to load OBJ file: {}", objPath);
-            return;
-        }
+        auto lodStart = std::chrono::steady_clock::now();
+        std::vector<MeshLod> lods;
+        MeshSimplifier::GenerateLods(parsed.vertices, parsed.indices, parsed.submeshes, lods);
+        double lodMs = MillisecondsSince(lodStart);
 
-        ARV_LOG_INFO("ObjAssetRO: Loaded {} shapes, {} materials", shapes.size(), materials.size());
+        ARV_LOG_INFO("ObjAssetRO: Loaded {} submeshes, {} materials", parsed.submeshes.size(), parsed.materialTextures.size());
         ARV_LOG_INFO("ObjAssetRO: {} vertices, {} normals, {} texcoords",
-                     attrib.vertices.size() / 3,
-                     attrib.normals.size() / 3,
-                     attrib.texcoords.size() / 2);
-
-        // Build interleaved vertex data: position (3) + texcoord (2) + normal (3) = 8 floats per vertex
-        std::vector<float> vertices;
-        std::vector<uint32_t> indices;
-
-        // Use a map to avoid duplicate vertices
-        std::unordered_map<std::string, uint32_t> uniqueVertices;
-
-        for (const auto& shape : shapes) {
-            for (const auto& index : shape.mesh.indices) {
-                // Create a unique key for this vertex combination
-                std::string key = std::to_string(index.vertex_index) + "/" +
-                                  std::to_string(index.texcoord_index) + "/" +
-                                  std::to_string(index.normal_index);
-
-                if (uniqueVertices.count(key) == 0) {
-                    // This is a new unique vertex
-                    uniqueVertices[key] = static_cast<uint32_t>(vertices.size() / 8);
-
-                    // Position
-                    vertices.push_back(attrib.vertices[3 * index.vertex_index + 0]);
-                    vertices.push_back(attrib.vertices[3 * index.vertex_index + 1]);
-                    vertices.push_back(attrib.vertices[3 * index.vertex_index + 2]);
-
-                    // Texture coordinates (if available)
-                    if (index.texcoord_index >= 0) {
-                        vertices.push_back(attrib.texcoords[2 * index.texcoord_index + 0]);
-                        vertices.push_back(attrib.texcoords[2 * index.texcoord_index + 1]);
-                    } else {
-                        vertices.push_back(0.0f);
-                        vertices.push_back(0.0f);
-                    }
-
-                    // Normal (if available)
-                    if (index.normal_index >= 0) {
-                        vertices.push_back(attrib.normals[3 * index.normal_index + 0]);
-                        vertices.push_back(attrib.normals[3 * index.normal_index + 1]);
-                        vertices.push_back(attrib.normals[3 * index.normal_index + 2]);
-                    } else {
-                        vertices.push_back(0.0f);
-                        vertices.push_back(1.0f);
-                        vertices.push_back(0.0f);
-                    }
-                }
+                     parsed.positionCount, parsed.normalCount, parsed.texcoordCount);
+        ARV_LOG_INFO("ObjAssetRO: Built {} unique vertices, {} indices",
+                     parsed.vertices.size() / CookedMesh::VertexStride, parsed.indices.size());
 
-                indices.push_back(uniqueVertices[key]);
-            }
+        mesh.Assign(std::move(parsed.vertices), std::move(parsed.indices),
+                    std::move(parsed.submeshes), std::move(parsed.materialTextures), std::move(lods));
+
+        auto cookStart = std::chrono::steady_clock::now();
+        if (mesh.Write(cachePath, objPath)) {
+            // Switch to the mapped copy so the heap copy can go
+            mesh.Load(cachePath, objPath);
         }
+        double cookMs = MillisecondsSince(cookStart);
 
-        ARV_LOG_INFO("ObjAssetRO: Built {} unique vertices, {} indices",
-                     vertices.size() / 8, indices.size());
-
-        // Compute axis-aligned bounding box from vertex positions
-        if (vertices.size() >= 8) {
-            m_boundsMin = glm::vec3(vertices[0], vertices[1], vertices[2]);
-            m_boundsMax = m_boundsMin;
-            for (size_t i = 0; i < vertices.size() / 8; i++) {
-                float x = vertices[i * 8 + 0];
-                float y = vertices[i * 8 + 1];
-                float z = vertices[i * 8 + 2];
-                m_boundsMin = glm::min(m_boundsMin, glm::vec3(x, y, z));
-                m_boundsMax = glm::max(m_boundsMax, glm::vec3(x, y, z));
-            }
+        ARV_LOG_INFO("ObjAssetRO: Cooked {} - parse {:.1f} ms, optimize {:.1f} ms, LODs {:.1f} ms, write {:.1f} ms",
+                     cachePath, parseMs, optimizeMs, lodMs, cookMs);
+        return true;
+    }
+
+    void ObjAssetRO::MeshAsset::Load(const std::string& pathFragment) {
+
+        ARVApplication* app = ARVApplication::Get();
+
+        // Build paths - use lowercase for the obj filename
+        std::string lowercaseName = pathFragment;
+        std::transform(lowercaseName.begin(), lowercaseName.end(), lowercaseName.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        std::string objPath = assetPath + "/" + lowercaseName + ".obj";
+        std::string cachePath = assetPath + "/" + lowercaseName + ".arvmesh";
+
+        // The cooked mesh is mapped and handed to the GPU as is; only a
+        // missing or stale cache goes through the OBJ parser
+        auto meshStart = std::chrono::steady_clock::now();
+        if (mesh.Load(cachePath, objPath)) {
+            ARV_LOG_INFO("ObjAssetRO: Mapped cooked mesh {}", cachePath);
+        } else if (!CookObj(objPath, cachePath)) {
+            return;
+        }
+        double meshMs = MillisecondsSince(meshStart);
+
+        glm::vec3 boundsMin = mesh.GetBoundsMin();
+        glm::vec3 boundsMax = mesh.GetBoundsMax();
+
+        Renderer* renderer = app->GetRenderer();
+        if (vertexFormat == VertexFormat::Quantized &&
+            !(renderer->SupportsVertexType(ShaderDataType::UShort4) &&
+              renderer->SupportsVertexType(ShaderDataType::Half2) &&
+              renderer->SupportsVertexType(ShaderDataType::Short2))) {
+            ARV_LOG_WARN("ObjAssetRO: Backend has no 16-bit vertex types, using float vertices");
+            vertexFormat = VertexFormat::Float;
         }
+        bool quantized = vertexFormat == VertexFormat::Quantized;
 
         // Shader with position, texcoord, and normal support
         std::string fullSource = R"(
@@ -126,21 +104,61 @@ namespace arv {
             ### GLSL_VERTEX_SHADER ###
 
             #version 330 core
+            )" + std::string(quantized ? "#define ARV_QUANTIZED" : "") + R"(
 
             layout(location = 0) in vec3 a_Position;
             layout(location = 1) in vec2 a_TexCoord;
+            #ifdef ARV_QUANTIZED
+            layout(location = 2) in vec2 a_Normal;
+
+            // Dequantization from the mesh bounds, see QuantizedVertex
+            uniform vec4 u_PositionScale;
+            uniform vec4 u_PositionOffset;
+
+            vec3 OctahedralDecode(vec2 e)
+            {
+                vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+                float t = max(-n.z, 0.0);
+                n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+                return normalize(n);
+            }
+            #else
             layout(location = 2) in vec3 a_Normal;
+            #endif
+
+            #ifdef ARV_INSTANCED
+            layout(location = 8) in mat4 a_InstanceModel;
+            layout(location = 12) in vec4 a_InstanceTint;
 
-            uniform mat4 u_mvp;
+            uniform mat4 u_viewProjection;
+
+            out vec4 v_Tint;
+            #else
+            layout(std140) uniform ArvObject {
+                mat4 u_model;
+                mat4 u_mvp;
+            };
+            #endif
 
             out vec2 v_TexCoord;
             out vec3 v_Normal;
 
             void main()
             {
-                v_TexCoord = a_TexCoord;
+            #ifdef ARV_QUANTIZED
+                vec3 position = u_PositionOffset.xyz + a_Position * u_PositionScale.xyz;
+                v_Normal = OctahedralDecode(a_Normal);
+            #else
+                vec3 position = a_Position;
                 v_Normal = a_Normal;
-                gl_Position = u_mvp * vec4(a_Position, 1.0);
+            #endif
+                v_TexCoord = a_TexCoord;
+            #ifdef ARV_INSTANCED
+                v_Tint = a_InstanceTint;
+                gl_Position = u_viewProjection * a_InstanceModel * vec4(position, 1.0);
+            #else
+                gl_Position = u_mvp * vec4(position, 1.0);
+            #endif
             }
 
             ### GLSL_FRAGMENT_SHADER ###
@@ -151,6 +169,9 @@ namespace arv {
 
             in vec2 v_TexCoord;
             in vec3 v_Normal;
+            #ifdef ARV_INSTANCED
+            in vec4 v_Tint;
+            #endif
 
             uniform sampler2D u_Texture;
 
@@ -161,8 +182,17 @@ namespace arv {
                 float diff = max(dot(normalize(v_Normal), lightDir), 0.3);
                 vec4 texColor = texture(u_Texture, v_TexCoord);
                 color = vec4(texColor.rgb * diff, texColor.a);
+            #ifdef ARV_INSTANCED
+                color *= v_Tint;
+            #endif
             }
 
+            ### SOFTWARE_SHADER ###
+
+            texture = u_Texture
+            lighting = directional
+            )" + std::string(quantized ? "positionDecode = u_PositionScale u_PositionOffset\n normals = octahedral" : "") + R"(
+
             ### MSL_SHADER ###
 
             #include <metal_stdlib>
@@ -203,48 +233,195 @@ namespace arv {
             }
         )";
 
-        m_ShaderSource = std::make_unique<CoreShaderSource>(fullSource);
-        m_Shader = app->GetRenderer()->CreateShader(m_ShaderSource.get());
-        m_Shader->Compile();
+        // Every asset with the same vertex format shares the program
+        shader = ShaderLibrary::Global().Get(fullSource);
+
+        auto uploadStart = std::chrono::steady_clock::now();
+        vertexArray = renderer->CreateVertexArray();
 
-        m_VertexArray = app->GetRenderer()->CreateVertexArray();
+        std::shared_ptr<VertexBuffer> vertexBuffer;
+        if (quantized) {
+            std::vector<QuantizedVertex> packed(mesh.GetVertexCount());
+            QuantizeVertices(mesh.GetVertices(), mesh.GetVertexCount(), boundsMin, boundsMax, packed.data());
 
-        auto vertexBuffer = app->GetRenderer()->CreateVertexBuffer(vertices.data(),
-                                                                    vertices.size() * sizeof(float));
-        BufferLayout layout = {
-            { ShaderDataType::Float3, "a_Position" },
-            { ShaderDataType::Float2, "a_TexCoord" },
-            { ShaderDataType::Float3, "a_Normal" }
+            // CreateVertexBuffer takes raw bytes despite the float pointer
+            vertexBuffer = renderer->CreateVertexBuffer(reinterpret_cast<float*>(packed.data()),
+                                                        static_cast<unsigned int>(packed.size() * sizeof(QuantizedVertex)));
+            vertexBuffer->SetLayout(QuantizedVertex::GetLayout());
+
+            // The dequantization belongs to this mesh, not to the shared shader
+            uniforms.SetFloat4(PositionScaleUniform, glm::vec4(QuantizedVertex::GetDecodeScale(boundsMin, boundsMax), 0.0f));
+            uniforms.SetFloat4(PositionOffsetUniform, glm::vec4(QuantizedVertex::GetDecodeOffset(boundsMin, boundsMax), 0.0f));
+        } else {
+            // The buffers only read the data; the const_casts let mapped pages through without a copy
+            vertexBuffer = renderer->CreateVertexBuffer(const_cast<float*>(mesh.GetVertices()),
+                                                        mesh.GetVertexCount() * CookedMesh::VertexStride * sizeof(float));
+            BufferLayout layout = {
+                { ShaderDataType::Float3, "a_Position" },
+                { ShaderDataType::Float2, "a_TexCoord" },
+                { ShaderDataType::Float3, "a_Normal" }
+            };
+            vertexBuffer->SetLayout(layout);
+        }
+        vertexArray->AddVertexBuffer(vertexBuffer);
+
+        // The indices of every LOD go into one buffer; LODs and submeshes are
+        // drawn as ranges of it
+        auto indexBuffer = renderer->CreateIndexBuffer(const_cast<uint32_t*>(mesh.GetIndices()),
+                                                       mesh.GetTotalIndexCount());
+        vertexArray->SetIndexBuffer(indexBuffer);
+        vertexArray->Unbind();
+        double uploadMs = MillisecondsSince(uploadStart);
+
+        auto textureStart = std::chrono::steady_clock::now();
+        LoadMaterials(pathFragment);
+        double textureMs = MillisecondsSince(textureStart);
+
+        ARV_LOG_INFO("ObjAssetRO: {} vertices as {}, {} KB",
+                     mesh.GetVertexCount(), quantized ? "quantized" : "float",
+                     mesh.GetVertexCount() * (quantized ? sizeof(QuantizedVertex) : CookedMesh::VertexStride * sizeof(float)) / 1024);
+        ARV_LOG_INFO("ObjAssetRO: Load times - mesh {:.1f} ms ({}), upload {:.1f} ms, texture {:.1f} ms",
+                     meshMs, mesh.IsMapped() ? "mapped" : "parsed", uploadMs, textureMs);
+    }
+
+    void ObjAssetRO::MeshAsset::LoadMaterials(const std::string& pathFragment) {
+        // MTL texture maps tile unless they ask for -clamp; mips and anisotropic
+        // filtering keep minified surfaces from aliasing
+        TextureSpecification textureSpec;
+        textureSpec.wrap = TextureWrap::Repeat;
+
+        // Block compression cuts texture memory to a quarter; the first load cooks
+        // a .arvtex next to each image, later loads map it
+        Renderer* renderer = ARVApplication::Get()->GetRenderer();
+        if (renderer->SupportsTextureFormat(TextureFormat::BC7)) {
+            textureSpec.format = TextureFormat::BC7;
+        } else if (renderer->SupportsTextureFormat(TextureFormat::BC3)) {
+            textureSpec.format = TextureFormat::BC3;
+        }
+
+        // Materials sharing a texture file share the texture, as do other assets using it
+        std::map<std::string, std::shared_ptr<Texture2D>> texturesByPath;
+        auto loadTexture = [&](const std::string& path) {
+            auto& loaded = texturesByPath[path];
+            if (!loaded) {
+                ARV_LOG_INFO("ObjAssetRO: Using texture: {}", path);
+                loaded = ResourceCache::Global().StreamTexture2D(path, textureSpec);
+            }
+            return loaded;
         };
-        vertexBuffer->SetLayout(layout);
-        m_VertexArray->AddVertexBuffer(vertexBuffer);
 
-        auto indexBuffer = app->GetRenderer()->CreateIndexBuffer(indices.data(),
-                                                                  static_cast<unsigned int>(indices.size()));
-        m_VertexArray->SetIndexBuffer(indexBuffer);
+        // Materials without a diffuse texture, and faces without a material, use
+        // the texture of the common naming convention
+        std::string fallbackPath = assetPath + "/textures/" + pathFragment + "_Body_Mat_baseColor.png";
+        const std::vector<std::string>& materialTextures = mesh.GetMaterialTextures();
+        auto materialTexture = [&](int32_t materialIndex) {
+            if (materialIndex >= 0 && materialIndex < static_cast<int32_t>(materialTextures.size()) &&
+                !materialTextures[materialIndex].empty()) {
+                return loadTexture(assetPath + "/" + materialTextures[materialIndex]);
+            }
+            return loadTexture(fallbackPath);
+        };
 
-        m_VertexArray->Unbind();
+        // Submeshes are already in material order; neighbours with the same
+        // texture merge into one draw
+        const MeshSubmesh* submeshes = mesh.GetSubmeshes();
+        submeshDraws.resize(mesh.GetLodCount());
+        for (uint32_t lod = 0; lod < mesh.GetLodCount(); lod++) {
+            const MeshLod& range = mesh.GetLod(lod);
+            std::vector<SubmeshDraw>& draws = submeshDraws[lod];
+            for (uint32_t i = range.firstSubmesh; i < range.firstSubmesh + range.submeshCount; i++) {
+                const MeshSubmesh& submesh = submeshes[i];
+                if (submesh.firstIndex < range.firstIndex ||
+                    submesh.firstIndex + submesh.indexCount > range.firstIndex + range.indexCount) {
+                    ARV_LOG_WARN("ObjAssetRO: Submesh {} is outside LOD {}, skipping it", i, lod);
+                    continue;
+                }
 
-        // Load texture - try to find diffuse texture from materials
-        std::string texturePath;
-        if (!materials.empty() && !materials[0].diffuse_texname.empty()) {
-            texturePath = m_AssetPath + "/" + materials[0].diffuse_texname;
-            ARV_LOG_INFO("ObjAssetRO: Using material texture: {}", texturePath);
-        } else {
-            // Fallback: look for common texture naming convention
-            texturePath = m_AssetPath + "/textures/" + pathFragment + "_Body_Mat_baseColor.png";
-            ARV_LOG_INFO("ObjAssetRO: Using fallback texture: {}", texturePath);
+                // Ranges index the shared buffer holding all LODs
+                uint32_t firstIndex = submesh.firstIndex;
+                std::shared_ptr<Texture2D> diffuse = materialTexture(submesh.materialIndex);
+                if (!draws.empty() && draws.back().texture == diffuse &&
+                    draws.back().range.firstIndex + draws.back().range.indexCount == firstIndex) {
+                    draws.back().range.indexCount += submesh.indexCount;
+                } else {
+                    draws.push_back({{firstIndex, submesh.indexCount}, diffuse});
+                }
+            }
         }
 
-        m_Texture = app->GetRenderer()->CreateTexture2D(texturePath);
+        bool hasDraws = !submeshDraws.empty() && !submeshDraws[0].empty();
+        texture = hasDraws ? submeshDraws[0][0].texture : loadTexture(fallbackPath);
+        ARV_LOG_INFO("ObjAssetRO: {} materials, {} textures, {} draws at LOD 0",
+                     materialTextures.size(), texturesByPath.size(), hasDraws ? submeshDraws[0].size() : 0);
+    }
+
+    ObjAssetRO::ObjAssetRO(const std::string& pathFragment, VertexFormat vertexFormat)
+        : m_VertexFormat(vertexFormat) {
+
+        // Copies of an asset share one load; the cache drops it with the last copy
+        std::string assetPath = AssetPath::Resolve("objects/" + pathFragment);
+        std::string key = ResourceCache::MakeKey("ObjAsset", assetPath, vertexFormat == VertexFormat::Quantized ? "quantized" : "float");
+        m_Asset = ResourceCache::Global().GetOrCreate<MeshAsset>(key, [&]() {
+            auto asset = std::make_shared<MeshAsset>();
+            asset->assetPath = assetPath;
+            asset->vertexFormat = vertexFormat;
+            asset->Load(pathFragment);
+            return asset;
+        });
+
+        m_boundsMin = m_Asset->mesh.GetBoundsMin();
+        m_boundsMax = m_Asset->mesh.GetBoundsMax();
+        m_uniforms = m_Asset->uniforms;
+    }
+
+    void ObjAssetRO::SaveCustomProperties(nlohmann::json& j) const {
+        j["vertexFormat"] = m_VertexFormat == VertexFormat::Quantized ? "quantized" : "float";
+    }
+
+    const TriangleMesh* ObjAssetRO::GetPickingMesh() const {
+        MeshAsset& asset = *m_Asset;
+        if (!asset.pickingMeshBuilt) {
+            asset.pickingMeshBuilt = true;
+            auto pickingStart = std::chrono::steady_clock::now();
+            asset.pickingMesh.Build(asset.mesh.GetVertices(), CookedMesh::VertexStride, asset.mesh.GetVertexCount(),
+                                    asset.mesh.GetIndices(), asset.mesh.GetIndexCount());
+            ARV_LOG_INFO("ObjAssetRO: Built picking mesh of {} triangles in {:.1f} ms",
+                         asset.pickingMesh.GetTriangleCount(), MillisecondsSince(pickingStart));
+        }
+        return asset.pickingMesh.IsEmpty() ? nullptr : &asset.pickingMesh;
     }
 
     std::shared_ptr<Shader>& ObjAssetRO::GetShader() {
-        return m_Shader;
+        return m_Asset->shader;
     }
 
     std::shared_ptr<VertexArray>& ObjAssetRO::GetVertexArray() {
-        return m_VertexArray;
+        return m_Asset->vertexArray;
+    }
+
+    std::shared_ptr<Texture2D> ObjAssetRO::GetTexture() {
+        return m_Asset->texture;
+    }
+
+    uint32_t ObjAssetRO::GetLodCount() const {
+        return m_Asset->vertexArray ? m_Asset->mesh.GetLodCount() : 0;
+    }
+
+    float ObjAssetRO::GetLodError(uint32_t lod) const {
+        return m_Asset->mesh.GetLod(lod).error;
+    }
+
+    IndexRange ObjAssetRO::GetLodRange(uint32_t lod) const {
+        if (lod >= GetLodCount()) {
+            return IndexRange();
+        }
+        const MeshLod& range = m_Asset->mesh.GetLod(lod);
+        return {range.firstIndex, range.indexCount};
+    }
+
+    const std::vector<SubmeshDraw>& ObjAssetRO::GetSubmeshDraws(uint32_t lod) const {
+        const auto& submeshDraws = m_Asset->submeshDraws;
+        return lod < submeshDraws.size() ? submeshDraws[lod] : RenderingObject::GetSubmeshDraws(lod);
     }
 
 }
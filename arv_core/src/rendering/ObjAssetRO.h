@@ -1,7 +1,7 @@
 #pragma once
 
 #include "RenderingObject.h"
-#include "CoreShaderSource.h"
+#include "CookedMesh.h"
 #include "rendering/Texture.h"
 #include <glm/glm.hpp>
 #include <memory>
@@ -13,20 +13,53 @@ namespace arv {
     class ObjAssetRO : public RenderingObject {
 
     public:
+        // Float: 32 bytes per vertex. Quantized: 16 bytes per vertex (see QuantizedVertex),
+        // on backends that support 16-bit vertex types; others fall back to Float.
+        enum class VertexFormat { Float, Quantized };
+
         // pathFragment is the folder name inside assets/objects/, e.g. "SMG"
-        ObjAssetRO(const std::string& pathFragment);
+        ObjAssetRO(const std::string& pathFragment, VertexFormat vertexFormat = VertexFormat::Float);
 
         std::shared_ptr<Shader>& GetShader() override;
         std::shared_ptr<VertexArray>& GetVertexArray() override;
-        std::shared_ptr<Texture2D> GetTexture() override { return m_Texture; }
+        std::shared_ptr<Texture2D> GetTexture() override;
+        // LODs are generated when the OBJ is cooked and stored in the .arvmesh cache
+        uint32_t GetLodCount() const override;
+        float GetLodError(uint32_t lod) const override;
+        // All LODs are ranges of one index buffer, drawn with the vertex array
+        IndexRange GetLodRange(uint32_t lod) const override;
+        // One draw per material, all ranges of the asset's vertex and index buffer
+        const std::vector<SubmeshDraw>& GetSubmeshDraws(uint32_t lod) const override;
+        // Built on first use from the mesh data, which stays mapped from the .arvmesh cache
+        const TriangleMesh* GetPickingMesh() const override;
+
+        void SaveCustomProperties(nlohmann::json& j) const override;
 
     private:
-        std::unique_ptr<CoreShaderSource> m_ShaderSource;
-        std::shared_ptr<Shader> m_Shader;
-        std::shared_ptr<VertexArray> m_VertexArray;
-        std::shared_ptr<Texture2D> m_Texture;
+        // Everything loaded for one asset. Objects created with the same path and
+        // vertex format share one through the ResourceCache; only the transform,
+        // LOD state and uniform values are per object.
+        struct MeshAsset {
+            std::string assetPath;
+            VertexFormat vertexFormat = VertexFormat::Float;
+            CookedMesh mesh;
+            std::shared_ptr<Shader> shader;  // From the ShaderLibrary, shared with other assets
+            UniformSet uniforms;             // Dequantization of quantized meshes, copied to each object
+            std::shared_ptr<VertexArray> vertexArray;  // Indices of all LODs, see GetLodRange()
+            std::shared_ptr<Texture2D> texture;  // Texture of the first material
+            std::vector<std::vector<SubmeshDraw>> submeshDraws;  // Per LOD
+            TriangleMesh pickingMesh;
+            bool pickingMeshBuilt = false;
+
+            void Load(const std::string& pathFragment);
+            // Parses the OBJ into mesh and writes the .arvmesh cache next to it
+            bool CookObj(const std::string& objPath, const std::string& cachePath);
+            // Loads each distinct material texture once and builds submeshDraws
+            void LoadMaterials(const std::string& pathFragment);
+        };
 
-        std::string m_AssetPath;
+        std::shared_ptr<MeshAsset> m_Asset;
+        VertexFormat m_VertexFormat;
     };
 
 }
@@ -0,0 +1,677 @@
+#include "ObjParser.h"
+#include "ARVBase.h"
+#include "utils/MappedFile.h"
+#include "utils/ThreadPool.h"
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include "tiny_obj_loader.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace arv {
+
+    namespace {
+
+        constexpr size_t MinChunkBytes = 1 << 20;
+        constexpr uint32_t ShardBits = 6;
+        constexpr uint32_t ShardCount = 1u << ShardBits;
+        constexpr int32_t MissingIndex = -1;
+
+        // Zero-based position/texcoord/normal indices of one face corner
+        struct Corner {
+            int32_t position;
+            int32_t texcoord;
+            int32_t normal;
+        };
+
+        // o/g (starts a submesh) or usemtl (starts a submesh with another material)
+        struct GroupEvent {
+            uint32_t corner;
+            bool isMaterial;
+            std::string name;
+        };
+
+        struct Chunk {
+            const char* begin = nullptr;
+            const char* end = nullptr;
+
+            std::vector<float> positions;
+            std::vector<float> texcoords;
+            std::vector<float> normals;
+            std::vector<Corner> corners;
+            // corner * 3 + component of negative indices, which were resolved
+            // against this chunk's own counts and still need the chunk's offsets
+            std::vector<uint32_t> relativeSlots;
+            std::vector<GroupEvent> events;
+            std::string materialLibrary;
+            std::vector<Corner> polygon;
+            bool failed = false;
+
+            uint32_t firstPosition = 0;
+            uint32_t firstTexcoord = 0;
+            uint32_t firstNormal = 0;
+            uint32_t firstCorner = 0;
+        };
+
+        // Open-addressing (linear probing) map from an OBJ position/texcoord/normal
+        // index triple to a vertex index. Keys are stored inline, so lookups don't
+        // allocate; the table doubles when it is 70% full.
+        class VertexKeyTable {
+        public:
+            explicit VertexKeyTable(size_t expectedCount) {
+                size_t capacity = 16;
+                while (capacity * 7 < expectedCount * 10) {
+                    capacity *= 2;
+                }
+                m_Slots.resize(capacity);
+            }
+
+            // Returns the vertex of the triple, inserting newVertex if it isn't known yet
+            uint32_t FindOrInsert(const Corner& key, uint32_t newVertex) {
+                if ((m_Count + 1) * 10 > m_Slots.size() * 7) {
+                    Grow();
+                }
+
+                size_t mask = m_Slots.size() - 1;
+                for (size_t i = Hash(key) & mask;; i = (i + 1) & mask) {
+                    Slot& slot = m_Slots[i];
+                    if (slot.vertex == EmptySlot) {
+                        slot = {key, newVertex};
+                        m_Count++;
+                        return newVertex;
+                    }
+                    if (slot.key.position == key.position && slot.key.texcoord == key.texcoord && slot.key.normal == key.normal) {
+                        return slot.vertex;
+                    }
+                }
+            }
+
+            static uint32_t Hash(const Corner& key) {
+                uint32_t h = static_cast<uint32_t>(key.position) * 0x9E3779B1u;
+                h ^= static_cast<uint32_t>(key.texcoord) * 0x85EBCA77u;
+                h ^= static_cast<uint32_t>(key.normal) * 0xC2B2AE3Du;
+                h ^= h >> 16;
+                h *= 0x7FEB352Du;
+                h ^= h >> 15;
+                return h;
+            }
+
+        private:
+            static constexpr uint32_t EmptySlot = ~0u;
+
+            struct Slot {
+                Corner key = {0, 0, 0};
+                uint32_t vertex = EmptySlot;
+            };
+
+            void Grow() {
+                std::vector<Slot> old(m_Slots.size() * 2);
+                old.swap(m_Slots);
+                size_t mask = m_Slots.size() - 1;
+                for (const Slot& slot : old) {
+                    if (slot.vertex == EmptySlot) {
+                        continue;
+                    }
+                    size_t i = Hash(slot.key) & mask;
+                    while (m_Slots[i].vertex != EmptySlot) {
+                        i = (i + 1) & mask;
+                    }
+                    m_Slots[i] = slot;
+                }
+            }
+
+            std::vector<Slot> m_Slots;
+            size_t m_Count = 0;
+        };
+
+        uint32_t ShardOf(const Corner& corner) {
+            return VertexKeyTable::Hash(corner) >> (32 - ShardBits);
+        }
+
+        bool IsSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        bool IsDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        const char* SkipSpaces(const char* p, const char* end) {
+            while (p < end && IsSpace(*p)) {
+                p++;
+            }
+            return p;
+        }
+
+        // Keyword followed by whitespace, e.g. "vt " but not "vtx"
+        bool MatchKeyword(const char* p, const char* end, const char* keyword) {
+            size_t length = std::strlen(keyword);
+            return static_cast<size_t>(end - p) > length && std::memcmp(p, keyword, length) == 0 && IsSpace(p[length]);
+        }
+
+        std::string ReadName(const char* p, const char* end) {
+            p = SkipSpaces(p, end);
+            while (end > p && IsSpace(end[-1])) {
+                end--;
+            }
+            return std::string(p, end);
+        }
+
+        // Decimal float without strtod's locale lookup. The first 19 significant
+        // digits are accumulated exactly and scaled once by a power of ten in
+        // double precision, which is exact to well below float precision.
+        float ParseFloat(const char*& p, const char* end) {
+            static constexpr double PowersOf10[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            p = SkipSpaces(p, end);
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                negative = *p == '-';
+                p++;
+            }
+
+            uint64_t mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+            for (; p < end && IsDigit(*p); p++) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    digits += mantissa != 0;
+                } else {
+                    exponent++;
+                }
+            }
+            if (p < end && *p == '.') {
+                for (p++; p < end && IsDigit(*p); p++) {
+                    if (digits < 19) {
+                        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                        digits += mantissa != 0;
+                        exponent--;
+                    }
+                }
+            }
+            if (p < end && (*p == 'e' || *p == 'E')) {
+                p++;
+                bool negativeExponent = false;
+                if (p < end && (*p == '-' || *p == '+')) {
+                    negativeExponent = *p == '-';
+                    p++;
+                }
+                int value = 0;
+                for (; p < end && IsDigit(*p); p++) {
+                    value = std::min(value * 10 + (*p - '0'), 100000);
+                }
+                exponent += negativeExponent ? -value : value;
+            }
+
+            double result = static_cast<double>(mantissa);
+            if (mantissa != 0) {
+                for (; exponent > 22; exponent -= 22) {
+                    result *= 1e22;
+                }
+                for (; exponent < -22; exponent += 22) {
+                    result /= 1e22;
+                }
+                result = exponent < 0 ? result / PowersOf10[-exponent] : result * PowersOf10[exponent];
+            }
+            return static_cast<float>(negative ? -result : result);
+        }
+
+        bool ParseInt(const char*& p, const char* end, int32_t& out) {
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                negative = *p == '-';
+                p++;
+            }
+            if (p >= end || !IsDigit(*p)) {
+                return false;
+            }
+            int64_t value = 0;
+            for (; p < end && IsDigit(*p); p++) {
+                value = std::min<int64_t>(value * 10 + (*p - '0'), INT32_MAX);
+            }
+            out = static_cast<int32_t>(negative ? -value : value);
+            return true;
+        }
+
+        // Turns a one-based or negative OBJ index into a zero-based one. Negative
+        // indices are resolved against the chunk-local count and recorded so the
+        // chunk's offset can be added later.
+        bool ResolveIndex(int32_t raw, size_t localCount, Chunk& chunk, uint32_t component, int32_t& out) {
+            if (raw > 0) {
+                out = raw - 1;
+                return true;
+            }
+            if (raw < 0) {
+                out = static_cast<int32_t>(localCount) + raw;
+                chunk.relativeSlots.push_back(static_cast<uint32_t>(chunk.corners.size() + chunk.polygon.size()) * 3 + component);
+                return true;
+            }
+            return false;
+        }
+
+        void ParseFace(const char* p, const char* end, Chunk& chunk) {
+            chunk.polygon.clear();
+            while (true) {
+                p = SkipSpaces(p, end);
+                if (p >= end) {
+                    break;
+                }
+
+                Corner corner = {MissingIndex, MissingIndex, MissingIndex};
+                int32_t raw = 0;
+                if (!ParseInt(p, end, raw) || !ResolveIndex(raw, chunk.positions.size() / 3, chunk, 0, corner.position)) {
+                    chunk.failed = true;
+                    return;
+                }
+                if (p < end && *p == '/') {
+                    p++;
+                    if (ParseInt(p, end, raw) && !ResolveIndex(raw, chunk.texcoords.size() / 2, chunk, 1, corner.texcoord)) {
+                        chunk.failed = true;
+                        return;
+                    }
+                    if (p < end && *p == '/') {
+                        p++;
+                        if (ParseInt(p, end, raw) && !ResolveIndex(raw, chunk.normals.size() / 3, chunk, 2, corner.normal)) {
+                            chunk.failed = true;
+                            return;
+                        }
+                    }
+                }
+                chunk.polygon.push_back(corner);
+
+                while (p < end && !IsSpace(*p)) {
+                    p++;
+                }
+            }
+
+            // Fan triangulation; relative slots were numbered as if the polygon
+            // were appended as is, so renumber them for the duplicated corners
+            size_t cornerCount = chunk.polygon.size();
+            if (cornerCount == 3) {
+                chunk.corners.insert(chunk.corners.end(), chunk.polygon.begin(), chunk.polygon.end());
+                return;
+            }
+
+            uint32_t base = static_cast<uint32_t>(chunk.corners.size());
+            std::vector<uint32_t> polygonSlots;
+            while (!chunk.relativeSlots.empty() && chunk.relativeSlots.back() >= base * 3) {
+                polygonSlots.push_back(chunk.relativeSlots.back() - base * 3);
+                chunk.relativeSlots.pop_back();
+            }
+            // Points and lines (fewer than 3 corners) produce no triangles
+            for (size_t i = 2; i < cornerCount; i++) {
+                const size_t fan[3] = {0, i - 1, i};
+                for (size_t k = 0; k < 3; k++) {
+                    for (uint32_t slot : polygonSlots) {
+                        if (slot / 3 == fan[k]) {
+                            chunk.relativeSlots.push_back(static_cast<uint32_t>(chunk.corners.size()) * 3 + slot % 3);
+                        }
+                    }
+                    chunk.corners.push_back(chunk.polygon[fan[k]]);
+                }
+            }
+        }
+
+        void ParseLine(const char* p, const char* end, Chunk& chunk) {
+            p = SkipSpaces(p, end);
+            if (p >= end) {
+                return;
+            }
+
+            switch (*p) {
+                case 'v':
+                    if (MatchKeyword(p, end, "v")) {
+                        p += 1;
+                        chunk.positions.push_back(ParseFloat(p, end));
+                        chunk.positions.push_back(ParseFloat(p, end));
+                        chunk.positions.push_back(ParseFloat(p, end));
+                    } else if (MatchKeyword(p, end, "vt")) {
+                        p += 2;
+                        chunk.texcoords.push_back(ParseFloat(p, end));
+                        chunk.texcoords.push_back(ParseFloat(p, end));
+                    } else if (MatchKeyword(p, end, "vn")) {
+                        p += 2;
+                        chunk.normals.push_back(ParseFloat(p, end));
+                        chunk.normals.push_back(ParseFloat(p, end));
+                        chunk.normals.push_back(ParseFloat(p, end));
+                    }
+                    break;
+                case 'f':
+                    if (MatchKeyword(p, end, "f")) {
+                        ParseFace(p + 1, end, chunk);
+                    }
+                    break;
+                case 'o':
+                case 'g':
+                    if (p + 1 == end || IsSpace(p[1])) {
+                        chunk.events.push_back({static_cast<uint32_t>(chunk.corners.size()), false, ReadName(p + 1, end)});
+                    }
+                    break;
+                case 'u':
+                    if (MatchKeyword(p, end, "usemtl")) {
+                        chunk.events.push_back({static_cast<uint32_t>(chunk.corners.size()), true, ReadName(p + 6, end)});
+                    }
+                    break;
+                case 'm':
+                    if (MatchKeyword(p, end, "mtllib") && chunk.materialLibrary.empty()) {
+                        chunk.materialLibrary = ReadName(p + 6, end);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void ParseChunk(Chunk& chunk) {
+            const char* p = chunk.begin;
+            while (p < chunk.end && !chunk.failed) {
+                const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', chunk.end - p));
+                if (!lineEnd) {
+                    lineEnd = chunk.end;
+                }
+                ParseLine(p, lineEnd, chunk);
+                p = lineEnd + 1;
+            }
+        }
+
+        template<typename T>
+        void Release(std::vector<T>& vector) {
+            std::vector<T>().swap(vector);
+        }
+
+        // Reorders the index buffer so each material's triangles are one
+        // contiguous submesh, materials in ascending order (untextured first).
+        // Submeshes of one material keep their file order.
+        void GroupSubmeshesByMaterial(std::vector<uint32_t>& indices, std::vector<MeshSubmesh>& submeshes) {
+            std::vector<MeshSubmesh> sorted = submeshes;
+            std::stable_sort(sorted.begin(), sorted.end(), [](const MeshSubmesh& a, const MeshSubmesh& b) {
+                return a.materialIndex < b.materialIndex;
+            });
+
+            std::vector<uint32_t> grouped;
+            grouped.reserve(indices.size());
+            std::vector<MeshSubmesh> merged;
+            for (const MeshSubmesh& submesh : sorted) {
+                if (merged.empty() || merged.back().materialIndex != submesh.materialIndex) {
+                    merged.push_back({static_cast<uint32_t>(grouped.size()), 0, submesh.materialIndex});
+                }
+                grouped.insert(grouped.end(), indices.begin() + submesh.firstIndex,
+                               indices.begin() + submesh.firstIndex + submesh.indexCount);
+                merged.back().indexCount += submesh.indexCount;
+            }
+
+            indices = std::move(grouped);
+            submeshes = std::move(merged);
+        }
+
+    }
+
+    bool ObjParser::Parse(const std::string& path, ObjMeshData& outMesh) {
+        return Parse(path, outMesh, ThreadPool::Global());
+    }
+
+    bool ObjParser::Parse(const std::string& path, ObjMeshData& outMesh, ThreadPool& pool) {
+        MappedFile file;
+        if (!file.Open(path)) {
+            ARV_LOG_ERROR("ObjParser::Parse() - Cannot open {}", path);
+            return false;
+        }
+
+        const char* data = reinterpret_cast<const char*>(file.GetData());
+        const char* dataEnd = data + file.GetSize();
+
+        // Line-aligned chunks, several per worker so uneven chunks balance out
+        size_t chunkCount = std::clamp<size_t>(file.GetSize() / MinChunkBytes, 1, (pool.GetThreadCount() + 1) * 8);
+        std::vector<Chunk> chunks(chunkCount);
+        const char* chunkBegin = data;
+        for (size_t i = 0; i < chunkCount; i++) {
+            const char* chunkEnd = dataEnd;
+            if (i + 1 < chunkCount) {
+                chunkEnd = std::max(chunkBegin, data + file.GetSize() * (i + 1) / chunkCount);
+                const char* newline = static_cast<const char*>(std::memchr(chunkEnd, '\n', dataEnd - chunkEnd));
+                chunkEnd = newline ? newline + 1 : dataEnd;
+            }
+            chunks[i].begin = chunkBegin;
+            chunks[i].end = chunkEnd;
+            chunkBegin = chunkEnd;
+        }
+
+        pool.ParallelFor(static_cast<uint32_t>(chunkCount), [&chunks](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                ParseChunk(chunks[i]);
+            }
+        });
+
+        // Offsets of each chunk in the merged arrays
+        uint64_t positionCount = 0;
+        uint64_t texcoordCount = 0;
+        uint64_t normalCount = 0;
+        uint64_t cornerCount = 0;
+        std::string materialLibrary;
+        for (Chunk& chunk : chunks) {
+            if (chunk.failed) {
+                ARV_LOG_ERROR("ObjParser::Parse() - Malformed face in {}", path);
+                return false;
+            }
+            chunk.firstPosition = static_cast<uint32_t>(positionCount);
+            chunk.firstTexcoord = static_cast<uint32_t>(texcoordCount);
+            chunk.firstNormal = static_cast<uint32_t>(normalCount);
+            chunk.firstCorner = static_cast<uint32_t>(cornerCount);
+            positionCount += chunk.positions.size() / 3;
+            texcoordCount += chunk.texcoords.size() / 2;
+            normalCount += chunk.normals.size() / 3;
+            cornerCount += chunk.corners.size();
+            if (materialLibrary.empty()) {
+                materialLibrary = chunk.materialLibrary;
+            }
+        }
+
+        if (cornerCount >= UINT32_MAX || positionCount >= INT32_MAX) {
+            ARV_LOG_ERROR("ObjParser::Parse() - {} is too large for 32-bit indices", path);
+            return false;
+        }
+
+        // Merge attributes and corners, resolving relative and out-of-range indices
+        std::vector<float> positions(positionCount * 3);
+        std::vector<float> texcoords(texcoordCount * 2);
+        std::vector<float> normals(normalCount * 3);
+        std::vector<Corner> corners(cornerCount);
+        std::atomic<bool> badIndex{false};
+
+        pool.ParallelFor(static_cast<uint32_t>(chunkCount), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                Chunk& chunk = chunks[i];
+                const int32_t offsets[3] = {
+                    static_cast<int32_t>(chunk.firstPosition),
+                    static_cast<int32_t>(chunk.firstTexcoord),
+                    static_cast<int32_t>(chunk.firstNormal)
+                };
+                for (uint32_t slot : chunk.relativeSlots) {
+                    Corner& corner = chunk.corners[slot / 3];
+                    int32_t* components[3] = {&corner.position, &corner.texcoord, &corner.normal};
+                    *components[slot % 3] += offsets[slot % 3];
+                }
+
+                for (Corner& corner : chunk.corners) {
+                    if (corner.position < 0 || corner.position >= static_cast<int32_t>(positionCount)) {
+                        badIndex = true;
+                        corner.position = 0;
+                    }
+                    if (corner.texcoord >= static_cast<int32_t>(texcoordCount) || corner.texcoord < 0) {
+                        corner.texcoord = MissingIndex;
+                    }
+                    if (corner.normal >= static_cast<int32_t>(normalCount) || corner.normal < 0) {
+                        corner.normal = MissingIndex;
+                    }
+                }
+
+                std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + size_t(chunk.firstPosition) * 3);
+                std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), texcoords.begin() + size_t(chunk.firstTexcoord) * 2);
+                std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + size_t(chunk.firstNormal) * 3);
+                std::copy(chunk.corners.begin(), chunk.corners.end(), corners.begin() + chunk.firstCorner);
+                Release(chunk.positions);
+                Release(chunk.texcoords);
+                Release(chunk.normals);
+                Release(chunk.corners);
+                Release(chunk.relativeSlots);
+            }
+        });
+
+        if (badIndex) {
+            ARV_LOG_ERROR("ObjParser::Parse() - Face references a missing position in {}", path);
+            return false;
+        }
+
+        // Deduplicate in shards: every corner is scattered to the shard of its
+        // key's hash, in corner order, so each shard can find the first use of
+        // every key on its own
+        std::vector<std::array<uint32_t, ShardCount>> shardOffsets(chunkCount);
+        pool.ParallelFor(static_cast<uint32_t>(chunkCount), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                std::array<uint32_t, ShardCount>& counts = shardOffsets[i];
+                counts.fill(0);
+                uint32_t cornerEnd = i + 1 < chunkCount ? chunks[i + 1].firstCorner : static_cast<uint32_t>(cornerCount);
+                for (uint32_t c = chunks[i].firstCorner; c < cornerEnd; c++) {
+                    counts[ShardOf(corners[c])]++;
+                }
+            }
+        });
+
+        std::array<uint32_t, ShardCount + 1> shardStart = {};
+        uint32_t running = 0;
+        for (uint32_t shard = 0; shard < ShardCount; shard++) {
+            shardStart[shard] = running;
+            for (auto& offsets : shardOffsets) {
+                uint32_t count = offsets[shard];
+                offsets[shard] = running;
+                running += count;
+            }
+        }
+        shardStart[ShardCount] = running;
+
+        std::vector<uint32_t> shardCorners(cornerCount);
+        pool.ParallelFor(static_cast<uint32_t>(chunkCount), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                std::array<uint32_t, ShardCount>& offsets = shardOffsets[i];
+                uint32_t cornerEnd = i + 1 < chunkCount ? chunks[i + 1].firstCorner : static_cast<uint32_t>(cornerCount);
+                for (uint32_t c = chunks[i].firstCorner; c < cornerEnd; c++) {
+                    shardCorners[offsets[ShardOf(corners[c])]++] = c;
+                }
+            }
+        });
+
+        // firstUse[c] is the first corner with the same key as c
+        std::vector<uint32_t> firstUse(cornerCount);
+        pool.ParallelFor(ShardCount, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t shard = begin; shard < end; shard++) {
+                // Closed triangle meshes have about one unique vertex per six corners
+                VertexKeyTable table((shardStart[shard + 1] - shardStart[shard]) / 6);
+                for (uint32_t i = shardStart[shard]; i < shardStart[shard + 1]; i++) {
+                    uint32_t c = shardCorners[i];
+                    firstUse[c] = table.FindOrInsert(corners[c], c);
+                }
+            }
+        });
+        Release(shardCorners);
+
+        // Number vertices in order of first use; firstUse becomes the index buffer
+        std::vector<uint32_t> uniqueCorners;
+        uniqueCorners.reserve(cornerCount / 4);
+        for (uint32_t c = 0; c < cornerCount; c++) {
+            uint32_t first = firstUse[c];
+            if (first == c) {
+                firstUse[c] = static_cast<uint32_t>(uniqueCorners.size());
+                uniqueCorners.push_back(c);
+            } else {
+                firstUse[c] = firstUse[first];
+            }
+        }
+
+        // Build interleaved vertex data: position (3) + texcoord (2) + normal (3) = 8 floats per vertex
+        std::vector<float> vertices(uniqueCorners.size() * CookedMesh::VertexStride);
+        pool.ParallelFor(static_cast<uint32_t>(uniqueCorners.size()), [&](uint32_t begin, uint32_t end) {
+            for (uint32_t v = begin; v < end; v++) {
+                const Corner& corner = corners[uniqueCorners[v]];
+                float* vertex = &vertices[size_t(v) * CookedMesh::VertexStride];
+                std::memcpy(vertex, &positions[size_t(corner.position) * 3], 3 * sizeof(float));
+                if (corner.texcoord >= 0) {
+                    std::memcpy(vertex + 3, &texcoords[size_t(corner.texcoord) * 2], 2 * sizeof(float));
+                } else {
+                    vertex[3] = 0.0f;
+                    vertex[4] = 0.0f;
+                }
+                if (corner.normal >= 0) {
+                    std::memcpy(vertex + 5, &normals[size_t(corner.normal) * 3], 3 * sizeof(float));
+                } else {
+                    vertex[5] = 0.0f;
+                    vertex[6] = 1.0f;
+                    vertex[7] = 0.0f;
+                }
+            }
+        }, 4096);
+
+        // Materials
+        std::map<std::string, int> materialMap;
+        std::vector<tinyobj::material_t> materials;
+        if (!materialLibrary.empty()) {
+            std::string directory = path.substr(0, path.find_last_of('/') + 1);
+            std::ifstream materialStream(directory + materialLibrary);
+            if (materialStream) {
+                std::string warn, err;
+                tinyobj::LoadMtl(&materialMap, &materials, &materialStream, &warn, &err);
+                if (!warn.empty()) {
+                    ARV_LOG_WARN("ObjParser::Parse() - {}", warn);
+                }
+                if (!err.empty()) {
+                    ARV_LOG_ERROR("ObjParser::Parse() - {}", err);
+                }
+            } else {
+                ARV_LOG_WARN("ObjParser::Parse() - Material library {} not found", directory + materialLibrary);
+            }
+        }
+
+        // Submeshes start at every o/g and usemtl; empty ones are dropped
+        outMesh.submeshes.clear();
+        int32_t material = -1;
+        uint32_t submeshStart = 0;
+        auto closeSubmesh = [&](uint32_t end) {
+            if (end > submeshStart) {
+                outMesh.submeshes.push_back({submeshStart, end - submeshStart, material});
+            }
+            submeshStart = end;
+        };
+        for (const Chunk& chunk : chunks) {
+            for (const GroupEvent& event : chunk.events) {
+                closeSubmesh(chunk.firstCorner + event.corner);
+                if (event.isMaterial) {
+                    auto it = materialMap.find(event.name);
+                    material = it != materialMap.end() ? it->second : -1;
+                }
+            }
+        }
+        closeSubmesh(static_cast<uint32_t>(cornerCount));
+        GroupSubmeshesByMaterial(firstUse, outMesh.submeshes);
+
+        outMesh.materialTextures.clear();
+        for (const auto& entry : materials) {
+            outMesh.materialTextures.push_back(entry.diffuse_texname);
+        }
+
+        outMesh.vertices = std::move(vertices);
+        outMesh.indices = std::move(firstUse);
+        outMesh.positionCount = static_cast<uint32_t>(positionCount);
+        outMesh.texcoordCount = static_cast<uint32_t>(texcoordCount);
+        outMesh.normalCount = static_cast<uint32_t>(normalCount);
+        return true;
+    }
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CookedMesh.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    class ThreadPool;
+
+    // OBJ contents in the interleaved layout of CookedMesh: position (3),
+    // texcoord (2), normal (3) per vertex, one vertex per unique
+    // position/texcoord/normal combination, in order of first use.
+    struct ObjMeshData {
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<MeshSubmesh> submeshes;         // One per material, in material order
+        std::vector<std::string> materialTextures;  // Diffuse texture of each .mtl material
+        uint32_t positionCount = 0;
+        uint32_t texcoordCount = 0;
+        uint32_t normalCount = 0;
+    };
+
+    /**
+     * Multithreaded OBJ reader.
+     *
+     * The file is memory-mapped and split into line-aligned chunks that are
+     * parsed in parallel, with a locale-free number parser. Chunks only know
+     * their local attribute counts, so relative (negative) indices are
+     * resolved once the counts of the preceding chunks are known. Vertices
+     * are then deduplicated in hash-partitioned shards, one shard per task,
+     * and renumbered in order of first use so the result matches a serial
+     * parse exactly.
+     *
+     * Supports v, vt, vn, f (polygons are fan-triangulated), o, g, usemtl and
+     * mtllib; the .mtl itself is read with tinyobjloader. Faces are grouped by
+     * material, so every material is a single range of the index buffer.
+     */
+    class ObjParser {
+    public:
+        static bool Parse(const std::string& path, ObjMeshData& outMesh);
+        static bool Parse(const std::string& path, ObjMeshData& outMesh, ThreadPool& pool);
+    };
+
+}
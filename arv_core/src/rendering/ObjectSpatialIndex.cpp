@@ -0,0 +1,157 @@
+#include "ObjectSpatialIndex.h"
+#include "ARVBase.h"
+#include "../math/TransformBatch.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace arv {
+
+    ObjectSpatialIndex::~ObjectSpatialIndex()
+    {
+        Clear();
+    }
+
+    AABB ObjectSpatialIndex::ComputeWorldBounds(const RenderingObject& object)
+    {
+        glm::mat4 model = ComposeModelMatrix(object.GetPosition(), object.GetRotation(), object.GetScale());
+        glm::vec3 center, extents;
+        TransformBounds(model, object.GetBoundsMin(), object.GetBoundsMax(), center, extents);
+        return AABB(center - extents, center + extents);
+    }
+
+    void ObjectSpatialIndex::Add(RenderingObject& object)
+    {
+        if (m_Proxies.count(&object) > 0)
+        {
+            ARV_LOG_WARN("ObjectSpatialIndex::Add() - Object '{}' is already indexed", object.GetName());
+            return;
+        }
+
+        int32_t proxy = UnboundedProxy;
+        if (object.GetBoundsMin() != object.GetBoundsMax())
+        {
+            proxy = m_Tree.CreateProxy(ComputeWorldBounds(object), &object);
+        }
+        else
+        {
+            m_Unbounded.push_back(&object);
+        }
+        m_Proxies[&object] = proxy;
+
+        object.SetTransformListener([this](RenderingObject& changed) { Update(changed); });
+    }
+
+    void ObjectSpatialIndex::Remove(RenderingObject& object)
+    {
+        auto it = m_Proxies.find(&object);
+        if (it == m_Proxies.end())
+        {
+            return;
+        }
+
+        if (it->second == UnboundedProxy)
+        {
+            m_Unbounded.erase(std::remove(m_Unbounded.begin(), m_Unbounded.end(), &object), m_Unbounded.end());
+        }
+        else
+        {
+            m_Tree.DestroyProxy(it->second);
+        }
+        m_Proxies.erase(it);
+        object.SetTransformListener(nullptr);
+    }
+
+    void ObjectSpatialIndex::Update(RenderingObject& object)
+    {
+        auto it = m_Proxies.find(&object);
+        if (it == m_Proxies.end() || it->second == UnboundedProxy)
+        {
+            return;
+        }
+        m_Tree.MoveProxy(it->second, ComputeWorldBounds(object));
+    }
+
+    void ObjectSpatialIndex::Rebuild(const std::vector<std::unique_ptr<RenderingObject>>& objects)
+    {
+        Clear();
+        m_Proxies.reserve(objects.size());
+        for (const auto& object : objects)
+        {
+            Add(*object);
+        }
+        ARV_LOG_INFO("ObjectSpatialIndex::Rebuild() - Indexed {} objects, tree height {}", objects.size(), m_Tree.GetHeight());
+    }
+
+    void ObjectSpatialIndex::Clear()
+    {
+        for (auto& [object, proxy] : m_Proxies)
+        {
+            object->SetTransformListener(nullptr);
+        }
+        m_Proxies.clear();
+        m_Unbounded.clear();
+        m_Tree.Clear();
+    }
+
+    void ObjectSpatialIndex::AppendResults(std::vector<RenderingObject*>& outObjects) const
+    {
+        outObjects.insert(outObjects.end(), m_Unbounded.begin(), m_Unbounded.end());
+        for (void* userData : m_Results)
+        {
+            outObjects.push_back(static_cast<RenderingObject*>(userData));
+        }
+    }
+
+    void ObjectSpatialIndex::QueryFrustum(const Frustum& frustum, std::vector<RenderingObject*>& outObjects) const
+    {
+        m_Results.clear();
+        m_Tree.QueryFrustum(frustum, m_Results);
+        AppendResults(outObjects);
+    }
+
+    void ObjectSpatialIndex::QueryOverlap(const AABB& bounds, std::vector<RenderingObject*>& outObjects) const
+    {
+        m_Results.clear();
+        m_Tree.QueryOverlap(bounds, m_Results);
+        AppendResults(outObjects);
+    }
+
+    RenderingObject* ObjectSpatialIndex::Pick(const Ray& ray, float* outDistance) const
+    {
+        RenderingObject* closestObject = nullptr;
+        float closest = std::numeric_limits<float>::max();
+
+        QueryRay(ray.origin, ray.direction, closest, [&](RenderingObject& object, float entryDistance) {
+            float distance = entryDistance;
+            if (const TriangleMesh* mesh = object.GetPickingMesh())
+            {
+                // The model matrix is affine, so the distance along the local ray is the same
+                glm::mat4 inverseModel = glm::inverse(ComposeModelMatrix(object.GetPosition(), object.GetRotation(), object.GetScale()));
+                Ray localRay = ray.Transformed(inverseModel);
+                if (!mesh->Raycast(localRay.origin, localRay.direction, closest, distance))
+                {
+                    return closest;
+                }
+            }
+            else if (object.GetBoundsMin() == object.GetBoundsMax())
+            {
+                return closest;
+            }
+
+            if (distance < closest)
+            {
+                closest = distance;
+                closestObject = &object;
+            }
+            return closest;
+        });
+
+        if (closestObject && outDistance)
+        {
+            *outDistance = closest;
+        }
+        return closestObject;
+    }
+
+}
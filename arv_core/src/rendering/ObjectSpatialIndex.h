@@ -0,0 +1,88 @@
+#pragma once
+
+#include "RenderingObject.h"
+#include "../math/AABB.h"
+#include "../math/DynamicBVH.h"
+#include "../math/Frustum.h"
+#include "../math/Ray.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * Keeps a DynamicBVH of the world bounds of a set of RenderingObjects.
+     *
+     * Added objects get a transform listener, so SetPosition/SetScale/SetRotation
+     * move their proxy right away. Objects without bounds (min == max) can't be
+     * placed in the tree; every query returns them.
+     *
+     * Objects must be removed (or the index cleared) before they are destroyed.
+     */
+    class ObjectSpatialIndex {
+    public:
+        ObjectSpatialIndex() = default;
+        ~ObjectSpatialIndex();
+
+        ObjectSpatialIndex(const ObjectSpatialIndex&) = delete;
+        ObjectSpatialIndex& operator=(const ObjectSpatialIndex&) = delete;
+
+        void Add(RenderingObject& object);
+        void Remove(RenderingObject& object);
+        void Update(RenderingObject& object);
+
+        // Clears the index and adds all objects
+        void Rebuild(const std::vector<std::unique_ptr<RenderingObject>>& objects);
+        void Clear();
+
+        uint32_t GetCount() const { return static_cast<uint32_t>(m_Proxies.size()); }
+
+        // Queries append to the output vector
+        void QueryFrustum(const Frustum& frustum, std::vector<RenderingObject*>& outObjects) const;
+        void QueryOverlap(const AABB& bounds, std::vector<RenderingObject*>& outObjects) const;
+
+        // Visits objects whose bounds the ray hits, nearer first. Unbounded objects are
+        // visited first with an entry distance of 0. Same callback contract as
+        // DynamicBVH::QueryRay: float(RenderingObject&, float entryDistance) -> new max distance.
+        template<typename Callback>
+        void QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const;
+
+        // Closest object under the ray, or nullptr. Objects with a picking mesh are
+        // tested against their triangles, other bounded objects against their bounds.
+        // Unbounded objects without a mesh (e.g. a skybox) can't be picked.
+        RenderingObject* Pick(const Ray& ray, float* outDistance = nullptr) const;
+
+        // World-space bounds of the object's local AABB under its current transform
+        static AABB ComputeWorldBounds(const RenderingObject& object);
+
+    private:
+        static constexpr int32_t UnboundedProxy = DynamicBVH::NullNode;
+
+        void AppendResults(std::vector<RenderingObject*>& outObjects) const;
+
+        DynamicBVH m_Tree;
+        std::unordered_map<RenderingObject*, int32_t> m_Proxies;
+        std::vector<RenderingObject*> m_Unbounded;
+        mutable std::vector<void*> m_Results;
+    };
+
+    template<typename Callback>
+    void ObjectSpatialIndex::QueryRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Callback&& callback) const
+    {
+        for (RenderingObject* object : m_Unbounded)
+        {
+            float newMax = callback(*object, 0.0f);
+            if (newMax < 0.0f)
+            {
+                return;
+            }
+            maxDistance = newMax < maxDistance ? newMax : maxDistance;
+        }
+
+        m_Tree.QueryRay(origin, direction, maxDistance, [&callback](void* userData, float entryDistance) {
+            return callback(*static_cast<RenderingObject*>(userData), entryDistance);
+        });
+    }
+
+}
@@ -0,0 +1,45 @@
+#include "QuantizedVertex.h"
+#include "math/VertexPacking.h"
+#include "utils/ThreadPool.h"
+
+namespace arv {
+
+    BufferLayout QuantizedVertex::GetLayout()
+    {
+        return {
+            { ShaderDataType::UShort4, "a_Position", true },
+            { ShaderDataType::Half2, "a_TexCoord" },
+            { ShaderDataType::Short2, "a_Normal", true }
+        };
+    }
+
+    void QuantizeVertices(const float* vertices, uint32_t vertexCount,
+                          const glm::vec3& boundsMin, const glm::vec3& boundsMax, QuantizedVertex* out)
+    {
+        // Flat axes map everything to 0
+        glm::vec3 extent = boundsMax - boundsMin;
+        glm::vec3 inverseExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                                extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                                extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+        ThreadPool::Global().ParallelFor(vertexCount, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                const float* vertex = vertices + size_t(i) * 8;
+                QuantizedVertex& packed = out[i];
+
+                for (int axis = 0; axis < 3; axis++) {
+                    packed.position[axis] = FloatToUnorm16((vertex[axis] - boundsMin[axis]) * inverseExtent[axis]);
+                }
+                packed.position[3] = 0;
+
+                packed.texcoord[0] = FloatToHalf(vertex[3]);
+                packed.texcoord[1] = FloatToHalf(vertex[4]);
+
+                glm::vec2 octahedral = OctahedralEncode(glm::vec3(vertex[5], vertex[6], vertex[7]));
+                packed.normal[0] = FloatToSnorm16(octahedral.x);
+                packed.normal[1] = FloatToSnorm16(octahedral.y);
+            }
+        }, 4096);
+    }
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "rendering/Buffer.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace arv {
+
+    /**
+     * 16-byte vertex for large static meshes, half the size of the interleaved
+     * float layout:
+     *   a_Position  UShort4, normalized - xyz relative to the mesh bounds, w unused
+     *   a_TexCoord  Half2
+     *   a_Normal    Short2, normalized - octahedral encoding
+     *
+     * Shaders reconstruct the position as offset + a_Position * scale (see
+     * GetDecodeScale/Offset) and the normal with the octahedral decode.
+     * Positions keep 1/65535 of the bounds per axis, e.g. 0.15 mm on a 10 m mesh.
+     */
+    struct QuantizedVertex {
+        uint16_t position[4];
+        uint16_t texcoord[2];
+        int16_t normal[2];
+
+        static BufferLayout GetLayout();
+
+        static glm::vec3 GetDecodeScale(const glm::vec3& boundsMin, const glm::vec3& boundsMax) { return boundsMax - boundsMin; }
+        static glm::vec3 GetDecodeOffset(const glm::vec3& boundsMin, const glm::vec3& boundsMax) { return boundsMin; }
+    };
+    static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must stay 16 bytes");
+
+    // Packs vertices in the interleaved position/texcoord/normal float layout
+    // (8 floats each); positions must lie within the bounds
+    void QuantizeVertices(const float* vertices, uint32_t vertexCount,
+                          const glm::vec3& boundsMin, const glm::vec3& boundsMax, QuantizedVertex* out);
+
+}
@@ -1,5 +1,7 @@
 #include "Renderer.h"
 #include "ARVBase.h"
+#include "CookedTexture.h"
+#include "utils/ThreadPool.h"
 #include <glm/glm.hpp>
 
 namespace arv {
@@ -51,10 +53,42 @@ namespace arv {
         return m_RenderingAPI->CreateShader(shaderSource);
     }
 
-    std::shared_ptr<Texture2D> Renderer::CreateTexture2D(const std::string& path)
+    std::shared_ptr<Texture2D> Renderer::CreateTexture2D(const std::string& path, const TextureSpecification& spec)
     {
         ARV_LOG_INFO("Renderer::CreateTexture2D() - Creating texture from path: {}", path);
-        return m_RenderingAPI->CreateTexture2D(path);
+        if (!IsBlockCompressed(spec.format)) {
+            return m_RenderingAPI->CreateTexture2D(path, spec);
+        }
+
+        TextureSpecification fallback = spec;
+        fallback.format = TextureFormat::RGBA8;
+        if (!SupportsTextureFormat(spec.format)) {
+            ARV_LOG_WARN("Renderer::CreateTexture2D() - Backend can't sample {}, loading {} as RGBA8",
+                         GetTextureFormatName(spec.format), path);
+            return m_RenderingAPI->CreateTexture2D(path, fallback);
+        }
+
+        CookedTexture cooked;
+        if (!cooked.LoadOrCook(path, spec, UsesBottomLeftTextureOrigin(), ThreadPool::Global())) {
+            return m_RenderingAPI->CreateTexture2D(path, fallback);
+        }
+
+        // Created with a placeholder texel, then replaced by the whole chain in one upload
+        static constexpr uint8_t white[4] = { 255, 255, 255, 255 };
+        std::shared_ptr<Texture2D> texture = m_RenderingAPI->CreateTexture2D(1, 1, white, spec);
+        texture->SetMipData(cooked.GetLevels(), cooked.GetLevelCount(), cooked.GetFormat());
+        return texture;
+    }
+
+    std::shared_ptr<Texture2D> Renderer::CreateTexture2D(uint32_t width, uint32_t height, const void* pixels, const TextureSpecification& spec)
+    {
+        return m_RenderingAPI->CreateTexture2D(width, height, pixels, spec);
+    }
+
+    std::shared_ptr<UniformBuffer> Renderer::CreateUniformBuffer(uint32_t size)
+    {
+        ARV_LOG_INFO("Renderer::CreateUniformBuffer() - Creating uniform buffer of {} bytes", size);
+        return m_RenderingAPI->CreateUniformBuffer(size);
     }
 
     Scene Renderer::NewScene(Camera* camera) {
@@ -24,7 +24,17 @@ namespace arv {
         std::shared_ptr<IndexBuffer> CreateIndexBuffer(unsigned int* indices, unsigned int size);
         std::shared_ptr<VertexArray> CreateVertexArray();
         std::shared_ptr<Shader> CreateShader(ShaderSource* shaderSource);
-        std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path);
+        // Block-compressed formats are loaded from, or cooked into, a CookedTexture;
+        // the texture falls back to RGBA8 if the backend can't sample the format
+        std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+        // 8-bit RGBA texels, rows top to bottom
+        std::shared_ptr<Texture2D> CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                   const TextureSpecification& spec = TextureSpecification());
+        std::shared_ptr<UniformBuffer> CreateUniformBuffer(uint32_t size);
+
+        bool SupportsVertexType(ShaderDataType type) const { return m_RenderingAPI->SupportsVertexType(type); }
+        bool SupportsTextureFormat(TextureFormat format) const { return m_RenderingAPI->SupportsTextureFormat(format); }
+        bool UsesBottomLeftTextureOrigin() const { return m_RenderingAPI->UsesBottomLeftTextureOrigin(); }
 
         Scene NewScene(Camera* camera);
 
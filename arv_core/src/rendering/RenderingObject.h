@@ -1,14 +1,24 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 #include <nlohmann/json.hpp>
 #include "rendering/Shader.h"
 #include "rendering/VertexArray.h"
 #include "rendering/Texture.h"
+#include "UniformSet.h"
+#include "../math/TriangleMesh.h"
 namespace arv {
 
+    // One material of a mesh: an index range of the object's vertex array and its texture
+    struct SubmeshDraw {
+        IndexRange range;
+        std::shared_ptr<Texture2D> texture;
+    };
+
     class RenderingObject {
 
     public:
@@ -18,26 +28,60 @@ namespace arv {
         virtual std::shared_ptr<VertexArray>& GetVertexArray() = 0;
         virtual std::shared_ptr<Texture2D> GetTexture() { return nullptr; }
 
+        // Uploaded to the shader before each draw of this object. Shaders are
+        // shared through the ShaderLibrary, so anything that differs between
+        // objects goes here rather than onto the shader.
+        UniformSet& GetUniforms() { return m_uniforms; }
+        const UniformSet& GetUniforms() const { return m_uniforms; }
+
         glm::vec3& GetPosition() { return position; }
         const glm::vec3& GetPosition() const { return position; }
-        void SetPosition(const glm::vec3& pos) { position = pos; }
+        void SetPosition(const glm::vec3& pos) { position = pos; NotifyTransformChanged(); }
         
         const std::string& GetName() const { return m_name; }
         void SetName(const std::string& name) { m_name = name; }
 
         glm::vec3& GetScale() { return m_scale; }
         const glm::vec3& GetScale() const { return m_scale; }
-        void SetScale(const glm::vec3& scale) { m_scale = scale; }
+        void SetScale(const glm::vec3& scale) { m_scale = scale; NotifyTransformChanged(); }
 
         glm::vec3& GetRotation() { return m_rotation; }
         const glm::vec3& GetRotation() const { return m_rotation; }
-        void SetRotation(const glm::vec3& rotation) { m_rotation = rotation; }
+        void SetRotation(const glm::vec3& rotation) { m_rotation = rotation; NotifyTransformChanged(); }
+
+        // Called after SetPosition/SetScale/SetRotation, e.g. to keep a spatial index in sync.
+        // Code that edits the transform through the non-const getters must call
+        // NotifyTransformChanged() itself.
+        using TransformListener = std::function<void(RenderingObject&)>;
+        void SetTransformListener(TransformListener listener) { m_transformListener = std::move(listener); }
+        void NotifyTransformChanged() { if (m_transformListener) m_transformListener(*this); }
 
         const glm::vec3& GetBoundsMin() const { return m_boundsMin; }
         const glm::vec3& GetBoundsMax() const { return m_boundsMax; }
         glm::vec3 GetBoundsSize() const { return m_boundsMax - m_boundsMin; }
         glm::vec3 GetBoundsCenter() const { return (m_boundsMin + m_boundsMax) * 0.5f; }
 
+        // Levels of detail, finest first; Scene picks one per frame from the projected
+        // size of the bounds. Errors are relative to the bounding sphere radius.
+        virtual uint32_t GetLodCount() const { return 1; }
+        virtual float GetLodError(uint32_t lod) const { return 0.0f; }
+        // Indices of a LOD in GetVertexArray(); all of them by default
+        virtual IndexRange GetLodRange(uint32_t lod) const { return IndexRange(); }
+
+        // Per-material draws of a LOD in material order; empty if the object is
+        // drawn whole with GetTexture()
+        virtual const std::vector<SubmeshDraw>& GetSubmeshDraws(uint32_t lod) const {
+            static const std::vector<SubmeshDraw> none;
+            return none;
+        }
+
+        // LOD drawn last frame, kept for hysteresis
+        uint32_t GetCurrentLod() const { return m_currentLod; }
+        void SetCurrentLod(uint32_t lod) { m_currentLod = lod; }
+
+        // Local-space triangles for exact picking; objects without one are picked by their bounds
+        virtual const TriangleMesh* GetPickingMesh() const { return nullptr; }
+
         virtual void RenderCustomImGui() {}
         virtual void SaveCustomProperties(nlohmann::json& j) const {}
 
@@ -48,6 +92,11 @@ namespace arv {
         std::string m_name;
         glm::vec3 m_boundsMin{0.0f};
         glm::vec3 m_boundsMax{0.0f};
+        UniformSet m_uniforms;
+
+    private:
+        TransformListener m_transformListener;
+        uint32_t m_currentLod = 0;
     };
 
 }
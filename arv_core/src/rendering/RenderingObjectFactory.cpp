@@ -1,4 +1,5 @@
 #include "RenderingObjectFactory.h"
+#include "ObjAssetRO.h"
 #include "ARVBase.h"
 
 namespace arv {
@@ -16,6 +17,22 @@ namespace arv {
         ARV_LOG_INFO("RenderingObjectFactory: Registered type '{}'", typeName);
     }
 
+    void RenderingObjectFactory::RegisterCoreTypes() {
+        Register("ObjAssetRO", [](const nlohmann::json& json) -> std::unique_ptr<RenderingObject> {
+            std::string pathFragment;
+            if (json.contains("pathFragment")) {
+                pathFragment = json.at("pathFragment").get<std::string>();
+            }
+
+            ObjAssetRO::VertexFormat vertexFormat = ObjAssetRO::VertexFormat::Float;
+            if (json.contains("vertexFormat") && json.at("vertexFormat").get<std::string>() == "quantized") {
+                vertexFormat = ObjAssetRO::VertexFormat::Quantized;
+            }
+
+            return std::make_unique<ObjAssetRO>(pathFragment, vertexFormat);
+        });
+    }
+
     std::unique_ptr<RenderingObject> RenderingObjectFactory::Create(const nlohmann::json& json) const {
         if (!json.contains("type")) {
             ARV_LOG_ERROR("RenderingObjectFactory: JSON object missing 'type' field");
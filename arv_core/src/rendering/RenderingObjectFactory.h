@@ -20,6 +20,10 @@ namespace arv {
         // Register a factory function for a type
         void Register(const std::string& typeName, RenderingObjectCreator creator);
 
+        // Register the types arv_core implements itself (ObjAssetRO), so every
+        // application loads them from scene JSON the same way
+        void RegisterCoreTypes();
+
         // Create a RenderingObject from JSON
         // Returns nullptr if type is not registered
         std::unique_ptr<RenderingObject> Create(const nlohmann::json& json) const;
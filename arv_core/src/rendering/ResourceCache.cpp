@@ -0,0 +1,114 @@
+#include "ResourceCache.h"
+#include "ARVApplication.h"
+#include "ARVBase.h"
+
+#include <filesystem>
+
+namespace arv {
+
+    namespace {
+
+        std::string TextureOptions(const TextureSpecification& spec) {
+            return "filter=" + std::to_string(static_cast<int>(spec.filter)) +
+                   ",wrap=" + std::to_string(static_cast<int>(spec.wrap)) +
+                   ",mips=" + std::to_string(spec.mipLevels) +
+                   ",aniso=" + std::to_string(spec.maxAnisotropy) +
+                   ",srgb=" + (spec.srgb ? "1" : "0") +
+                   ",format=" + GetTextureFormatName(spec.format);
+        }
+
+    }
+
+    ResourceCache& ResourceCache::Global() {
+        static ResourceCache cache;
+        return cache;
+    }
+
+    std::string ResourceCache::MakeKey(const std::string& type, const std::string& path, const std::string& options) {
+        std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+        return type + "|" + normalized + "|" + options;
+    }
+
+    std::shared_ptr<Texture2D> ResourceCache::GetTexture2D(const std::string& path, const TextureSpecification& spec) {
+        return GetOrCreate<Texture2D>(MakeKey("Texture2D", path, TextureOptions(spec)), [&]() {
+            return ARVApplication::Get()->GetRenderer()->CreateTexture2D(path, spec);
+        });
+    }
+
+    std::shared_ptr<Texture2D> ResourceCache::StreamTexture2D(const std::string& path, const TextureSpecification& spec) {
+        return GetOrCreate<Texture2D>(MakeKey("Texture2D", path, TextureOptions(spec) + ",streamed"), [&]() {
+            return ARVApplication::Get()->GetTextureStreamer()->Load(path, spec);
+        });
+    }
+
+    std::shared_ptr<void> ResourceCache::Find(const std::string& key, std::type_index type) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Entries.find(key);
+        if (it == m_Entries.end()) {
+            m_Stats.misses++;
+            return nullptr;
+        }
+
+        std::shared_ptr<void> resource = it->second.resource.lock();
+        if (!resource) {
+            m_Entries.erase(it);
+            m_Stats.evictions++;
+            m_Stats.misses++;
+            return nullptr;
+        }
+        if (it->second.type != type) {
+            ARV_LOG_ERROR("ResourceCache::Find() - Key {} is cached as {}, requested as {}",
+                          key, it->second.type.name(), type.name());
+            m_Stats.misses++;
+            return nullptr;
+        }
+
+        m_Stats.hits++;
+        return resource;
+    }
+
+    std::shared_ptr<void> ResourceCache::Store(const std::string& key, std::type_index type, std::shared_ptr<void> resource) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        Entry& entry = m_Entries[key];
+        if (std::shared_ptr<void> existing = entry.resource.lock()) {
+            if (entry.type == type) {
+                // Another thread created it first; keep handing out that one
+                return existing;
+            }
+            ARV_LOG_WARN("ResourceCache::Store() - Replacing {} with a resource of another type", key);
+        }
+        entry.resource = resource;
+        entry.type = type;
+        return resource;
+    }
+
+    void ResourceCache::Prune() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+            if (it->second.resource.expired()) {
+                it = m_Entries.erase(it);
+                m_Stats.evictions++;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    ResourceCacheStats ResourceCache::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ResourceCacheStats stats = m_Stats;
+        stats.liveEntries = 0;
+        for (const auto& [key, entry] : m_Entries) {
+            if (!entry.resource.expired()) {
+                stats.liveEntries++;
+            }
+        }
+        return stats;
+    }
+
+    void ResourceCache::ResetStats() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stats = ResourceCacheStats();
+    }
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace arv {
+
+    struct ResourceCacheStats {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;     // Entries dropped after their last handle was released
+        uint32_t liveEntries = 0;   // Entries whose resource is still referenced
+    };
+
+    /**
+     * Shared GPU resources keyed by type, resolved path and import options.
+     *
+     * The cache only holds weak references: a resource lives as long as some
+     * object holds its handle, and the next lookup after the last handle is
+     * gone loads it again. Expired entries are dropped on lookup and by Prune().
+     *
+     * Lookups are thread safe. Resources are created outside the lock, so a
+     * creator may look up other resources (e.g. a mesh its textures); if two
+     * threads miss on the same key at once, the first one stored wins.
+     */
+    class ResourceCache {
+    public:
+        // Shared engine-wide cache, created on first use
+        static ResourceCache& Global();
+
+        // "type|normalized path|options"; paths are normalized lexically, so
+        // "a/./b" and "a/c/../b" share an entry
+        static std::string MakeKey(const std::string& type, const std::string& path, const std::string& options = "");
+
+        // Returns the cached resource for key, or stores and returns create()'s.
+        // A nullptr from create() is returned but not cached.
+        template<typename T>
+        std::shared_ptr<T> GetOrCreate(const std::string& key, const std::function<std::shared_ptr<T>()>& create) {
+            if (std::shared_ptr<void> cached = Find(key, typeid(T))) {
+                return std::static_pointer_cast<T>(cached);
+            }
+            std::shared_ptr<T> resource = create();
+            if (!resource) {
+                return nullptr;
+            }
+            return std::static_pointer_cast<T>(Store(key, typeid(T), resource));
+        }
+
+        // Texture from the renderer of the current application. Textures with
+        // different specifications are separate entries.
+        std::shared_ptr<Texture2D> GetTexture2D(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+
+        // Like GetTexture2D, but returns a placeholder right away and swaps the
+        // image in once the application's TextureStreamer has uploaded it
+        std::shared_ptr<Texture2D> StreamTexture2D(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+
+        // Drops expired entries
+        void Prune();
+
+        ResourceCacheStats GetStats() const;
+        void ResetStats();
+
+    private:
+        struct Entry {
+            std::weak_ptr<void> resource;
+            std::type_index type = typeid(void);
+        };
+
+        std::shared_ptr<void> Find(const std::string& key, std::type_index type);
+        std::shared_ptr<void> Store(const std::string& key, std::type_index type, std::shared_ptr<void> resource);
+
+        mutable std::mutex m_Mutex;
+        std::unordered_map<std::string, Entry> m_Entries;
+        ResourceCacheStats m_Stats;
+    };
+
+}
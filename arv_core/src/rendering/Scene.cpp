@@ -1,14 +1,20 @@
 #include "Scene.h"
 #include "ARVBase.h"
+#include "ARVApplication.h"
 
-#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <tuple>
 
 namespace arv {
 
+    static constexpr UniformId MvpUniform("u_mvp");
+
     Scene::Scene(RenderingAPI* renderingApi, Camera* camera)
         : m_RenderingAPI(renderingApi), m_Camera(camera)
     {
-        
+        m_ViewProjection = m_Camera->GetViewProjectionMatrix();
+        m_Frustum = m_Camera->GetFrustum();
+        m_CameraPosition = glm::vec3(glm::inverse(m_Camera->GetViewMatrix())[3]);
     }
 
     void Scene::ClearColor(const glm::vec4 &color) {
@@ -18,30 +24,190 @@ namespace arv {
     }
 
     void Scene::Submit(RenderingObject& object) {
-        glm::mat4 projection = m_Camera->GetProjectionMatrix();
-        glm::mat4 view = m_Camera->GetViewMatrix();
-        glm::mat4 transform = glm::translate(glm::mat4(1.0f), object.GetPosition());
-        const glm::vec3& rot = object.GetRotation();
-        transform = glm::rotate(transform, glm::radians(rot.y), glm::vec3(0, 1, 0));
-        transform = glm::rotate(transform, glm::radians(rot.x), glm::vec3(1, 0, 0));
-        transform = glm::rotate(transform, glm::radians(rot.z), glm::vec3(0, 0, 1));
-        transform = glm::scale(transform, object.GetScale());
-
-        glm::mat4 mvp = projection * view * transform;
-
-        object.GetShader()->UploadUniformMat4("u_mvp", mvp);
-
-        auto texture = object.GetTexture();
-        if (texture) {
-            m_RenderingAPI->Draw(object.GetShader(), object.GetVertexArray(), texture);
-        } else {
-            m_RenderingAPI->Draw(object.GetShader(), object.GetVertexArray());
-        }
+        m_Queue.push_back(&object);
+        m_Transforms.Add(object.GetPosition(), object.GetRotation(), object.GetScale());
+        m_Stats.submittedObjects++;
     }
 
     void Scene::Render() {
+        // Bound once for every draw of the scene on backends with uniform buffers
+        FrameUniforms frame;
+        frame.view = m_Camera->GetViewMatrix();
+        frame.projection = m_Camera->GetProjectionMatrix();
+        frame.viewProjection = m_ViewProjection;
+        frame.cameraPosition = glm::vec4(m_CameraPosition, 1.0f);
+        if (ARVApplication* app = ARVApplication::Get()) {
+            frame.time.x = app->GetTime();
+        }
+        m_RenderingAPI->SetFrameUniforms(frame);
+
+        // One SoA pass for all queued transforms instead of rebuilding them per object
+        m_Transforms.Compose(m_ViewProjection);
+        m_Stats.matricesBuilt += m_Transforms.GetCount();
+        CullObjects();
+        SelectLods();
+
+        for (uint32_t i = 0; i < m_Queue.size(); i++) {
+            if (!m_Bounds.IsVisible(i)) {
+                continue;
+            }
+
+            RenderingObject& object = *m_Queue[i];
+            if (object.GetShader()->SupportsInstancing()) {
+                auto texture = object.GetTexture();
+                m_InstanceKeys.push_back({object.GetShader().get(), object.GetVertexArray().get(), texture.get(),
+                                          object.GetUniforms().GetHash(), object.GetCurrentLod(), i});
+            } else {
+                DrawObject(i);
+            }
+        }
+        DrawInstanceGroups();
+
+        m_Queue.clear();
+        m_Transforms.Clear();
+        m_Bounds.Clear();
+        m_InstanceKeys.clear();
+
         // Flush any pending draw commands so they execute before overlays (like ImGui) render
         m_RenderingAPI->FlushDrawCommands();
     }
 
+    void Scene::CullObjects() {
+        // Objects without bounds (min == max) can't be tested and are always drawn
+        const glm::vec3 unbounded(1e30f);
+
+        for (uint32_t i = 0; i < m_Queue.size(); i++) {
+            const RenderingObject& object = *m_Queue[i];
+            glm::vec3 center(0.0f);
+            glm::vec3 extents = unbounded;
+            if (object.GetBoundsMin() != object.GetBoundsMax()) {
+                TransformBounds(m_Transforms.GetModelMatrix(i), object.GetBoundsMin(), object.GetBoundsMax(), center, extents);
+            }
+            m_Bounds.Add(center, extents);
+        }
+
+        uint32_t visible = m_Bounds.Cull(m_Frustum);
+        m_Stats.culledObjects += m_Bounds.GetCount() - visible;
+    }
+
+    void Scene::SelectLods() {
+        // Projected radius over half the screen height: cot(fov / 2) * r / d for
+        // perspective, and independent of distance for orthographic projections
+        glm::mat4 projection = m_Camera->GetProjectionMatrix();
+        bool perspective = projection[2][3] != 0.0f;
+        float projectionScale = std::abs(projection[1][1]);
+
+        for (uint32_t i = 0; i < m_Queue.size(); i++) {
+            RenderingObject& object = *m_Queue[i];
+            uint32_t lodCount = object.GetLodCount();
+            if (lodCount <= 1 || !m_Bounds.IsVisible(i) || object.GetBoundsMin() == object.GetBoundsMax()) {
+                object.SetCurrentLod(0);
+                continue;
+            }
+
+            float radius = glm::length(m_Bounds.GetExtents(i));
+            float screenSize = radius * projectionScale;
+            if (perspective) {
+                float distance = glm::length(m_Bounds.GetCenter(i) - m_CameraPosition);
+                screenSize = distance > radius ? screenSize / distance : 1e30f;
+            }
+
+            // Errors grow with the level; the error in screen heights is
+            // error * radius projected, i.e. error * screenSize / 2
+            uint32_t current = object.GetCurrentLod();
+            uint32_t lod = 0;
+            for (uint32_t level = 1; level < lodCount; level++) {
+                float tolerance = level > current ? LodErrorTolerance * (1.0f - LodHysteresis) : LodErrorTolerance;
+                if (object.GetLodError(level) * screenSize * 0.5f > tolerance) {
+                    break;
+                }
+                lod = level;
+            }
+
+            object.SetCurrentLod(lod);
+            if (lod > 0) {
+                m_Stats.reducedLodObjects++;
+            }
+        }
+    }
+
+    void Scene::DrawObject(uint32_t index) {
+        RenderingObject& object = *m_Queue[index];
+        // The shader may be shared with other objects, so this object's values are
+        // set again right before its draws. Shaders declaring the ArvObject block
+        // read the object uniforms, others u_mvp.
+        Shader& shader = *object.GetShader();
+        object.GetUniforms().Apply(shader);
+        shader.UploadUniformMat4(MvpUniform, m_Transforms.GetMVP(index));
+        ObjectUniforms uniforms{m_Transforms.GetModelMatrix(index), m_Transforms.GetMVP(index)};
+
+        // Multi-material meshes: one ranged draw per material. Object uniforms
+        // only apply to the next draw, so they are set for each.
+        const std::vector<SubmeshDraw>& submeshes = object.GetSubmeshDraws(object.GetCurrentLod());
+        if (!submeshes.empty()) {
+            for (const SubmeshDraw& submesh : submeshes) {
+                m_RenderingAPI->SetObjectUniforms(uniforms);
+                m_RenderingAPI->Draw(object.GetShader(), object.GetVertexArray(), submesh.texture, submesh.range);
+            }
+            return;
+        }
+
+        // Whole objects draw the index range of their LOD; texture may be nullptr
+        m_RenderingAPI->SetObjectUniforms(uniforms);
+        m_RenderingAPI->Draw(object.GetShader(), object.GetVertexArray(), object.GetTexture(),
+                             object.GetLodRange(object.GetCurrentLod()));
+    }
+
+    void Scene::DrawInstanceGroups() {
+        // Stable sort keeps submission order inside each group
+        std::stable_sort(m_InstanceKeys.begin(), m_InstanceKeys.end(), [](const InstanceKey& a, const InstanceKey& b) {
+            return std::tie(a.shader, a.vertexArray, a.texture, a.uniforms, a.lod) <
+                   std::tie(b.shader, b.vertexArray, b.texture, b.uniforms, b.lod);
+        });
+
+        size_t begin = 0;
+        while (begin < m_InstanceKeys.size()) {
+            const InstanceKey& first = m_InstanceKeys[begin];
+            size_t end = begin + 1;
+            while (end < m_InstanceKeys.size() &&
+                   m_InstanceKeys[end].shader == first.shader &&
+                   m_InstanceKeys[end].vertexArray == first.vertexArray &&
+                   m_InstanceKeys[end].texture == first.texture &&
+                   m_InstanceKeys[end].uniforms == first.uniforms &&
+                   m_InstanceKeys[end].lod == first.lod) {
+                end++;
+            }
+
+            if (end - begin == 1) {
+                DrawObject(first.object);
+            } else {
+                m_Instances.clear();
+                for (size_t i = begin; i < end; i++) {
+                    InstanceData instance;
+                    instance.model = m_Transforms.GetModelMatrix(m_InstanceKeys[i].object);
+                    m_Instances.push_back(instance);
+                }
+
+                RenderingObject& object = *m_Queue[first.object];
+                object.GetUniforms().Apply(*object.GetShader());
+                const std::vector<SubmeshDraw>& submeshes = object.GetSubmeshDraws(object.GetCurrentLod());
+                if (submeshes.empty()) {
+                    m_RenderingAPI->DrawInstanced(object.GetShader(), object.GetVertexArray(), object.GetTexture(),
+                                                  m_Instances.data(), static_cast<uint32_t>(m_Instances.size()),
+                                                  m_ViewProjection, object.GetLodRange(object.GetCurrentLod()));
+                    m_Stats.instancedDraws++;
+                } else {
+                    for (const SubmeshDraw& submesh : submeshes) {
+                        m_RenderingAPI->DrawInstanced(object.GetShader(), object.GetVertexArray(), submesh.texture,
+                                                      m_Instances.data(), static_cast<uint32_t>(m_Instances.size()),
+                                                      m_ViewProjection, submesh.range);
+                    }
+                    m_Stats.instancedDraws += static_cast<uint32_t>(submeshes.size());
+                }
+                m_Stats.instancedObjects += static_cast<uint32_t>(m_Instances.size());
+            }
+            begin = end;
+        }
+    }
+
 }
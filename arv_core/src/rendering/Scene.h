@@ -2,22 +2,73 @@
 
 #include "rendering/RenderingAPI.h"
 #include "../camera/Camera.h"
+#include "../math/Frustum.h"
+#include "../math/TransformBatch.h"
 #include <memory>
+#include <vector>
 #include "RenderingObject.h"
 
 namespace arv {
 
+    struct SceneStats {
+        uint32_t submittedObjects = 0;
+        uint32_t culledObjects = 0;   // outside the camera frustum, not drawn
+        uint32_t matricesBuilt = 0;   // model + MVP pairs composed by the batch pass
+        uint32_t instancedDraws = 0;  // DrawInstanced() calls issued for merged objects
+        uint32_t instancedObjects = 0;
+        uint32_t reducedLodObjects = 0;  // drawn with a LOD coarser than the full mesh
+    };
+
     class Scene {
     public:
+        // A LOD is used while its simplification error projects to at most this
+        // fraction of the screen height, about a pixel at 1080p
+        static constexpr float LodErrorTolerance = 1.0f / 1080.0f;
+        // Moving to a coarser LOD needs this much margin below the switch point,
+        // so objects resting near it don't alternate between levels
+        static constexpr float LodHysteresis = 0.15f;
+
         Scene(RenderingAPI* renderingApi, Camera* camera);
 
+        // Queues the object; transforms are composed for all objects at once in Render().
+        // Objects sharing shader, vertex array, texture, uniform values and LOD are
+        // merged into one instanced draw when the shader supports instancing.
+        // Objects whose world bounds are fully outside the camera frustum are skipped.
+        // Objects with LODs are drawn at the coarsest level whose error stays invisible.
         void Submit(RenderingObject& object);
         void ClearColor(const glm::vec4& color);
         void Render();
 
+        const glm::mat4& GetViewProjectionMatrix() const { return m_ViewProjection; }
+        const SceneStats& GetStats() const { return m_Stats; }
+
     private:
+        struct InstanceKey {
+            const Shader* shader;
+            const VertexArray* vertexArray;
+            const Texture2D* texture;
+            uint64_t uniforms;         // UniformSet::GetHash() of the object
+            uint32_t lod;              // LODs of one mesh share the vertex array
+            uint32_t object;           // Index into m_Queue
+        };
+
+        void CullObjects();
+        void SelectLods();
+        void DrawObject(uint32_t index);
+        void DrawInstanceGroups();
+
         RenderingAPI* m_RenderingAPI;  // Non-owning pointer
         Camera* m_Camera;
+        glm::mat4 m_ViewProjection;    // Cached once per scene (= per frame)
+        Frustum m_Frustum;
+        glm::vec3 m_CameraPosition;
+
+        std::vector<RenderingObject*> m_Queue;  // Non-owning, valid until Render()
+        TransformBatch m_Transforms;
+        BoxCullBatch m_Bounds;
+        std::vector<InstanceKey> m_InstanceKeys;
+        std::vector<InstanceData> m_Instances;
+        SceneStats m_Stats;
     };
 
 }
@@ -0,0 +1,122 @@
+#include "ShaderLibrary.h"
+#include "ARVApplication.h"
+#include "CoreShaderSource.h"
+#include "ARVBase.h"
+#include "utils/SourceStamp.h"
+
+#include <iterator>
+
+namespace arv {
+
+    namespace {
+
+        // Keeps the source a shader points to alive for as long as the shader
+        struct Program {
+            std::unique_ptr<CoreShaderSource> source;
+            std::shared_ptr<Shader> shader;
+        };
+
+    }
+
+    ShaderLibrary& ShaderLibrary::Global() {
+        static ShaderLibrary library;
+        return library;
+    }
+
+    std::shared_ptr<Shader> ShaderLibrary::Get(const std::string& source) {
+        uint64_t hash = HashBytes(reinterpret_cast<const std::byte*>(source.data()), source.size());
+        if (std::shared_ptr<Shader> shader = Find(hash, source)) {
+            return shader;
+        }
+
+        // Compiled outside the lock; if two threads miss at once, the first one stored wins
+        auto program = std::make_shared<Program>();
+        program->source = std::make_unique<CoreShaderSource>(source);
+        program->shader = ARVApplication::Get()->GetRenderer()->CreateShader(program->source.get());
+        program->shader->Compile();
+        ARV_LOG_INFO("ShaderLibrary::Get() - Compiled shader {:016x}", hash);
+
+        // Aliasing handle: points at the shader, owns the whole program
+        return Store(hash, source, std::shared_ptr<Shader>(program, program->shader.get()));
+    }
+
+    std::shared_ptr<Shader> ShaderLibrary::Find(uint64_t hash, const std::string& source) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Entries.find(hash);
+        if (it == m_Entries.end()) {
+            return nullptr;
+        }
+
+        for (const Entry& entry : it->second) {
+            if (entry.source == source) {
+                std::shared_ptr<Shader> shader = entry.shader.lock();
+                if (shader) {
+                    m_Stats.hits++;
+                }
+                return shader;
+            }
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<Shader> ShaderLibrary::Store(uint64_t hash, const std::string& source, std::shared_ptr<Shader> shader) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stats.compiles++;
+
+        std::vector<Entry>& entries = m_Entries[hash];
+        for (Entry& entry : entries) {
+            if (entry.source != source) {
+                continue;
+            }
+            if (std::shared_ptr<Shader> existing = entry.shader.lock()) {
+                // Another thread compiled it first; keep handing out that one
+                return existing;
+            }
+            entry.shader = shader;
+            m_Stats.evictions++;
+            return shader;
+        }
+
+        if (!entries.empty()) {
+            ARV_LOG_WARN("ShaderLibrary::Store() - Different sources share hash {:016x}", hash);
+        }
+        entries.push_back({source, shader});
+        return shader;
+    }
+
+    void ShaderLibrary::Prune() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+            std::vector<Entry>& entries = it->second;
+            for (auto entry = entries.begin(); entry != entries.end();) {
+                if (entry->shader.expired()) {
+                    entry = entries.erase(entry);
+                    m_Stats.evictions++;
+                } else {
+                    ++entry;
+                }
+            }
+            it = entries.empty() ? m_Entries.erase(it) : std::next(it);
+        }
+    }
+
+    ShaderLibraryStats ShaderLibrary::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ShaderLibraryStats stats = m_Stats;
+        stats.liveShaders = 0;
+        for (const auto& [hash, entries] : m_Entries) {
+            for (const Entry& entry : entries) {
+                if (!entry.shader.expired()) {
+                    stats.liveShaders++;
+                }
+            }
+        }
+        return stats;
+    }
+
+    void ShaderLibrary::ResetStats() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stats = ShaderLibraryStats();
+    }
+
+}
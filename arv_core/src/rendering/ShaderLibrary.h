@@ -0,0 +1,66 @@
+#pragma once
+
+#include "rendering/Shader.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace arv {
+
+    struct ShaderLibraryStats {
+        uint32_t hits = 0;          // Lookups answered with an already compiled program
+        uint32_t compiles = 0;      // Programs created and compiled
+        uint32_t evictions = 0;     // Entries dropped after their last handle was released
+        uint32_t liveShaders = 0;   // Distinct programs still referenced
+    };
+
+    /**
+     * Compiled shaders interned by source, so every object drawing with the
+     * same source shares one program: one compile, and one program switch per
+     * frame for all of them once the backend sorts its queue by shader.
+     *
+     * Entries are found by a hash of the source and confirmed against the
+     * stored text, so a hash collision costs a compile, never a wrong program.
+     * Like the ResourceCache, the library only holds weak references; a
+     * shader lives as long as some handle to it does.
+     *
+     * Shared shaders must not carry per-object state: objects keep their
+     * values in a UniformSet, which Scene uploads before each of their draws.
+     * Uniforms set on a shared shader directly are seen by every object using
+     * it, which is only right for per-draw values such as u_mvp set right
+     * before the Draw().
+     */
+    class ShaderLibrary {
+    public:
+        // Shared engine-wide library, created on first use
+        static ShaderLibrary& Global();
+
+        // Compiled shader for the source text, created with the renderer of the
+        // current application on the first request; the handle keeps the
+        // ShaderSource alive
+        std::shared_ptr<Shader> Get(const std::string& source);
+
+        // Drops expired entries
+        void Prune();
+
+        ShaderLibraryStats GetStats() const;
+        void ResetStats();
+
+    private:
+        struct Entry {
+            std::string source;
+            std::weak_ptr<Shader> shader;
+        };
+
+        std::shared_ptr<Shader> Find(uint64_t hash, const std::string& source);
+        std::shared_ptr<Shader> Store(uint64_t hash, const std::string& source, std::shared_ptr<Shader> shader);
+
+        mutable std::mutex m_Mutex;
+        std::unordered_map<uint64_t, std::vector<Entry>> m_Entries;  // Source hash to sources sharing it
+        ShaderLibraryStats m_Stats;
+    };
+
+}
@@ -0,0 +1,470 @@
+#include "TextureCompressor.h"
+#include "math/SimdLane.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace arv {
+
+    namespace {
+
+        constexpr uint32_t BlockTexels = 16;
+
+        // One 4x4 block, a channel at a time, in 0..255
+        struct Block {
+            float channel[4][BlockTexels];
+        };
+
+        void LoadBlock(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY,
+                       Block& block) {
+            for (uint32_t y = 0; y < 4; y++) {
+                uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+                for (uint32_t x = 0; x < 4; x++) {
+                    uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+                    const uint8_t* texel = pixels + (static_cast<size_t>(sourceY) * width + sourceX) * 4;
+                    for (uint32_t c = 0; c < 4; c++) {
+                        block.channel[c][y * 4 + x] = texel[c];
+                    }
+                }
+            }
+        }
+
+        // Smallest key of each texel over the palette, where a key is the squared
+        // distance times the palette size plus the entry. Texels and palette are
+        // whole numbers, so keys stay exact in a float and the minimum carries
+        // the winning entry along with its distance.
+        template<typename Lane>
+        void NearestKeys(const float* const* channels, uint32_t channelCount, const float* palette,
+                         uint32_t paletteSize, uint32_t first, float* keys) {
+            using Value = typename Lane::Type;
+            Value best = Lane::Set(std::numeric_limits<float>::max());
+            Value size = Lane::Set(static_cast<float>(paletteSize));
+            for (uint32_t entry = 0; entry < paletteSize; entry++) {
+                Value distance = Lane::Set(0.0f);
+                for (uint32_t c = 0; c < channelCount; c++) {
+                    Value d = Lane::Sub(Lane::Load(channels[c] + first), Lane::Set(palette[entry * 4 + c]));
+                    distance = Lane::Add(distance, Lane::Mul(d, d));
+                }
+                Value key = Lane::Add(Lane::Mul(distance, size), Lane::Set(static_cast<float>(entry)));
+                best = Lane::Min(best, key);
+            }
+            Lane::Store(keys + first, best);
+        }
+
+        // Index of the nearest palette entry (palette[entry * 4 + channel]) for
+        // every texel; returns the summed squared error
+        uint32_t FindNearest(const float* const* channels, uint32_t channelCount, const float* palette,
+                             uint32_t paletteSize, uint8_t* indices) {
+            float keys[BlockTexels];
+            uint32_t i = 0;
+#if defined(ARV_SIMD_AVX2) || defined(ARV_SIMD_NEON)
+            for (; i + SimdLane::Width <= BlockTexels; i += SimdLane::Width) {
+                NearestKeys<SimdLane>(channels, channelCount, palette, paletteSize, i, keys);
+            }
+#endif
+            for (; i < BlockTexels; i++) {
+                NearestKeys<ScalarLane>(channels, channelCount, palette, paletteSize, i, keys);
+            }
+
+            uint32_t error = 0;
+            for (i = 0; i < BlockTexels; i++) {
+                uint32_t key = static_cast<uint32_t>(keys[i]);
+                indices[i] = static_cast<uint8_t>(key % paletteSize);
+                error += key / paletteSize;
+            }
+            return error;
+        }
+
+        // Endpoints at the extremes of the texels along their principal axis
+        void PrincipalEndpoints(const float* const* channels, uint32_t channelCount, float* e0, float* e1) {
+            float mean[4] = {};
+            for (uint32_t c = 0; c < channelCount; c++) {
+                for (uint32_t i = 0; i < BlockTexels; i++) {
+                    mean[c] += channels[c][i];
+                }
+                mean[c] /= BlockTexels;
+            }
+
+            float covariance[4][4] = {};
+            for (uint32_t i = 0; i < BlockTexels; i++) {
+                for (uint32_t a = 0; a < channelCount; a++) {
+                    for (uint32_t b = a; b < channelCount; b++) {
+                        covariance[a][b] += (channels[a][i] - mean[a]) * (channels[b][i] - mean[b]);
+                    }
+                }
+            }
+            for (uint32_t a = 0; a < channelCount; a++) {
+                for (uint32_t b = 0; b < a; b++) {
+                    covariance[a][b] = covariance[b][a];
+                }
+            }
+
+            // Power iteration; a few steps are plenty for 16 texels
+            float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            for (uint32_t iteration = 0; iteration < 8; iteration++) {
+                float next[4] = {};
+                float length = 0.0f;
+                for (uint32_t a = 0; a < channelCount; a++) {
+                    for (uint32_t b = 0; b < channelCount; b++) {
+                        next[a] += covariance[a][b] * axis[b];
+                    }
+                    length = std::max(length, std::abs(next[a]));
+                }
+                if (length < 1e-6f) {
+                    break;
+                }
+                for (uint32_t a = 0; a < channelCount; a++) {
+                    axis[a] = next[a] / length;
+                }
+            }
+
+            float axisLength2 = 0.0f;
+            for (uint32_t c = 0; c < channelCount; c++) {
+                axisLength2 += axis[c] * axis[c];
+            }
+            float minT = 0.0f;
+            float maxT = 0.0f;
+            if (axisLength2 > 1e-12f) {
+                minT = std::numeric_limits<float>::max();
+                maxT = -minT;
+                for (uint32_t i = 0; i < BlockTexels; i++) {
+                    float t = 0.0f;
+                    for (uint32_t c = 0; c < channelCount; c++) {
+                        t += (channels[c][i] - mean[c]) * axis[c];
+                    }
+                    minT = std::min(minT, t);
+                    maxT = std::max(maxT, t);
+                }
+                minT /= axisLength2;
+                maxT /= axisLength2;
+            }
+            for (uint32_t c = 0; c < channelCount; c++) {
+                e0[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+                e1[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+            }
+        }
+
+        // Least-squares endpoints for the chosen indices, where weights[entry]
+        // is how far the palette entry lies from e0 towards e1. Returns false
+        // if the indices don't pin both endpoints down.
+        bool RefitEndpoints(const float* const* channels, uint32_t channelCount, const uint8_t* indices,
+                            const float* weights, float* e0, float* e1) {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = {}, bx[4] = {};
+            for (uint32_t i = 0; i < BlockTexels; i++) {
+                float b = weights[indices[i]];
+                float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (uint32_t c = 0; c < channelCount; c++) {
+                    ax[c] += a * channels[c][i];
+                    bx[c] += b * channels[c][i];
+                }
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f) {
+                return false;
+            }
+            float inverse = 1.0f / determinant;
+            for (uint32_t c = 0; c < channelCount; c++) {
+                e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inverse, 0.0f, 255.0f);
+                e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inverse, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        // Little-endian bit stream of one 128-bit block
+        class BlockBits {
+        public:
+            void Write(uint32_t value, uint32_t bits) {
+                for (uint32_t i = 0; i < bits; i++, m_Position++) {
+                    if ((value >> i) & 1u) {
+                        m_Bytes[m_Position / 8] |= static_cast<uint8_t>(1u << (m_Position % 8));
+                    }
+                }
+            }
+            const uint8_t* GetBytes() const { return m_Bytes; }
+
+        private:
+            uint8_t m_Bytes[16] = {};
+            uint32_t m_Position = 0;
+        };
+
+        // --- BC1: RGB565 endpoints, 2-bit indices ---
+
+        constexpr float BC1Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+        uint16_t PackRgb565(const float* color) {
+            uint32_t r = static_cast<uint32_t>(color[0] * 31.0f / 255.0f + 0.5f);
+            uint32_t g = static_cast<uint32_t>(color[1] * 63.0f / 255.0f + 0.5f);
+            uint32_t b = static_cast<uint32_t>(color[2] * 31.0f / 255.0f + 0.5f);
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void UnpackRgb565(uint16_t packed, float* color) {
+            uint32_t r = (packed >> 11) & 31u;
+            uint32_t g = (packed >> 5) & 63u;
+            uint32_t b = packed & 31u;
+            color[0] = static_cast<float>((r << 3) | (r >> 2));
+            color[1] = static_cast<float>((g << 2) | (g >> 4));
+            color[2] = static_cast<float>((b << 3) | (b >> 2));
+        }
+
+        // Encodes with the given endpoints, swapped in place if the four-color
+        // mode needs them the other way round; returns the error
+        uint32_t EncodeBC1Endpoints(const Block& block, float* e0, float* e1, uint8_t* out, uint8_t* indices) {
+            const float* channels[3] = { block.channel[0], block.channel[1], block.channel[2] };
+            uint16_t c0 = PackRgb565(e0);
+            uint16_t c1 = PackRgb565(e1);
+            if (c0 < c1) {
+                std::swap(c0, c1);
+                std::swap_ranges(e0, e0 + 3, e1);
+            }
+
+            float palette[4 * 4] = {};
+            UnpackRgb565(c0, palette);
+            UnpackRgb565(c1, palette + 4);
+            for (uint32_t c = 0; c < 3; c++) {
+                palette[8 + c] = std::floor((2.0f * palette[c] + palette[4 + c] + 1.0f) / 3.0f);
+                palette[12 + c] = std::floor((palette[c] + 2.0f * palette[4 + c] + 1.0f) / 3.0f);
+            }
+
+            uint32_t error;
+            if (c0 == c1) {
+                // Equal endpoints select the three-color mode; entry 0 is the color either way
+                error = FindNearest(channels, 3, palette, 1, indices);
+            } else {
+                error = FindNearest(channels, 3, palette, 4, indices);
+            }
+
+            uint32_t bits = 0;
+            for (uint32_t i = 0; i < BlockTexels; i++) {
+                bits |= static_cast<uint32_t>(indices[i]) << (2 * i);
+            }
+            std::memcpy(out, &c0, 2);
+            std::memcpy(out + 2, &c1, 2);
+            std::memcpy(out + 4, &bits, 4);
+            return error;
+        }
+
+        void EncodeBC1(const Block& block, uint8_t* out) {
+            const float* channels[3] = { block.channel[0], block.channel[1], block.channel[2] };
+            float e0[4], e1[4];
+            PrincipalEndpoints(channels, 3, e0, e1);
+
+            uint8_t indices[BlockTexels];
+            uint32_t bestError = EncodeBC1Endpoints(block, e0, e1, out, indices);
+            if (bestError > 0 && RefitEndpoints(channels, 3, indices, BC1Weights, e0, e1)) {
+                uint8_t refit[8];
+                if (EncodeBC1Endpoints(block, e0, e1, refit, indices) < bestError) {
+                    std::memcpy(out, refit, sizeof(refit));
+                }
+            }
+        }
+
+        // --- BC4: one channel, 8-bit endpoints, 3-bit indices ---
+
+        constexpr float BC4Weights[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+
+        uint32_t EncodeBC4Endpoints(const float* values, float a0, float a1, uint8_t* out, uint8_t* indices) {
+            uint32_t end0 = static_cast<uint32_t>(a0 + 0.5f);
+            uint32_t end1 = static_cast<uint32_t>(a1 + 0.5f);
+            // end0 > end1 selects the eight-value mode
+            if (end0 < end1) {
+                std::swap(end0, end1);
+            }
+
+            float palette[8 * 4] = {};
+            palette[0] = static_cast<float>(end0);
+            palette[4] = static_cast<float>(end1);
+            for (uint32_t k = 2; k < 8; k++) {
+                palette[k * 4] = static_cast<float>(((8 - k) * end0 + (k - 1) * end1 + 3) / 7);
+            }
+
+            const float* channels[1] = { values };
+            uint32_t error = FindNearest(channels, 1, palette, end0 == end1 ? 1 : 8, indices);
+
+            uint64_t bits = 0;
+            for (uint32_t i = 0; i < BlockTexels; i++) {
+                bits |= static_cast<uint64_t>(indices[i]) << (3 * i);
+            }
+            out[0] = static_cast<uint8_t>(end0);
+            out[1] = static_cast<uint8_t>(end1);
+            for (uint32_t i = 0; i < 6; i++) {
+                out[2 + i] = static_cast<uint8_t>(bits >> (8 * i));
+            }
+            return error;
+        }
+
+        void EncodeBC4(const float* values, uint8_t* out) {
+            float a0 = *std::max_element(values, values + BlockTexels);
+            float a1 = *std::min_element(values, values + BlockTexels);
+
+            uint8_t indices[BlockTexels];
+            uint32_t bestError = EncodeBC4Endpoints(values, a0, a1, out, indices);
+            // Indices are relative to the stored endpoints, which are max then min
+            a0 = out[0];
+            a1 = out[1];
+            const float* channels[1] = { values };
+            if (bestError > 0 && RefitEndpoints(channels, 1, indices, BC4Weights, &a0, &a1)) {
+                uint8_t refit[8];
+                if (EncodeBC4Endpoints(values, a0, a1, refit, indices) < bestError) {
+                    std::memcpy(out, refit, sizeof(refit));
+                }
+            }
+        }
+
+        // --- BC7 mode 6: RGBA 7-bit endpoints with a shared low bit each, 4-bit indices ---
+
+        constexpr uint32_t BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        struct BC7Endpoint {
+            uint32_t value[4];  // 7 bits per channel
+            uint32_t pBit;
+        };
+
+        // Picks the low bit that brings all four channels closest to color
+        BC7Endpoint QuantizeBC7Endpoint(const float* color) {
+            BC7Endpoint best = {};
+            float bestError = std::numeric_limits<float>::max();
+            for (uint32_t pBit = 0; pBit < 2; pBit++) {
+                BC7Endpoint candidate = {};
+                candidate.pBit = pBit;
+                float error = 0.0f;
+                for (uint32_t c = 0; c < 4; c++) {
+                    float q = std::clamp(std::floor((color[c] - pBit) * 0.5f + 0.5f), 0.0f, 127.0f);
+                    candidate.value[c] = static_cast<uint32_t>(q);
+                    float d = (q * 2.0f + pBit) - color[c];
+                    error += d * d;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    best = candidate;
+                }
+            }
+            return best;
+        }
+
+        uint32_t EncodeBC7Endpoints(const Block& block, const float* e0, const float* e1, uint8_t* out, uint8_t* indices) {
+            BC7Endpoint end0 = QuantizeBC7Endpoint(e0);
+            BC7Endpoint end1 = QuantizeBC7Endpoint(e1);
+
+            float palette[16 * 4];
+            for (uint32_t k = 0; k < 16; k++) {
+                for (uint32_t c = 0; c < 4; c++) {
+                    uint32_t a = (end0.value[c] << 1) | end0.pBit;
+                    uint32_t b = (end1.value[c] << 1) | end1.pBit;
+                    palette[k * 4 + c] = static_cast<float>(((64 - BC7Weights[k]) * a + BC7Weights[k] * b + 32) >> 6);
+                }
+            }
+
+            const float* channels[4] = { block.channel[0], block.channel[1], block.channel[2], block.channel[3] };
+            uint32_t error = FindNearest(channels, 4, palette, 16, indices);
+
+            // The first index is stored without its top bit, which must be 0; the
+            // weights are symmetric, so swapping the endpoints mirrors the indices
+            bool swap = indices[0] >= 8;
+            const BC7Endpoint& first = swap ? end1 : end0;
+            const BC7Endpoint& second = swap ? end0 : end1;
+
+            BlockBits bits;
+            bits.Write(1u << 6, 7);
+            for (uint32_t c = 0; c < 4; c++) {
+                bits.Write(first.value[c], 7);
+                bits.Write(second.value[c], 7);
+            }
+            bits.Write(first.pBit, 1);
+            bits.Write(second.pBit, 1);
+            for (uint32_t i = 0; i < BlockTexels; i++) {
+                uint32_t index = swap ? 15u - indices[i] : indices[i];
+                bits.Write(index, i == 0 ? 3 : 4);
+            }
+            std::memcpy(out, bits.GetBytes(), 16);
+            return error;
+        }
+
+        void EncodeBC7(const Block& block, uint8_t* out) {
+            const float* channels[4] = { block.channel[0], block.channel[1], block.channel[2], block.channel[3] };
+            float e0[4], e1[4];
+            PrincipalEndpoints(channels, 4, e0, e1);
+
+            uint8_t indices[BlockTexels];
+            uint32_t bestError = EncodeBC7Endpoints(block, e0, e1, out, indices);
+
+            float weights[16];
+            for (uint32_t k = 0; k < 16; k++) {
+                weights[k] = BC7Weights[k] / 64.0f;
+            }
+            if (bestError > 0 && RefitEndpoints(channels, 4, indices, weights, e0, e1)) {
+                uint8_t refit[16];
+                if (EncodeBC7Endpoints(block, e0, e1, refit, indices) < bestError) {
+                    std::memcpy(out, refit, sizeof(refit));
+                }
+            }
+        }
+
+        void EncodeBlock(TextureFormat format, const Block& block, uint8_t* out) {
+            switch (format) {
+                case TextureFormat::BC1:
+                    EncodeBC1(block, out);
+                    break;
+                case TextureFormat::BC3:
+                    EncodeBC4(block.channel[3], out);
+                    EncodeBC1(block, out + 8);
+                    break;
+                case TextureFormat::BC5:
+                    EncodeBC4(block.channel[0], out);
+                    EncodeBC4(block.channel[1], out + 8);
+                    break;
+                case TextureFormat::BC7:
+                    EncodeBC7(block, out);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+    }
+
+    bool TextureCompressor::CanEncode(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::BC1:
+            case TextureFormat::BC3:
+            case TextureFormat::BC5:
+            case TextureFormat::BC7:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool TextureCompressor::EncodeLevel(TextureFormat format, const uint8_t* pixels, uint32_t width, uint32_t height,
+                                        std::vector<uint8_t>& blocks, ThreadPool& pool) {
+        if (!CanEncode(format) || width == 0 || height == 0) {
+            return false;
+        }
+
+        const uint32_t blocksX = (width + 3) / 4;
+        const uint32_t blocksY = (height + 3) / 4;
+        const size_t blockBytes = GetTextureBlockBytes(format);
+        blocks.resize(GetTextureLevelSize(format, width, height));
+
+        uint8_t* target = blocks.data();
+        pool.ParallelFor(blocksY, [&](uint32_t begin, uint32_t end) {
+            Block block;
+            for (uint32_t blockY = begin; blockY < end; blockY++) {
+                uint8_t* row = target + static_cast<size_t>(blockY) * blocksX * blockBytes;
+                for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+                    LoadBlock(pixels, width, height, blockX, blockY, block);
+                    EncodeBlock(format, block, row + blockX * blockBytes);
+                }
+            }
+        }, 4);
+        return true;
+    }
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include "utils/ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * CPU encoder for the block-compressed texture formats, used to cook
+     * textures offline (see CookedTexture).
+     *
+     * Each 4x4 block gets its endpoints from the principal axis of its texels,
+     * refined once by a least-squares fit to the indices they produced; the
+     * better of the two fits is kept. The nearest palette entry of every texel
+     * is searched with the SIMD lanes, and block rows are spread over the
+     * thread pool. Partial blocks at the right and bottom edges repeat the
+     * last column and row.
+     *
+     * BC7 blocks all use mode 6 (one RGBA subset, 4-bit indices), which keeps
+     * encoding fast at close to the quality of an exhaustive mode search.
+     */
+    class TextureCompressor {
+    public:
+        // BC1, BC3, BC5 and BC7; the other formats can be uploaded but not encoded
+        static bool CanEncode(TextureFormat format);
+
+        // Encodes one RGBA8 level into format blocks, in the level's row order.
+        // BC5 stores red and green. Block rows are split across pool. Returns
+        // false if the format can't be encoded.
+        static bool EncodeLevel(TextureFormat format, const uint8_t* pixels, uint32_t width, uint32_t height,
+                                std::vector<uint8_t>& blocks, ThreadPool& pool);
+    };
+
+}
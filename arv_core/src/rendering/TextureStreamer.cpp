@@ -0,0 +1,154 @@
+#include "TextureStreamer.h"
+#include "Renderer.h"
+#include "ARVBase.h"
+#include "utils/ThreadPool.h"
+
+#include <stb_image.h>
+#include <chrono>
+
+namespace arv {
+
+    // Mid grey, so untextured surfaces stay lit and readable until the image arrives
+    static constexpr uint8_t PlaceholderTexel[4] = { 128, 128, 128, 255 };
+
+    TextureStreamer::TextureStreamer(Renderer* renderer, ThreadPool& pool)
+        : m_Renderer(renderer), m_Pool(pool), m_Queue(std::make_shared<DecodeQueue>()) {
+    }
+
+    TextureStreamer::~TextureStreamer() {
+        std::lock_guard<std::mutex> lock(m_Queue->mutex);
+        if (m_Queue->decoding > 0 || !m_Queue->ready.empty()) {
+            ARV_LOG_INFO("TextureStreamer::~TextureStreamer() - Dropping {} pending textures",
+                         m_Queue->decoding + static_cast<uint32_t>(m_Queue->ready.size()));
+        }
+    }
+
+    std::shared_ptr<Texture2D> TextureStreamer::Load(const std::string& path, const TextureSpecification& spec) {
+        std::shared_ptr<Texture2D> texture = m_Renderer->CreateTexture2D(1, 1, PlaceholderTexel, spec);
+        if (!texture) {
+            return nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Queue->mutex);
+            m_Queue->decoding++;
+        }
+
+        // Formats the backend can't sample stream in as RGBA8
+        bool compressed = IsBlockCompressed(spec.format);
+        if (compressed && !m_Renderer->SupportsTextureFormat(spec.format)) {
+            ARV_LOG_WARN("TextureStreamer::Load() - Backend can't sample {}, streaming {} as RGBA8",
+                         GetTextureFormatName(spec.format), path);
+            compressed = false;
+        }
+        bool bottomUp = m_Renderer->UsesBottomLeftTextureOrigin();
+
+        std::weak_ptr<Texture2D> target = texture;
+        std::shared_ptr<DecodeQueue> queue = m_Queue;
+        m_Pool.Submit([queue, target, path, spec, compressed, bottomUp, &pool = m_Pool]() {
+            DecodedImage image;
+            image.texture = target;
+            image.path = path;
+
+            if (compressed && !target.expired()) {
+                image.cooked = std::make_unique<CookedTexture>();
+                if (!image.cooked->LoadOrCook(path, spec, bottomUp, pool)) {
+                    image.cooked.reset();
+                }
+            }
+
+            // Skip the decode if the texture was released in the meantime
+            if (!image.cooked && !target.expired()) {
+                // Rows stay top to bottom; the flag is per thread, so other
+                // loaders flipping on the main thread don't affect it
+                stbi_set_flip_vertically_on_load_thread(0);
+                int width = 0, height = 0, channels = 0;
+                unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+                if (data) {
+                    image.pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+                    stbi_image_free(data);
+                    image.mips = MipChain::Build(image.pixels.data(), width, height, spec);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->decoding--;
+            queue->ready.push_back(std::move(image));
+            queue->decoded.notify_all();
+        });
+
+        return texture;
+    }
+
+    bool TextureStreamer::UploadNext() {
+        DecodedImage image;
+        {
+            std::lock_guard<std::mutex> lock(m_Queue->mutex);
+            if (m_Queue->ready.empty()) {
+                return false;
+            }
+            image = std::move(m_Queue->ready.front());
+            m_Queue->ready.pop_front();
+        }
+
+        std::shared_ptr<Texture2D> texture = image.texture.lock();
+        if (!texture) {
+            return true;
+        }
+        if (image.cooked) {
+            const CookedTexture& cooked = *image.cooked;
+            texture->SetMipData(cooked.GetLevels(), cooked.GetLevelCount(), cooked.GetFormat());
+            m_Stats.uploaded++;
+            m_Stats.uploadedLastUpdate++;
+            ARV_LOG_INFO("TextureStreamer::UploadNext() - Streamed in {} ({}x{} {}, {} mip levels, {} KB)", image.path,
+                         cooked.GetWidth(), cooked.GetHeight(), GetTextureFormatName(cooked.GetFormat()),
+                         cooked.GetLevelCount(), cooked.GetDataSize() / 1024);
+            return true;
+        }
+        if (image.pixels.empty()) {
+            ARV_LOG_ERROR("TextureStreamer::UploadNext() - Failed to load texture: {}", image.path);
+            m_Stats.failed++;
+            return true;
+        }
+
+        texture->SetMipData(image.mips.GetLevels(), image.mips.GetLevelCount());
+        m_Stats.uploaded++;
+        m_Stats.uploadedLastUpdate++;
+        ARV_LOG_INFO("TextureStreamer::UploadNext() - Streamed in {} ({}x{}, {} mip levels)", image.path,
+                     texture->GetWidth(), texture->GetHeight(), image.mips.GetLevelCount());
+        return true;
+    }
+
+    void TextureStreamer::Update(float budgetMs) {
+        auto start = std::chrono::steady_clock::now();
+        auto elapsedMs = [&]() {
+            return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        m_Stats.uploadedLastUpdate = 0;
+        while (UploadNext()) {
+            if (elapsedMs() >= budgetMs) {
+                break;
+            }
+        }
+        m_Stats.uploadMsLastUpdate = elapsedMs();
+    }
+
+    void TextureStreamer::Flush() {
+        {
+            std::unique_lock<std::mutex> lock(m_Queue->mutex);
+            m_Queue->decoded.wait(lock, [this]() { return m_Queue->decoding == 0; });
+        }
+        m_Stats.uploadedLastUpdate = 0;
+        while (UploadNext()) {
+        }
+    }
+
+    TextureStreamerStats TextureStreamer::GetStats() const {
+        TextureStreamerStats stats = m_Stats;
+        std::lock_guard<std::mutex> lock(m_Queue->mutex);
+        stats.pending = m_Queue->decoding + static_cast<uint32_t>(m_Queue->ready.size());
+        return stats;
+    }
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include "rendering/CookedTexture.h"
+#include "rendering/MipChain.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    class Renderer;
+    class ThreadPool;
+
+    struct TextureStreamerStats {
+        uint32_t pending = 0;            // Requested and not yet uploaded
+        uint32_t uploadedLastUpdate = 0;
+        float uploadMsLastUpdate = 0.0f;
+        uint32_t uploaded = 0;           // Since the streamer was created
+        uint32_t failed = 0;
+    };
+
+    /**
+     * Loads image textures without blocking the render thread.
+     *
+     * Load() hands out a 1x1 placeholder texture right away and decodes the
+     * file, and builds its mip chain, on the given thread pool. Block-compressed
+     * formats are mapped from their CookedTexture, or cooked, there as well. Update(), called once per frame on the render
+     * thread, uploads decoded images into their textures until the frame's
+     * upload budget is spent, so a burst of loads is spread over several
+     * frames instead of stalling one. Textures released before their image
+     * is ready are skipped.
+     */
+    class TextureStreamer {
+    public:
+        static constexpr float DefaultUploadBudgetMs = 2.0f;
+        // Workers of the pool ARVApplication creates for the streamer; decodes
+        // are kept off ThreadPool::Global(), which the frame's work runs on
+        static constexpr uint32_t DefaultThreadCount = 2;
+
+        TextureStreamer(Renderer* renderer, ThreadPool& pool);
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        std::shared_ptr<Texture2D> Load(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+
+        // At least one image is uploaded per call, however large
+        void Update(float budgetMs = DefaultUploadBudgetMs);
+
+        // Waits for every pending decode and uploads all of them, e.g. before a capture
+        void Flush();
+
+        TextureStreamerStats GetStats() const;
+
+    private:
+        struct DecodedImage {
+            std::weak_ptr<Texture2D> texture;
+            std::string path;
+            std::vector<uint8_t> pixels;  // RGBA8, rows top to bottom; empty if decoding failed
+            MipChain mips;                // Level 0 points into pixels
+            std::unique_ptr<CookedTexture> cooked;  // Instead of pixels and mips for compressed formats
+        };
+
+        // Shared with the decode jobs, which may finish after the streamer is gone
+        struct DecodeQueue {
+            std::mutex mutex;
+            std::condition_variable decoded;
+            std::deque<DecodedImage> ready;
+            uint32_t decoding = 0;
+        };
+
+        bool UploadNext();
+
+        Renderer* m_Renderer;
+        ThreadPool& m_Pool;
+        std::shared_ptr<DecodeQueue> m_Queue;
+        TextureStreamerStats m_Stats;
+    };
+
+}
@@ -0,0 +1,106 @@
+#include "UniformSet.h"
+#include "utils/SourceStamp.h"
+
+namespace arv {
+
+    namespace {
+
+        template<typename Values, typename T>
+        void SetValue(Values& values, const UniformId& id, const T& value) {
+            for (auto& entry : values) {
+                if (entry.id.hash == id.hash && entry.id.name == id.name) {
+                    entry.value = value;
+                    return;
+                }
+            }
+            values.push_back({id, value});
+        }
+
+        template<typename Values>
+        void HashValues(const Values& values, std::vector<std::byte>& bytes) {
+            // The count keeps values of different types from hashing alike
+            uint32_t count = static_cast<uint32_t>(values.size());
+            const auto* countBytes = reinterpret_cast<const std::byte*>(&count);
+            bytes.insert(bytes.end(), countBytes, countBytes + sizeof(count));
+            for (const auto& entry : values) {
+                const auto* hash = reinterpret_cast<const std::byte*>(&entry.id.hash);
+                const auto* value = reinterpret_cast<const std::byte*>(&entry.value);
+                bytes.insert(bytes.end(), hash, hash + sizeof(entry.id.hash));
+                bytes.insert(bytes.end(), value, value + sizeof(entry.value));
+            }
+        }
+
+    }
+
+    void UniformSet::SetInt(const UniformId& id, int value) {
+        SetValue(m_Ints, id, value);
+        UpdateHash();
+    }
+
+    void UniformSet::SetFloat(const UniformId& id, float value) {
+        SetValue(m_Floats, id, value);
+        UpdateHash();
+    }
+
+    void UniformSet::SetFloat2(const UniformId& id, const glm::vec2& value) {
+        SetValue(m_Float2s, id, value);
+        UpdateHash();
+    }
+
+    void UniformSet::SetFloat3(const UniformId& id, const glm::vec3& value) {
+        SetValue(m_Float3s, id, value);
+        UpdateHash();
+    }
+
+    void UniformSet::SetFloat4(const UniformId& id, const glm::vec4& value) {
+        SetValue(m_Float4s, id, value);
+        UpdateHash();
+    }
+
+    void UniformSet::SetMat3(const UniformId& id, const glm::mat3& value) {
+        SetValue(m_Mat3s, id, value);
+        UpdateHash();
+    }
+
+    void UniformSet::SetMat4(const UniformId& id, const glm::mat4& value) {
+        SetValue(m_Mat4s, id, value);
+        UpdateHash();
+    }
+
+    void UniformSet::Apply(Shader& shader) const {
+        for (const auto& entry : m_Ints) {
+            shader.UploadUniformInt(entry.id, entry.value);
+        }
+        for (const auto& entry : m_Floats) {
+            shader.UploadUniformFloat(entry.id, entry.value);
+        }
+        for (const auto& entry : m_Float2s) {
+            shader.UploadUniformFloat2(entry.id, entry.value);
+        }
+        for (const auto& entry : m_Float3s) {
+            shader.UploadUniformFloat3(entry.id, entry.value);
+        }
+        for (const auto& entry : m_Float4s) {
+            shader.UploadUniformFloat4(entry.id, entry.value);
+        }
+        for (const auto& entry : m_Mat3s) {
+            shader.UploadUniformMat3(entry.id, entry.value);
+        }
+        for (const auto& entry : m_Mat4s) {
+            shader.UploadUniformMat4(entry.id, entry.value);
+        }
+    }
+
+    void UniformSet::UpdateHash() {
+        std::vector<std::byte> bytes;
+        HashValues(m_Ints, bytes);
+        HashValues(m_Floats, bytes);
+        HashValues(m_Float2s, bytes);
+        HashValues(m_Float3s, bytes);
+        HashValues(m_Float4s, bytes);
+        HashValues(m_Mat3s, bytes);
+        HashValues(m_Mat4s, bytes);
+        m_Hash = HashBytes(bytes.data(), bytes.size());
+    }
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "rendering/Shader.h"
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace arv {
+
+    /**
+     * Uniform values that belong to one object rather than to its shader, so
+     * objects can share a program from the ShaderLibrary and still differ in
+     * e.g. color. Scene uploads them right before each draw of the object;
+     * backends snapshot uniforms in Draw(), so the next object's values don't
+     * leak into this one's draw.
+     *
+     * Ids are stored as given, so their names must outlive the set: declare
+     * them static constexpr like the other UniformIds.
+     */
+    class UniformSet {
+    public:
+        void SetInt(const UniformId& id, int value);
+        void SetFloat(const UniformId& id, float value);
+        void SetFloat2(const UniformId& id, const glm::vec2& value);
+        void SetFloat3(const UniformId& id, const glm::vec3& value);
+        void SetFloat4(const UniformId& id, const glm::vec4& value);
+        void SetMat3(const UniformId& id, const glm::mat3& value);
+        void SetMat4(const UniformId& id, const glm::mat4& value);
+
+        bool IsEmpty() const {
+            return m_Ints.empty() && m_Floats.empty() && m_Float2s.empty() && m_Float3s.empty() &&
+                   m_Float4s.empty() && m_Mat3s.empty() && m_Mat4s.empty();
+        }
+
+        void Apply(Shader& shader) const;
+
+        // Equal for sets with the same values set in the same order, 0 when empty;
+        // objects are only merged into one instanced draw if this matches.
+        // Computed when a value is set, so reading it per frame is free.
+        uint64_t GetHash() const { return m_Hash; }
+
+    private:
+        void UpdateHash();
+
+        template<typename T>
+        struct Value {
+            UniformId id;
+            T value;
+        };
+
+        std::vector<Value<int>> m_Ints;
+        std::vector<Value<float>> m_Floats;
+        std::vector<Value<glm::vec2>> m_Float2s;
+        std::vector<Value<glm::vec3>> m_Float3s;
+        std::vector<Value<glm::vec4>> m_Float4s;
+        std::vector<Value<glm::mat3>> m_Mat3s;
+        std::vector<Value<glm::mat4>> m_Mat4s;
+        uint64_t m_Hash = 0;
+    };
+
+}
@@ -0,0 +1,58 @@
+#include "FrameArena.h"
+#include "ARVBase.h"
+
+#include <algorithm>
+
+namespace arv {
+
+    FrameArena::FrameArena(size_t initialSize)
+    {
+        AddBlock(std::max<size_t>(initialSize, 1024));
+    }
+
+    void FrameArena::AddBlock(size_t size)
+    {
+        Block block;
+        block.data = std::make_unique<std::byte[]>(size);
+        block.size = size;
+        m_Blocks.push_back(std::move(block));
+        m_Capacity += size;
+        m_Offset = 0;
+    }
+
+    void* FrameArena::Allocate(size_t size, size_t alignment)
+    {
+        Block* block = &m_Blocks.back();
+        uintptr_t base = reinterpret_cast<uintptr_t>(block->data.get());
+        size_t aligned = ((base + m_Offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+
+        if (aligned + size > block->size)
+        {
+            // Chain a block at least as large as everything so far, so the number of blocks stays small
+            AddBlock(std::max(m_Capacity, size + alignment));
+            block = &m_Blocks.back();
+            base = reinterpret_cast<uintptr_t>(block->data.get());
+            aligned = ((base + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+        }
+
+        m_Used += (aligned - m_Offset) + size;
+        m_HighWater = std::max(m_HighWater, m_Used);
+        m_Offset = aligned + size;
+        return block->data.get() + aligned;
+    }
+
+    void FrameArena::Reset()
+    {
+        if (m_Blocks.size() > 1)
+        {
+            size_t capacity = m_Capacity;
+            ARV_LOG_INFO("FrameArena::Reset() - Merging {} blocks into one of {} bytes", m_Blocks.size(), capacity);
+            m_Blocks.clear();
+            m_Capacity = 0;
+            AddBlock(capacity);
+        }
+        m_Offset = 0;
+        m_Used = 0;
+    }
+
+}
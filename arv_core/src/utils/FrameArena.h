@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * Linear allocator for data that lives for one frame.
+     *
+     * Allocation bumps a pointer; Reset() releases everything at once and never
+     * runs destructors, so only trivially destructible types may be placed in it.
+     * When a frame outgrows the current block another block is chained on, and
+     * the next Reset() merges them into one block of the combined size. After a
+     * few frames the arena therefore stops touching the heap.
+     */
+    class FrameArena {
+    public:
+        explicit FrameArena(size_t initialSize = 64 * 1024);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T, typename... Args>
+        T* New(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+            return new (Allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+        }
+
+        // Uninitialized storage for count elements
+        template<typename T>
+        T* AllocateArray(size_t count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        void Reset();
+
+        size_t GetUsed() const { return m_Used; }
+        size_t GetHighWater() const { return m_HighWater; }
+        size_t GetCapacity() const { return m_Capacity; }
+        uint32_t GetBlockCount() const { return static_cast<uint32_t>(m_Blocks.size()); }
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size = 0;
+        };
+
+        void AddBlock(size_t size);
+
+        std::vector<Block> m_Blocks;
+        size_t m_Offset = 0;      // Into the last block
+        size_t m_Used = 0;        // Bytes handed out since Reset(), including padding
+        size_t m_HighWater = 0;
+        size_t m_Capacity = 0;
+    };
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace arv {
+
+    /**
+     * Read-only memory mapping of a whole file.
+     *
+     * Pages are faulted in on first access and belong to the OS page cache, so
+     * keeping a mapping open is cheap and a second map of the same file costs
+     * almost nothing. The mapping is private: writing through it is undefined.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Maps path, closing any previous mapping. Empty files fail to map.
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        const std::byte* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        const std::byte* m_Data = nullptr;
+        size_t m_Size = 0;
+    };
+
+}
@@ -0,0 +1,134 @@
+#include "SourceStamp.h"
+#include "MappedFile.h"
+#include "ARVBase.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+namespace arv {
+
+    namespace {
+
+        bool ReadSizeAndTime(const std::string& path, SourceStamp& stamp)
+        {
+            std::error_code error;
+            uintmax_t size = std::filesystem::file_size(path, error);
+            if (error) {
+                return false;
+            }
+            auto modified = std::filesystem::last_write_time(path, error);
+            if (error) {
+                return false;
+            }
+            stamp.size = static_cast<uint64_t>(size);
+            stamp.modifiedTime = static_cast<int64_t>(modified.time_since_epoch().count());
+            return true;
+        }
+
+        bool HashFile(const std::string& path, uint64_t& hash)
+        {
+            MappedFile source;
+            if (!source.Open(path)) {
+                return false;
+            }
+            hash = HashBytes(source.GetData(), source.GetSize());
+            return true;
+        }
+
+        std::string MakeTempPath(const std::string& path)
+        {
+            // Random per process, counted per call, so no two writers share a name
+            static const uint64_t processSalt = (uint64_t(std::random_device()()) << 32) ^
+                static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            static std::atomic<uint64_t> counter{0};
+
+            char suffix[48];
+            std::snprintf(suffix, sizeof(suffix), ".%016llx-%llu.tmp", static_cast<unsigned long long>(processSalt),
+                          static_cast<unsigned long long>(counter.fetch_add(1, std::memory_order_relaxed)));
+            return path + suffix;
+        }
+
+    }
+
+    uint64_t HashBytes(const std::byte* data, size_t size)
+    {
+        constexpr uint64_t K1 = 0x9E3779B97F4A7C15ull;
+        constexpr uint64_t K2 = 0xC2B2AE3D27D4EB4Full;
+
+        uint64_t hash = K1 ^ size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            hash ^= word * K2;
+            hash = ((hash << 31) | (hash >> 33)) * K1;
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, data + i, size - i);
+        hash ^= tail * K2;
+
+        hash ^= hash >> 33;
+        hash *= K2;
+        hash ^= hash >> 29;
+        return hash;
+    }
+
+    bool SourceStamp::Read(const std::string& path, SourceStamp& stamp)
+    {
+        return ReadSizeAndTime(path, stamp) && HashFile(path, stamp.hash);
+    }
+
+    bool SourceStamp::Matches(const std::string& path) const
+    {
+        SourceStamp current;
+        if (!ReadSizeAndTime(path, current)) {
+            return true;
+        }
+        if (current.size != size) {
+            return false;
+        }
+        if (current.modifiedTime != modifiedTime) {
+            // Touched or copied: only the content decides
+            return HashFile(path, current.hash) && current.hash == hash;
+        }
+        return true;
+    }
+
+    bool WriteCacheFile(const std::string& path, const std::function<void(std::ostream&)>& write)
+    {
+        std::string tempPath = MakeTempPath(path);
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                ARV_LOG_WARN("WriteCacheFile() - Cannot create {}", tempPath);
+                return false;
+            }
+
+            // Closed here so errors of the final flush are seen before the rename
+            write(out);
+            out.close();
+            if (out.fail()) {
+                ARV_LOG_WARN("WriteCacheFile() - Failed writing {}", tempPath);
+                std::error_code ignored;
+                std::filesystem::remove(tempPath, ignored);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error) {
+            ARV_LOG_WARN("WriteCacheFile() - Cannot replace {}: {}", path, error.message());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+}
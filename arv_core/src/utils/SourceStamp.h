@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace arv {
+
+    // 64-bit hash over 8-byte words; only used to tell whether a touched source changed
+    uint64_t HashBytes(const std::byte* data, size_t size);
+
+    // Cache files (.arvmesh, .arvtex, .arvhdr, .arvcube, .arvprog) are stored in
+    // the byte order of the machine that wrote them; a cache from a machine with
+    // a different order fails its magic check. Sections start at this alignment
+    // so they can be read in place from the mapping.
+    constexpr uint64_t SectionAlignment = 16;
+
+    inline uint64_t AlignSection(uint64_t offset)
+    {
+        return (offset + SectionAlignment - 1) & ~(SectionAlignment - 1);
+    }
+
+    // Whether an aligned section of size bytes at offset lies inside the file
+    inline bool SectionInFile(uint64_t offset, uint64_t size, uint64_t fileSize)
+    {
+        return offset % SectionAlignment == 0 && offset <= fileSize && size <= fileSize - offset;
+    }
+
+    // Writes a cache file under a temporary name unique to this call and renames
+    // it over path, so readers never see half a file and processes or threads
+    // cooking the same source don't write into each other's output. A stream
+    // left failed by write aborts and removes the temporary file. A failed
+    // write only costs the caller cooking again next time.
+    bool WriteCacheFile(const std::string& path, const std::function<void(std::ostream&)>& write);
+
+    /**
+     * Version of a source file a cache was cooked from (see CookedMesh,
+     * CookedTexture). Size and modification time are checked first; the
+     * content hash only decides when the file was touched or copied.
+     */
+    struct SourceStamp {
+        uint64_t size = 0;
+        int64_t modifiedTime = 0;
+        uint64_t hash = 0;
+
+        // Stamp of the file at path as it is on disk now
+        static bool Read(const std::string& path, SourceStamp& stamp);
+
+        // Whether the file at path is still the stamped one. A missing source
+        // means the cache was shipped on its own, which counts as a match.
+        bool Matches(const std::string& path) const;
+    };
+
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <chrono>
+
+namespace arv {
+
+    // Wall time elapsed since start, for load and cook timings in the log
+    inline double MillisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
@@ -0,0 +1,126 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace arv {
+
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        m_Workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++) {
+            m_Workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_Condition.notify_all();
+
+        for (auto& worker : m_Workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    ThreadPool& ThreadPool::Global()
+    {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Jobs.push_back(std::move(job));
+        }
+        m_Condition.notify_one();
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+                if (m_Stopping && m_Jobs.empty()) {
+                    return;
+                }
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t, uint32_t)>& func,
+                                 uint32_t minChunkSize)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        // Over-split a little so uneven chunks balance out across workers
+        uint32_t targetChunks = (GetThreadCount() + 1) * 4;
+        uint32_t chunkSize = std::max(std::max(minChunkSize, 1u), (count + targetChunks - 1) / targetChunks);
+        uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if (chunkCount == 1) {
+            func(0, count);
+            return;
+        }
+
+        // Shared state lives on the heap so helper jobs that start late never
+        // touch a dead stack frame; they simply find no chunks left.
+        struct Range {
+            std::atomic<uint32_t> nextChunk{0};
+            std::atomic<uint32_t> finishedChunks{0};
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        auto range = std::make_shared<Range>();
+
+        auto runChunks = [range, &func, count, chunkSize, chunkCount]() {
+            while (true) {
+                uint32_t chunk = range->nextChunk.fetch_add(1);
+                if (chunk >= chunkCount) {
+                    return;
+                }
+                uint32_t begin = chunk * chunkSize;
+                uint32_t end = std::min(count, begin + chunkSize);
+                func(begin, end);
+                if (range->finishedChunks.fetch_add(1) + 1 == chunkCount) {
+                    std::lock_guard<std::mutex> lock(range->mutex);
+                    range->done.notify_all();
+                }
+            }
+        };
+
+        uint32_t helpers = std::min(GetThreadCount(), chunkCount - 1);
+        for (uint32_t i = 0; i < helpers; i++) {
+            Enqueue(runChunks);
+        }
+
+        runChunks();
+
+        // Every chunk is claimed by now, so the rest are running on workers.
+        // Only this range is helped with: an unrelated queued job (e.g. a
+        // texture decode) could take far longer than the range itself.
+        std::unique_lock<std::mutex> lock(range->mutex);
+        range->done.wait(lock, [&range, chunkCount]() {
+            return range->finishedChunks.load() >= chunkCount;
+        });
+    }
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * Fixed-size worker pool used by the CPU-heavy parts of the engine
+     * (software rasterization, asset decoding, mesh processing).
+     *
+     * Tasks are plain std::function jobs pulled from a shared FIFO queue.
+     * ParallelFor() lets the calling thread work on the range as well, so it
+     * is safe to call from inside a task without dead-locking the pool. The
+     * caller never runs other queued jobs, so long Submit() jobs can't stall it.
+     */
+    class ThreadPool {
+    public:
+        // threadCount == 0 uses std::thread::hardware_concurrency()
+        explicit ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Shared engine-wide pool, created on first use
+        static ThreadPool& Global();
+
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+        // Enqueue a job and get a future for its result
+        template<typename F>
+        auto Submit(F&& func) -> std::future<decltype(func())>
+        {
+            using ResultType = decltype(func());
+            auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(func));
+            std::future<ResultType> result = task->get_future();
+            Enqueue([task]() { (*task)(); });
+            return result;
+        }
+
+        // Splits [0, count) into chunks of at least minChunkSize and calls
+        // func(begin, end) for each chunk in parallel. Blocks until all chunks are done.
+        void ParallelFor(uint32_t count, const std::function<void(uint32_t, uint32_t)>& func,
+                         uint32_t minChunkSize = 1);
+
+    private:
+        void Enqueue(std::function<void()> job);
+        void WorkerLoop();
+
+        std::vector<std::thread> m_Workers;
+        std::deque<std::function<void()>> m_Jobs;
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        bool m_Stopping = false;
+    };
+
+}
@@ -1,4 +1,6 @@
 #define TINYEXR_USE_MINIZ 0
+// Chunks (scanline blocks or tiles) are decompressed on worker threads
+#define TINYEXR_USE_THREAD 1
 #include <zlib.h>
 #define TINYEXR_IMPLEMENTATION
 #include <tinyexr.h>
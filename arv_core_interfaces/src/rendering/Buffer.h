@@ -7,7 +7,10 @@ namespace arv {
 
     enum class ShaderDataType
     {
-        None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool
+        None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool,
+        // 16-bit vertex attribute types. Shaders read them as floats; Short/UShort
+        // map to [-1, 1] / [0, 1] when the element is Normalized.
+        Half2, Half4, Short2, Short4, UShort2, UShort4
     };
     static unsigned int ShaderDataTypeSize(ShaderDataType type)
     {
@@ -24,6 +27,12 @@ namespace arv {
             case ShaderDataType::Int3:     return 4 * 3;
             case ShaderDataType::Int4:     return 4 * 4;
             case ShaderDataType::Bool:     return 1;
+            case ShaderDataType::Half2:    return 2 * 2;
+            case ShaderDataType::Half4:    return 2 * 4;
+            case ShaderDataType::Short2:   return 2 * 2;
+            case ShaderDataType::Short4:   return 2 * 4;
+            case ShaderDataType::UShort2:  return 2 * 2;
+            case ShaderDataType::UShort4:  return 2 * 4;
         }
         return 0;
     }
@@ -54,6 +63,12 @@ namespace arv {
                 case ShaderDataType::Int3:    return 3;
                 case ShaderDataType::Int4:    return 4;
                 case ShaderDataType::Bool:    return 1;
+                case ShaderDataType::Half2:   return 2;
+                case ShaderDataType::Half4:   return 4;
+                case ShaderDataType::Short2:  return 2;
+                case ShaderDataType::Short4:  return 4;
+                case ShaderDataType::UShort2: return 2;
+                case ShaderDataType::UShort4: return 4;
             }
         //GATE_ASSERT(false, "Unknown ShaderDataType!");
         return 0;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <glm/glm.hpp>
 #include "rendering/Buffer.h"
@@ -8,6 +9,7 @@
 #include "rendering/ShaderSource.h"
 #include "rendering/Texture.h"
 #include "rendering/Framebuffer.h"
+#include "rendering/UniformBuffer.h"
 #include "platform/PlatformApplicationContext.h"
 
 namespace arv
@@ -16,7 +18,40 @@ namespace arv
     {
         None = 0,
         OpenGL,
-        Metal
+        Metal,
+        Software
+    };
+
+    // Ordering hint for backends that sort their draw queue before executing it.
+    // Passes run in this order; Transparent and Overlay draws are sorted back to front.
+    enum class DrawPass : uint8_t
+    {
+        Background = 0,
+        Opaque,
+        Transparent,
+        Overlay
+    };
+
+    // Per-frame counters reported by backends that track them
+    struct RenderStats
+    {
+        uint32_t drawCalls = 0;
+        uint32_t shaderBinds = 0;
+        uint32_t vertexArrayBinds = 0;
+        uint32_t textureBinds = 0;
+        uint32_t stateChangesSkipped = 0;
+        uint32_t instancedDraws = 0;
+        uint32_t instances = 0;
+        uint32_t queueMemoryUsed = 0;       // Bytes of draw queue memory used by the frame
+        uint32_t queueMemoryHighWater = 0;  // Most queue memory any frame has used
+    };
+
+    // Per-instance attributes for DrawInstanced(). Shaders read them in their
+    // ARV_INSTANCED variant: model matrix at locations 8-11, tint at location 12.
+    struct InstanceData
+    {
+        glm::mat4 model = glm::mat4(1.0f);
+        glm::vec4 tint = glm::vec4(1.0f);
     };
 
     class RenderingAPI
@@ -33,6 +68,29 @@ namespace arv
         virtual void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray) = 0;
         virtual void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture) = 0;
 
+        // Draws only the given range of the vertex array's indices; texture may be nullptr
+        virtual void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                          const std::shared_ptr<Texture2D>& texture, const IndexRange& range) = 0;
+
+        // Draws the range of the vertex array once per instance with viewProjection * instance.model.
+        // Backends with hardware instancing override this for shaders that report
+        // SupportsInstancing(); this fallback issues one Draw() per instance through
+        // u_mvp and the object uniforms and ignores the tint.
+        virtual void DrawInstanced(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                   const std::shared_ptr<Texture2D>& texture, const InstanceData* instances,
+                                   uint32_t instanceCount, const glm::mat4& viewProjection,
+                                   const IndexRange& range = IndexRange())
+        {
+            static constexpr UniformId MvpUniform("u_mvp");
+            for (uint32_t i = 0; i < instanceCount; i++)
+            {
+                glm::mat4 mvp = viewProjection * instances[i].model;
+                shader->UploadUniformMat4(MvpUniform, mvp);
+                SetObjectUniforms({instances[i].model, mvp});
+                Draw(shader, vertexArray, texture, range);
+            }
+        }
+
         virtual void SetClearColor(const glm::vec4& color) = 0;
         virtual void Clear() = 0;
 
@@ -43,12 +101,51 @@ namespace arv
         // Default implementation does nothing
         virtual void FlushDrawCommands() {}
 
+        // Pass used for subsequent Draw() calls (ignored by backends that draw immediately)
+        void SetDrawPass(DrawPass pass) { m_DrawPass = pass; }
+        DrawPass GetDrawPass() const { return m_DrawPass; }
+
+        // Built-in uniform blocks (see UniformBuffer.h). Frame uniforms apply to every
+        // following draw; object uniforms only to the next Draw(). Backends without
+        // uniform buffers ignore both, so shaders for them keep using plain uniforms.
+        virtual void SetFrameUniforms(const FrameUniforms& uniforms) {}
+        virtual void SetObjectUniforms(const ObjectUniforms& uniforms) {}
+
+        // Stats of the last completed frame, all zero if the backend doesn't track them
+        const RenderStats& GetRenderStats() const { return m_RenderStats; }
+
         virtual std::shared_ptr<VertexBuffer> CreateVertexBuffer(float* vertices, unsigned int size) = 0;
         virtual std::shared_ptr<IndexBuffer> CreateIndexBuffer(unsigned int* indices, unsigned int size) = 0;
         virtual std::shared_ptr<VertexArray> CreateVertexArray() = 0;
         virtual std::shared_ptr<Shader> CreateShader(ShaderSource* shaderSource) = 0;
-        virtual std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path) = 0;
+        // Mips, filtering and wrapping follow spec; the default builds the full mip chain
+        virtual std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path,
+                                                           const TextureSpecification& spec = TextureSpecification()) = 0;
+        // From 8-bit RGBA texels, rows top to bottom (see Texture2D::SetData())
+        virtual std::shared_ptr<Texture2D> CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                           const TextureSpecification& spec = TextureSpecification()) = 0;
         virtual std::shared_ptr<Texture2D> CreateHDRTexture2D(const std::string& path) = 0;
+        // Equirectangular EXR as a mip-mapped RGBA16F cubemap, converted once and
+        // cached next to the source (see HDRCubemap)
+        virtual std::shared_ptr<TextureCube> CreateHDRTextureCube(const std::string& path) = 0;
         virtual std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferSpecification& spec) = 0;
+
+        // nullptr if the backend has no uniform buffers
+        virtual std::shared_ptr<UniformBuffer> CreateUniformBuffer(uint32_t size) { return nullptr; }
+
+        // Whether vertex buffer layouts may use the 16-bit ShaderDataTypes; by
+        // default only the 32-bit ones are supported
+        virtual bool SupportsVertexType(ShaderDataType type) const { return type < ShaderDataType::Half2; }
+
+        // Whether textures may use the format; by default only RGBA8
+        virtual bool SupportsTextureFormat(TextureFormat format) const { return format == TextureFormat::RGBA8; }
+
+        // Whether texture row 0 is the bottom one. Backends that flip RGBA8 data
+        // on upload can't flip compressed blocks, so those are cooked bottom-up.
+        virtual bool UsesBottomLeftTextureOrigin() const { return false; }
+
+    protected:
+        DrawPass m_DrawPass = DrawPass::Opaque;
+        RenderStats m_RenderStats;
     };
 }
@@ -1,12 +1,35 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <map>
 #include <glm/glm.hpp>
 #include "ShaderSource.h"
 
 namespace arv {
 
+    // FNV-1a hash of a uniform name
+    constexpr uint32_t UniformNameHash(std::string_view name)
+    {
+        uint32_t hash = 2166136261u;
+        for (char c : name)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        return hash;
+    }
+
+    // Uniform name with its hash computed up front. Declare fixed names as
+    // static constexpr so backends can find the uniform without string work:
+    //     static constexpr UniformId MvpUniform("u_mvp");
+    struct UniformId {
+        std::string_view name;
+        uint32_t hash;
+
+        constexpr explicit UniformId(std::string_view uniformName) : name(uniformName), hash(UniformNameHash(uniformName)) {}
+    };
+
     class Shader {
     public:
         Shader(ShaderSource* shaderSource) : m_ShaderSource(shaderSource) {}
@@ -19,6 +42,9 @@ namespace arv {
         virtual void Destroy() = 0;
         virtual void Use() = 0;
 
+        // True if the backend built an instanced variant usable by RenderingAPI::DrawInstanced()
+        virtual bool SupportsInstancing() const { return false; }
+
         virtual void UploadUniformInt(const std::string& name, int value) = 0;
 
         virtual void UploadUniformFloat(const std::string& name, float value) = 0;
@@ -29,6 +55,18 @@ namespace arv {
         virtual void UploadUniformMat3(const std::string& name, const glm::mat3& matrix) = 0;
         virtual void UploadUniformMat4(const std::string& name, const glm::mat4& matrix) = 0;
 
+        // UniformId overloads. Backends that cache uniforms by hash override these;
+        // the defaults forward to the name-based versions.
+        virtual void UploadUniformInt(const UniformId& id, int value) { UploadUniformInt(std::string(id.name), value); }
+
+        virtual void UploadUniformFloat(const UniformId& id, float value) { UploadUniformFloat(std::string(id.name), value); }
+        virtual void UploadUniformFloat2(const UniformId& id, const glm::vec2& value) { UploadUniformFloat2(std::string(id.name), value); }
+        virtual void UploadUniformFloat3(const UniformId& id, const glm::vec3& value) { UploadUniformFloat3(std::string(id.name), value); }
+        virtual void UploadUniformFloat4(const UniformId& id, const glm::vec4& value) { UploadUniformFloat4(std::string(id.name), value); }
+
+        virtual void UploadUniformMat3(const UniformId& id, const glm::mat3& matrix) { UploadUniformMat3(std::string(id.name), matrix); }
+        virtual void UploadUniformMat4(const UniformId& id, const glm::mat4& matrix) { UploadUniformMat4(std::string(id.name), matrix); }
+
         // Accessors for stored uniforms (used by rendering backends)
         // Maps are ordered alphabetically by name for deterministic buffer packing
         const std::map<std::string, int>& GetIntUniforms() const { return m_IntUniforms; }
@@ -7,7 +7,8 @@ namespace arv {
     /**
      * ShaderSource is an abstract class for providing shader source code.
      * Implementations (like CoreShaderSource) parse and provide shaders
-     * for multiple rendering APIs (OpenGL GLSL and Metal MSL).
+     * for multiple rendering APIs (OpenGL GLSL, Metal MSL and the
+     * fixed-function description used by the software rasterizer).
      * Each rendering backend uses GetSource() with the appropriate key
      * to retrieve its shader code at runtime.
      */
@@ -1,9 +1,102 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace arv {
 
+    enum class TextureFilter {
+        Nearest = 0,
+        Linear,     // Bilinear in the closest mip level
+        Trilinear   // Bilinear in the two closest mip levels, blended
+    };
+
+    enum class TextureWrap {
+        ClampToEdge = 0,
+        Repeat
+    };
+
+    // GPU storage formats. The block-compressed ones store 4x4 texel blocks;
+    // RenderingAPI::SupportsTextureFormat() tells which a backend can sample.
+    enum class TextureFormat : uint32_t {
+        RGBA8 = 0,
+        BC1,        // RGB, 4 bits per texel
+        BC3,        // RGBA, 8 bits per texel
+        BC5,        // Two channels (e.g. normal map XY), 8 bits per texel
+        BC6H,       // HDR RGB as unsigned half floats, 8 bits per texel
+        BC7,        // RGBA, 8 bits per texel, best quality of the BC formats
+        ETC2_RGB8,  // Mobile GPUs: RGB, 4 bits per texel
+        ETC2_RGBA8, // Mobile GPUs: RGBA, 8 bits per texel
+        ASTC_4x4    // Mobile GPUs: RGBA, 8 bits per texel
+    };
+
+    inline bool IsBlockCompressed(TextureFormat format) {
+        return format != TextureFormat::RGBA8;
+    }
+
+    // Bytes of one 4x4 block, or of one texel for RGBA8
+    inline uint32_t GetTextureBlockBytes(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::RGBA8: return 4;
+            case TextureFormat::BC1:
+            case TextureFormat::ETC2_RGB8: return 8;
+            default: return 16;
+        }
+    }
+
+    // Bytes of one width x height mip level; partial blocks at the edges count in full
+    inline size_t GetTextureLevelSize(TextureFormat format, uint32_t width, uint32_t height) {
+        if (!IsBlockCompressed(format)) {
+            return static_cast<size_t>(width) * height * 4;
+        }
+        return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetTextureBlockBytes(format);
+    }
+
+    // Bytes from one row of texels (or of blocks) to the next
+    inline size_t GetTextureRowPitch(TextureFormat format, uint32_t width) {
+        if (!IsBlockCompressed(format)) {
+            return static_cast<size_t>(width) * 4;
+        }
+        return static_cast<size_t>((width + 3) / 4) * GetTextureBlockBytes(format);
+    }
+
+    inline const char* GetTextureFormatName(TextureFormat format) {
+        switch (format) {
+            case TextureFormat::RGBA8: return "RGBA8";
+            case TextureFormat::BC1: return "BC1";
+            case TextureFormat::BC3: return "BC3";
+            case TextureFormat::BC5: return "BC5";
+            case TextureFormat::BC6H: return "BC6H";
+            case TextureFormat::BC7: return "BC7";
+            case TextureFormat::ETC2_RGB8: return "ETC2_RGB8";
+            case TextureFormat::ETC2_RGBA8: return "ETC2_RGBA8";
+            case TextureFormat::ASTC_4x4: return "ASTC_4x4";
+        }
+        return "Unknown";
+    }
+
+    struct TextureSpecification {
+        TextureFilter filter = TextureFilter::Trilinear;
+        TextureWrap wrap = TextureWrap::ClampToEdge;
+        uint32_t mipLevels = 0;        // 0 for the full chain down to 1x1, 1 for no mips
+        float maxAnisotropy = 8.0f;    // 1 turns anisotropic filtering off; clamped to what the device supports
+        // Texels are sRGB-encoded color, so mips are averaged in linear light.
+        // Storage and sampling keep the 8-bit encoding the shaders work in.
+        // Turn off for data such as normal maps.
+        bool srgb = true;
+        // Block-compressed formats are cooked from the image file into a
+        // .arvtex next to it on first load (see CookedTexture)
+        TextureFormat format = TextureFormat::RGBA8;
+    };
+
+    // One level of a mip chain, rows (of blocks, if compressed) top to bottom
+    struct TextureMipLevel {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        const void* pixels = nullptr;
+    };
+
     class Texture2D {
     public:
         virtual ~Texture2D() = default;
@@ -14,6 +107,26 @@ namespace arv {
         virtual unsigned int GetWidth() const = 0;
         virtual unsigned int GetHeight() const = 0;
         virtual unsigned int GetChannels() const = 0;
+
+        // Replaces the contents and size with 8-bit RGBA texels, rows top to bottom
+        // as image files store them, and rebuilds the mips the specification asks
+        // for. Used to swap streamed images in; textures that can't be updated
+        // (e.g. HDR) ignore it.
+        virtual void SetData(const void* pixels, unsigned int width, unsigned int height) {}
+
+        // Like SetData() with the mips already built (see MipChain), level 0 first.
+        // Compressed levels are uploaded as they are; the format must be one
+        // the backend supports.
+        virtual void SetMipData(const TextureMipLevel* levels, uint32_t levelCount,
+                                TextureFormat format = TextureFormat::RGBA8) {}
+    };
+
+    // Six square faces in the order +X, -X, +Y, -Y, +Z, -Z, sampled by
+    // direction (samplerCube in GLSL, texturecube in MSL). Drawn through the
+    // same Draw() calls as 2D textures; width and height are the face size.
+    class TextureCube : public Texture2D {
+    public:
+        virtual uint32_t GetLevelCount() const = 0;
     };
 
 }
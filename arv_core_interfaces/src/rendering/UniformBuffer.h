@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace arv {
+
+    // Binding points of the built-in uniform blocks. Shaders declare them as
+    //     layout(std140) uniform ArvFrame { ... };
+    //     layout(std140) uniform ArvObject { ... };
+    // with members in the order of the structs below.
+    enum UniformBlockBinding : uint32_t
+    {
+        FrameBlockBinding = 0,
+        ObjectBlockBinding = 1
+    };
+
+    // Per-frame block, std140. Only vec4/mat4 members so the C++ layout matches
+    // without padding.
+    struct FrameUniforms
+    {
+        glm::mat4 view = glm::mat4(1.0f);
+        glm::mat4 projection = glm::mat4(1.0f);
+        glm::mat4 viewProjection = glm::mat4(1.0f);
+        glm::vec4 cameraPosition = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        glm::vec4 time = glm::vec4(0.0f);  // x = seconds since start
+    };
+    static_assert(sizeof(FrameUniforms) == 3 * 64 + 2 * 16, "FrameUniforms must match the std140 layout");
+
+    // Per-object block, std140
+    struct ObjectUniforms
+    {
+        glm::mat4 model = glm::mat4(1.0f);
+        glm::mat4 mvp = glm::mat4(1.0f);
+    };
+    static_assert(sizeof(ObjectUniforms) == 2 * 64, "ObjectUniforms must match the std140 layout");
+
+    class UniformBuffer
+    {
+    public:
+        virtual ~UniformBuffer() = default;
+
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+
+        // Binds the whole buffer, or a range of it, to a uniform block binding point
+        virtual void Bind(uint32_t binding) const = 0;
+        virtual void BindRange(uint32_t binding, uint32_t offset, uint32_t size) const = 0;
+
+        virtual uint32_t GetSize() const = 0;
+    };
+
+}
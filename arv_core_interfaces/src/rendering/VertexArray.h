@@ -1,9 +1,19 @@
 #pragma once
 
 #include "Buffer.h"
+#include <cstdint>
 
 namespace arv {
 
+    // Slice of a vertex array's index buffer for RenderingAPI's ranged draws, e.g.
+    // one material of a mesh that keeps all materials in one vertex and index
+    // buffer. Counts past the end of the buffer are clamped, so the default
+    // range draws everything.
+    struct IndexRange
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = ~0u;
+    };
 
     class VertexArray
     {
@@ -0,0 +1,36 @@
+project "obj-parser-bench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir "bin/%{cfg.buildcfg}"
+    objdir "obj/%{cfg.buildcfg}"
+
+    files { "src/ObjParserBench.cpp" }
+
+    includedirs {
+        "../arv_core_interfaces/src",
+        "../arv_core/src",
+        "../providers/headless_software_provider/src"
+    }
+
+    sysincludedirs {
+        GLM_INCLUDE_DIR,
+        TINYOBJLOADER_INCLUDE_DIR
+    }
+
+    -- The provider uses arv_core, so it comes first for single-pass linkers
+    links {
+        "arv_headless_software_provider",
+        "arv_core"
+    }
+
+    filter "system:linux"
+        links { "pthread" }
+
+    filter "configurations:Debug"
+        symbols "On"
+
+    -- Timings are only meaningful in Release
+    filter "configurations:Release"
+        optimize "On"
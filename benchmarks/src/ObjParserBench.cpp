@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ARVApplication.h"
+#include "ARVBase.h"
+#include "HeadlessSoftwarePlatformProvider.h"
+#include "rendering/ObjParser.h"
+#include "utils/Stopwatch.h"
+#include "utils/ThreadPool.h"
+
+// ObjParser.cpp compiles the tinyobjloader implementation into arv_core
+#include "tiny_obj_loader.h"
+
+// Times the tinyobjloader path ObjAssetRO used before ObjParser against
+// ObjParser::Parse() on one OBJ, with pools of increasing size:
+//     obj-parser-bench path/to/model.obj --iterations 10 --workers 1,4,16
+// Both sides produce the interleaved CookedMesh layout, so the times include
+// vertex deduplication, and the outputs are compared before timing.
+struct Options {
+    std::string objPath;
+    uint32_t iterations = 5;
+    std::vector<uint32_t> workerCounts;
+};
+
+static void PrintUsage()
+{
+    std::cerr << "Usage: obj-parser-bench <file.obj> [--iterations N] [--workers N,N,...]\n"
+                 "  --iterations N     Timed runs per configuration, the median is reported (default 5)\n"
+                 "  --workers N,...    ThreadPool sizes for ObjParser (default 1, 2, 4, ... up to the\n"
+                 "                     hardware threads); the calling thread works as well\n";
+}
+
+static bool ParseCount(const char* text, uint32_t& value)
+{
+    char* end = nullptr;
+    unsigned long parsed = std::strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || parsed == 0 || parsed > 1024) {
+        return false;
+    }
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+static bool ParseCountList(const std::string& text, std::vector<uint32_t>& values)
+{
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = std::min(text.find(',', start), text.size());
+        uint32_t value = 0;
+        if (!ParseCount(text.substr(start, comma - start).c_str(), value)) {
+            return false;
+        }
+        values.push_back(value);
+        start = comma + 1;
+    }
+    return !values.empty();
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--iterations" && hasValue) {
+            if (!ParseCount(argv[++i], options.iterations)) {
+                return false;
+            }
+        } else if (arg == "--workers" && hasValue) {
+            if (!ParseCountList(argv[++i], options.workerCounts)) {
+                return false;
+            }
+        } else if (!arg.empty() && arg[0] != '-' && options.objPath.empty()) {
+            options.objPath = arg;
+        } else {
+            return false;
+        }
+    }
+
+    if (options.workerCounts.empty()) {
+        uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t count = 1; count < hardwareThreads; count *= 2) {
+            options.workerCounts.push_back(count);
+        }
+        options.workerCounts.push_back(hardwareThreads);
+    }
+    return !options.objPath.empty();
+}
+
+// Open-addressing (linear probing) map from an OBJ position/texcoord/normal
+// index triple to a vertex index. Keys are stored inline, so lookups don't
+// allocate; the table doubles when it is 70% full. Unchanged from
+// ObjAssetRO before ObjParser replaced it.
+class VertexKeyTable {
+public:
+    explicit VertexKeyTable(size_t expectedCount) {
+        size_t capacity = 16;
+        while (capacity * 7 < expectedCount * 10) {
+            capacity *= 2;
+        }
+        m_Slots.resize(capacity);
+    }
+
+    // Returns the vertex of the triple, inserting newVertex if it isn't known yet
+    uint32_t FindOrInsert(int position, int texcoord, int normal, uint32_t newVertex) {
+        if ((m_Count + 1) * 10 > m_Slots.size() * 7) {
+            Grow();
+        }
+
+        size_t mask = m_Slots.size() - 1;
+        for (size_t i = Hash(position, texcoord, normal) & mask;; i = (i + 1) & mask) {
+            Slot& slot = m_Slots[i];
+            if (slot.vertex == EmptySlot) {
+                slot = {position, texcoord, normal, newVertex};
+                m_Count++;
+                return newVertex;
+            }
+            if (slot.position == position && slot.texcoord == texcoord && slot.normal == normal) {
+                return slot.vertex;
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t EmptySlot = ~0u;
+
+    struct Slot {
+        int position = 0;
+        int texcoord = 0;
+        int normal = 0;
+        uint32_t vertex = EmptySlot;
+    };
+
+    static size_t Hash(int position, int texcoord, int normal) {
+        uint32_t h = static_cast<uint32_t>(position) * 0x9E3779B1u;
+        h ^= static_cast<uint32_t>(texcoord) * 0x85EBCA77u;
+        h ^= static_cast<uint32_t>(normal) * 0xC2B2AE3Du;
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        return h;
+    }
+
+    void Grow() {
+        std::vector<Slot> old(m_Slots.size() * 2);
+        old.swap(m_Slots);
+        size_t mask = m_Slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.vertex == EmptySlot) {
+                continue;
+            }
+            size_t i = Hash(slot.position, slot.texcoord, slot.normal) & mask;
+            while (m_Slots[i].vertex != EmptySlot) {
+                i = (i + 1) & mask;
+            }
+            m_Slots[i] = slot;
+        }
+    }
+
+    std::vector<Slot> m_Slots;
+    size_t m_Count = 0;
+};
+
+// The former ObjAssetRO::CookObj() front end: tinyobj::LoadObj(), then a serial
+// deduplication in order of first use. Triangles are then stably grouped by
+// material the way ObjParser does, so both index buffers can be compared
+static bool LoadWithTinyObj(const std::string& path, arv::ObjMeshData& outMesh)
+{
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string warn, err;
+
+    size_t slash = path.find_last_of("/\\");
+    std::string directory = slash == std::string::npos ? "" : path.substr(0, slash + 1);
+    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str(), directory.c_str())) {
+        ARV_LOG_ERROR("obj-parser-bench - tinyobjloader cannot load {}: {}", path, err);
+        return false;
+    }
+
+    size_t indexCount = 0;
+    for (const auto& shape : shapes) {
+        indexCount += shape.mesh.indices.size();
+    }
+
+    std::vector<float>& vertices = outMesh.vertices;
+    vertices.clear();
+    vertices.reserve(std::min(indexCount, attrib.vertices.size() / 3 * 2) * 8);
+    std::vector<uint32_t> indices;
+    indices.reserve(indexCount);
+    std::vector<int> triangleMaterials;
+    triangleMaterials.reserve(indexCount / 3);
+
+    VertexKeyTable uniqueVertices(indexCount / 6);
+    for (const auto& shape : shapes) {
+        for (int material : shape.mesh.material_ids) {
+            triangleMaterials.push_back(material);
+        }
+
+        for (const auto& index : shape.mesh.indices) {
+            uint32_t nextVertex = static_cast<uint32_t>(vertices.size() / 8);
+            uint32_t vertex = uniqueVertices.FindOrInsert(index.vertex_index, index.texcoord_index, index.normal_index, nextVertex);
+            if (vertex == nextVertex) {
+                vertices.insert(vertices.end(), &attrib.vertices[3 * index.vertex_index], &attrib.vertices[3 * index.vertex_index] + 3);
+                if (index.texcoord_index >= 0) {
+                    vertices.insert(vertices.end(), &attrib.texcoords[2 * index.texcoord_index], &attrib.texcoords[2 * index.texcoord_index] + 2);
+                } else {
+                    vertices.insert(vertices.end(), {0.0f, 0.0f});
+                }
+                if (index.normal_index >= 0) {
+                    vertices.insert(vertices.end(), &attrib.normals[3 * index.normal_index], &attrib.normals[3 * index.normal_index] + 3);
+                } else {
+                    vertices.insert(vertices.end(), {0.0f, 1.0f, 0.0f});
+                }
+            }
+            indices.push_back(vertex);
+        }
+    }
+
+    std::vector<uint32_t> order(triangleMaterials.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return triangleMaterials[a] < triangleMaterials[b];
+    });
+    outMesh.indices.clear();
+    outMesh.indices.reserve(indices.size());
+    for (uint32_t triangle : order) {
+        outMesh.indices.insert(outMesh.indices.end(), indices.begin() + 3 * triangle, indices.begin() + 3 * triangle + 3);
+    }
+
+    outMesh.positionCount = static_cast<uint32_t>(attrib.vertices.size() / 3);
+    outMesh.texcoordCount = static_cast<uint32_t>(attrib.texcoords.size() / 2);
+    outMesh.normalCount = static_cast<uint32_t>(attrib.normals.size() / 3);
+    return true;
+}
+
+static bool SameMesh(const arv::ObjMeshData& expected, const arv::ObjMeshData& actual)
+{
+    if (expected.vertices.size() != actual.vertices.size() || expected.indices.size() != actual.indices.size()) {
+        std::cout << "Mismatch:      tinyobjloader " << expected.vertices.size() / 8 << " vertices / "
+                  << expected.indices.size() << " indices, ObjParser " << actual.vertices.size() / 8 << " / "
+                  << actual.indices.size() << "\n";
+        return false;
+    }
+    // Compared bitwise, both sides must parse every number to the same float
+    if (std::memcmp(expected.vertices.data(), actual.vertices.data(), expected.vertices.size() * sizeof(float)) != 0 ||
+        expected.indices != actual.indices) {
+        std::cout << "Mismatch:      same counts, different vertex or index data\n";
+        return false;
+    }
+    return true;
+}
+
+// Median of `iterations` timed runs, after one untimed run that warms the page cache
+template<typename F>
+static double MedianMilliseconds(uint32_t iterations, F&& run)
+{
+    run();
+    std::vector<double> times;
+    times.reserve(iterations);
+    for (uint32_t i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        times.push_back(arv::MillisecondsSince(start));
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    // Only for the logger, nothing is rendered
+    if (!arv::ARVApplication::Create(std::make_unique<arv::HeadlessSoftwarePlatformProvider>())) {
+        return 1;
+    }
+
+    arv::ObjMeshData reference;
+    arv::ObjMeshData mesh;
+    if (!LoadWithTinyObj(options.objPath, reference) || !arv::ObjParser::Parse(options.objPath, mesh)) {
+        arv::ARVApplication::Destroy();
+        return 1;
+    }
+
+    std::cout << "File:          " << options.objPath << "\n"
+              << "Hardware:      " << std::thread::hardware_concurrency() << " threads\n"
+              << "Attributes:    " << reference.positionCount << " positions, " << reference.texcoordCount
+                                   << " texcoords, " << reference.normalCount << " normals\n";
+    bool identical = SameMesh(reference, mesh);
+    std::cout << "Output:        " << mesh.vertices.size() / 8 << " vertices, " << mesh.indices.size() / 3
+                                   << " triangles" << (identical ? ", identical to tinyobjloader" : "") << "\n\n";
+
+    double tinyObjMs = MedianMilliseconds(options.iterations, [&]() { LoadWithTinyObj(options.objPath, reference); });
+    std::cout << std::left << std::setw(24) << "tinyobjloader" << tinyObjMs << " ms\n";
+
+    for (uint32_t workers : options.workerCounts) {
+        arv::ThreadPool pool(workers);
+        double parserMs = MedianMilliseconds(options.iterations, [&]() { arv::ObjParser::Parse(options.objPath, mesh, pool); });
+        std::string label = "ObjParser, " + std::to_string(workers) + (workers == 1 ? " worker" : " workers");
+        std::cout << std::setw(24) << label << parserMs << " ms  (" << tinyObjMs / parserMs << "x)\n";
+    }
+
+    arv::ARVApplication::Destroy();
+    return identical ? 0 : 2;
+}
@@ -11,6 +11,21 @@ include "vendor/tinyobjloader"
 
 include "arv_core_interfaces"
 include "arv_core"
-include "providers/macos_opengl_provider"
-include "providers/macos_metal_provider"
-include "arv-studio"
+include "providers/headless_software_provider"
+include "arv-headless"
+
+newoption {
+    trigger = "with-benchmarks",
+    description = "Also generate the benchmark tools in benchmarks/"
+}
+
+if _OPTIONS["with-benchmarks"] then
+    include "benchmarks"
+end
+
+-- The window providers and the studio need Cocoa, OpenGL and Metal
+if os.target() == "macosx" then
+    include "providers/macos_opengl_provider"
+    include "providers/macos_metal_provider"
+    include "arv-studio"
+end
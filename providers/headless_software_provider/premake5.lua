@@ -0,0 +1,31 @@
+project "arv_headless_software_provider"
+    kind "StaticLib"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir "bin/%{cfg.buildcfg}"
+    objdir "obj/%{cfg.buildcfg}"
+
+    files { "src/**.cpp", "src/**.h" }
+
+    includedirs {
+        "src",
+        "../../arv_core_interfaces/src",
+        "../../arv_core/src"
+    }
+
+    sysincludedirs {
+        GLM_INCLUDE_DIR,
+        STB_INCLUDE_DIR,
+        path.getabsolute("../../arv_core/vendor/tinyexr"),
+        path.getabsolute("../../arv_core/vendor/nlohmann")
+    }
+
+    filter "system:linux"
+        links { "pthread" }
+
+    filter "configurations:Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        optimize "On"
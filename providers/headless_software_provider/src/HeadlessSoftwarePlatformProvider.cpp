@@ -0,0 +1,41 @@
+#include "HeadlessSoftwarePlatformProvider.h"
+#include "rendering/SoftwareRenderingAPI.h"
+#include "ARVBase.h"
+#include <memory>
+
+namespace arv
+{
+    HeadlessSoftwarePlatformProvider::HeadlessSoftwarePlatformProvider(const HeadlessCanvasSpecification& spec)
+    {
+        m_canvas = std::make_unique<HeadlessCanvas>(spec);
+        m_renderingAPI = std::make_unique<SoftwareRenderingAPI>();
+    }
+
+    HeadlessSoftwarePlatformProvider::~HeadlessSoftwarePlatformProvider() = default;
+
+    void HeadlessSoftwarePlatformProvider::Init(PlatformApplicationContext* context)
+    {
+        ARV_LOG_INFO("HeadlessSoftwarePlatformProvider::Init() - Initializing headless software platform provider");
+
+        auto* canvas = static_cast<HeadlessCanvas*>(m_canvas.get());
+        auto* renderingAPI = static_cast<SoftwareRenderingAPI*>(m_renderingAPI.get());
+
+        ARV_LOG_INFO("HeadlessSoftwarePlatformProvider::Init() - Initializing canvas");
+        const HeadlessCanvasSpecification& spec = canvas->GetSpecification();
+        renderingAPI->ResizeDefaultTarget(spec.width, spec.height);
+        canvas->SetRenderTarget(&renderingAPI->GetDefaultTarget());
+        canvas->Init(context);
+
+        // Keep the default target in sync with the virtual window size
+        context->GetEventManager()->AddListener(EventType::ApplicationResizeEvent, [renderingAPI](Event& event) {
+            auto* resizeEvent = static_cast<ApplicationResizeEvent*>(&event);
+            renderingAPI->ResizeDefaultTarget(resizeEvent->GetWidth(), resizeEvent->GetHeight());
+            return false;
+        });
+
+        ARV_LOG_INFO("HeadlessSoftwarePlatformProvider::Init() - Initializing rendering API");
+        m_renderingAPI->Init(context);
+        ARV_LOG_INFO("HeadlessSoftwarePlatformProvider::Init() - Headless software platform provider initialized");
+    }
+
+}
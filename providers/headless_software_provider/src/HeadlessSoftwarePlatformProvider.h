@@ -0,0 +1,16 @@
+#pragma once
+#include "PlatformProvider.h"
+#include "platform/HeadlessCanvas.h"
+
+namespace arv
+{
+    // GPU-less, window-less provider: HeadlessCanvas + SoftwareRenderingAPI
+    class HeadlessSoftwarePlatformProvider : public PlatformProvider
+    {
+    public:
+        HeadlessSoftwarePlatformProvider(const HeadlessCanvasSpecification& spec = HeadlessCanvasSpecification());
+        ~HeadlessSoftwarePlatformProvider() override;
+
+        void Init(PlatformApplicationContext* context) override;
+    };
+}
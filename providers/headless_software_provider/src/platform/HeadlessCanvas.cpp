@@ -0,0 +1,105 @@
+#include "HeadlessCanvas.h"
+#include "rendering/SoftwareRasterizer.h"
+#include "ARVBase.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace arv
+{
+    HeadlessCanvas::HeadlessCanvas(const HeadlessCanvasSpecification& spec)
+        : m_Specification(spec)
+    {
+    }
+
+    HeadlessCanvas::~HeadlessCanvas()
+    {
+        Destroy();
+    }
+
+    void HeadlessCanvas::Init(PlatformApplicationContext* context)
+    {
+        m_EventManager = context->GetEventManager();
+        m_FrameCount = 0;
+        m_CloseRequested = false;
+
+        // No keyboard on a render node
+        m_EventManager->SetKeyPressedPollCallback([](int& keycode) {
+            return false;
+        });
+
+        ARV_LOG_INFO("HeadlessCanvas::Init() - Headless canvas created ({}x{})", m_Specification.width, m_Specification.height);
+    }
+
+    void HeadlessCanvas::PollEvents()
+    {
+    }
+
+    void HeadlessCanvas::SwapBuffers()
+    {
+        m_FrameCount++;
+
+        if (m_Target && m_Specification.captureEveryNthFrame > 0 && !m_Specification.outputDirectory.empty() &&
+            m_FrameCount % m_Specification.captureEveryNthFrame == 0)
+        {
+            char fileName[32];
+            std::snprintf(fileName, sizeof(fileName), "frame_%05u.ppm", m_FrameCount);
+            std::string path = m_Specification.outputDirectory + "/" + fileName;
+            if (!WriteFrame(path))
+            {
+                ARV_LOG_ERROR("HeadlessCanvas::SwapBuffers() - Failed to write frame {}", path);
+            }
+        }
+    }
+
+    void HeadlessCanvas::Destroy()
+    {
+        m_CloseRequested = true;
+    }
+
+    bool HeadlessCanvas::ShouldClose()
+    {
+        return m_CloseRequested ||
+               (m_Specification.maxFrames > 0 && m_FrameCount >= m_Specification.maxFrames);
+    }
+
+    void HeadlessCanvas::Resize(uint32_t width, uint32_t height)
+    {
+        m_Specification.width = width;
+        m_Specification.height = height;
+
+        if (m_EventManager)
+        {
+            ApplicationResizeEvent event(static_cast<int>(width), static_cast<int>(height));
+            m_EventManager->PushEvent(event);
+        }
+    }
+
+    bool HeadlessCanvas::WriteFrame(const std::string& path) const
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            return false;
+        }
+
+        std::fprintf(file, "P6\n%u %u\n255\n", m_Target->width, m_Target->height);
+
+        // Targets are stored bottom-up, PPM is top-down
+        std::vector<uint8_t> row(static_cast<size_t>(m_Target->width) * 3);
+        for (uint32_t y = m_Target->height; y-- > 0;)
+        {
+            const uint32_t* pixels = m_Target->color.data() + static_cast<size_t>(y) * m_Target->width;
+            for (uint32_t x = 0; x < m_Target->width; x++)
+            {
+                row[x * 3 + 0] = static_cast<uint8_t>(pixels[x] & 0xFF);
+                row[x * 3 + 1] = static_cast<uint8_t>((pixels[x] >> 8) & 0xFF);
+                row[x * 3 + 2] = static_cast<uint8_t>((pixels[x] >> 16) & 0xFF);
+            }
+            std::fwrite(row.data(), 1, row.size(), file);
+        }
+
+        std::fclose(file);
+        return true;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "platform/Canvas.h"
+#include <cstdint>
+#include <string>
+
+namespace arv
+{
+    struct SoftwareRenderTarget;
+
+    struct HeadlessCanvasSpecification
+    {
+        uint32_t width = 1280;
+        uint32_t height = 720;
+        uint32_t maxFrames = 0;           // ShouldClose() after this many frames, 0 = never
+        std::string outputDirectory;      // Where captured frames are written, empty = no capture
+        uint32_t captureEveryNthFrame = 0; // 0 = no capture
+    };
+
+    /**
+     * Window-less canvas. SwapBuffers() only counts frames and optionally
+     * writes the default render target to <outputDirectory>/frame_NNNNN.ppm.
+     */
+    class HeadlessCanvas : public Canvas
+    {
+    public:
+        HeadlessCanvas(const HeadlessCanvasSpecification& spec);
+        ~HeadlessCanvas() override;
+
+        void Init(PlatformApplicationContext* context) override;
+        void PollEvents() override;
+        void SwapBuffers() override;
+        void Destroy() override;
+        bool ShouldClose() override;
+        void* GetNativeWindow() const override { return nullptr; }
+
+        void SetRenderTarget(SoftwareRenderTarget* target) { m_Target = target; }
+
+        // Changes the virtual window size and notifies listeners like a real window would
+        void Resize(uint32_t width, uint32_t height);
+
+        uint32_t GetFrameCount() const { return m_FrameCount; }
+        const HeadlessCanvasSpecification& GetSpecification() const { return m_Specification; }
+
+    private:
+        bool WriteFrame(const std::string& path) const;
+
+        HeadlessCanvasSpecification m_Specification;
+        SoftwareRenderTarget* m_Target = nullptr;  // Non-owning, owned by SoftwareRenderingAPI
+        EventManager* m_EventManager = nullptr;
+        uint32_t m_FrameCount = 0;
+        bool m_CloseRequested = false;
+    };
+}
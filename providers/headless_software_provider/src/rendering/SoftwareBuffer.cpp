@@ -0,0 +1,28 @@
+#include "SoftwareBuffer.h"
+#include "ARVBase.h"
+#include <cstring>
+
+namespace arv {
+
+    /////////////////////////////////////////////////////////////////////////////
+    // VertexBuffer /////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+    SoftwareVertexBuffer::SoftwareVertexBuffer(float* vertices, unsigned int size)
+        : m_Data(size)
+    {
+        if (vertices && size > 0)
+        {
+            std::memcpy(m_Data.data(), vertices, size);
+        }
+        ARV_LOG_INFO("SoftwareVertexBuffer::SoftwareVertexBuffer() - Created vertex buffer with {} bytes", size);
+    }
+    /////////////////////////////////////////////////////////////////////////////
+    // IndexBuffer //////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+    SoftwareIndexBuffer::SoftwareIndexBuffer(unsigned int* indices, unsigned int count)
+        : m_Indices(indices, indices + count)
+    {
+        ARV_LOG_INFO("SoftwareIndexBuffer::SoftwareIndexBuffer() - Created index buffer with {} indices", count);
+    }
+
+}
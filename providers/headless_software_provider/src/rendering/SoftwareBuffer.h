@@ -0,0 +1,41 @@
+#pragma once
+
+#include "rendering/Buffer.h"
+#include <cstdint>
+#include <vector>
+
+namespace arv {
+
+    // Vertex data stays in system memory; the rasterizer reads it directly
+    class SoftwareVertexBuffer : public VertexBuffer
+    {
+    public:
+        SoftwareVertexBuffer(float* vertices, unsigned int size);
+        virtual ~SoftwareVertexBuffer() = default;
+        virtual void Bind() const override {}
+        virtual void Unbind() const override {}
+
+        virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+        virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+        const uint8_t* GetData() const { return m_Data.data(); }
+        unsigned int GetSize() const { return static_cast<unsigned int>(m_Data.size()); }
+    private:
+        std::vector<uint8_t> m_Data;
+        BufferLayout m_Layout;
+    };
+    class SoftwareIndexBuffer : public IndexBuffer
+    {
+    public:
+        SoftwareIndexBuffer(unsigned int* indices, unsigned int count);
+        virtual ~SoftwareIndexBuffer() = default;
+        virtual void Bind() const override {}
+        virtual void Unbind() const override {}
+        virtual unsigned int GetCount() const override { return static_cast<unsigned int>(m_Indices.size()); }
+
+        const uint32_t* GetData() const { return m_Indices.data(); }
+    private:
+        std::vector<uint32_t> m_Indices;
+    };
+
+}
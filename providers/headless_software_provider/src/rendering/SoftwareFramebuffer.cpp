@@ -0,0 +1,50 @@
+#include "SoftwareFramebuffer.h"
+#include "SoftwareRenderingAPI.h"
+#include "ARVBase.h"
+
+namespace arv {
+
+    SoftwareFramebuffer::SoftwareFramebuffer(const FramebufferSpecification& spec, SoftwareRenderingAPI* renderingAPI)
+        : m_RenderingAPI(renderingAPI), m_Specification(spec)
+    {
+        ARV_LOG_INFO("SoftwareFramebuffer::SoftwareFramebuffer() - Creating framebuffer {}x{} with {} color attachments",
+                     spec.width, spec.height, spec.colorAttachments.size());
+        m_Target.Resize(spec.width, spec.height);
+    }
+
+    SoftwareFramebuffer::~SoftwareFramebuffer()
+    {
+        ARV_LOG_INFO("SoftwareFramebuffer::~SoftwareFramebuffer() - Destroying framebuffer {}x{}",
+                     m_Specification.width, m_Specification.height);
+        m_RenderingAPI->ReleaseRenderTarget(&m_Target);
+    }
+
+    void SoftwareFramebuffer::Bind()
+    {
+        m_RenderingAPI->SetRenderTarget(&m_Target);
+    }
+
+    void SoftwareFramebuffer::Unbind()
+    {
+        m_RenderingAPI->SetRenderTarget(nullptr);
+    }
+
+    void SoftwareFramebuffer::Resize(uint32_t width, uint32_t height)
+    {
+        ARV_LOG_INFO("SoftwareFramebuffer::Resize() - Resizing from {}x{} to {}x{}",
+                     m_Specification.width, m_Specification.height, width, height);
+        if (width == 0 || height == 0 || width > 8192 || height > 8192)
+        {
+            ARV_LOG_ERROR("SoftwareFramebuffer::Resize() - Invalid dimensions: {}x{}", width, height);
+            return;
+        }
+
+        // Pending draws still point at this target; run them before the storage is reallocated
+        m_RenderingAPI->FlushDrawCommands();
+
+        m_Specification.width = width;
+        m_Specification.height = height;
+        m_Target.Resize(width, height);
+    }
+
+}
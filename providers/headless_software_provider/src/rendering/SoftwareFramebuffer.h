@@ -0,0 +1,40 @@
+#pragma once
+
+#include "rendering/Framebuffer.h"
+#include "SoftwareRasterizer.h"
+
+namespace arv {
+
+    class SoftwareRenderingAPI;
+
+    /**
+     * Offscreen target for the software rasterizer. Bind() redirects subsequent
+     * Clear()/Draw() calls of the owning SoftwareRenderingAPI into this target.
+     * Only an RGBA8 color surface is kept regardless of the requested formats.
+     */
+    class SoftwareFramebuffer : public Framebuffer {
+    public:
+        SoftwareFramebuffer(const FramebufferSpecification& spec, SoftwareRenderingAPI* renderingAPI);
+        ~SoftwareFramebuffer();
+
+        void Bind() override;
+        void Unbind() override;
+
+        void Resize(uint32_t width, uint32_t height) override;
+
+        // There is no GPU texture behind a software framebuffer; use GetRenderTarget()
+        uint32_t GetColorAttachmentID(uint32_t index = 0) const override { return 0; }
+        uint32_t GetWidth() const override { return m_Specification.width; }
+        uint32_t GetHeight() const override { return m_Specification.height; }
+
+        const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+        const SoftwareRenderTarget& GetRenderTarget() const { return m_Target; }
+
+    private:
+        SoftwareRenderingAPI* m_RenderingAPI;  // Non-owning pointer
+        SoftwareRenderTarget m_Target;
+        FramebufferSpecification m_Specification;
+    };
+
+}
@@ -0,0 +1,26 @@
+#include "SoftwareHDRTexture.h"
+#include "ARVBase.h"
+#include "math/VertexPacking.h"
+#include "rendering/HDRImage.h"
+
+namespace arv {
+
+    SoftwareHDRTexture2D::SoftwareHDRTexture2D(const std::string& path)
+    {
+        HDRImage image;
+        if (!image.Load(path)) {
+            ARV_LOG_ERROR("Failed to load EXR texture: {}", path);
+            return;
+        }
+
+        m_Width = image.GetWidth();
+        m_Height = image.GetHeight();
+        m_Channels = 4;
+
+        m_TexelsF.resize(static_cast<size_t>(m_Width) * m_Height * 4);
+        HalfToFloat(image.GetTexels(), m_TexelsF.data(), m_TexelsF.size());
+
+        ARV_LOG_INFO("Software HDR texture loaded: {} ({}x{})", path, m_Width, m_Height);
+    }
+
+}
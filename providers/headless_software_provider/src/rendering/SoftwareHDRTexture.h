@@ -0,0 +1,14 @@
+#pragma once
+
+#include "SoftwareTexture.h"
+#include <string>
+
+namespace arv {
+
+    class SoftwareHDRTexture2D : public SoftwareTexture2D {
+    public:
+        SoftwareHDRTexture2D(const std::string& path);
+        ~SoftwareHDRTexture2D() override = default;
+    };
+
+}
@@ -0,0 +1,24 @@
+#include "SoftwareHDRTextureCube.h"
+#include "ARVBase.h"
+#include "math/VertexPacking.h"
+
+namespace arv {
+
+    SoftwareHDRTextureCube::SoftwareHDRTextureCube(const std::string& path)
+    {
+        HDRCubemap cubemap;
+        if (!cubemap.Load(path)) {
+            ARV_LOG_ERROR("Failed to load HDR cubemap: {}", path);
+            return;
+        }
+
+        m_FaceSize = cubemap.GetFaceSize();
+
+        // The faces of a level are contiguous, so level 0 converts in one go
+        m_TexelsF.resize(static_cast<size_t>(HDRCubemap::FaceCount) * m_FaceSize * m_FaceSize * 4);
+        HalfToFloat(cubemap.GetFace(0, 0), m_TexelsF.data(), m_TexelsF.size());
+
+        ARV_LOG_INFO("Software HDR cubemap loaded: {} ({}x{} faces)", path, m_FaceSize, m_FaceSize);
+    }
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include "rendering/HDRCubemap.h"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * HDR cubemap sampled by the rasterizer's cubemap program. Only level 0
+     * is kept, as RGBA32F, like SoftwareHDRTexture2D.
+     */
+    class SoftwareHDRTextureCube : public TextureCube {
+    public:
+        SoftwareHDRTextureCube(const std::string& path);
+        ~SoftwareHDRTextureCube() override = default;
+
+        void Bind(unsigned int slot = 0) const override {}
+        void Unbind() const override {}
+
+        unsigned int GetWidth() const override { return m_FaceSize; }
+        unsigned int GetHeight() const override { return m_FaceSize; }
+        unsigned int GetChannels() const override { return 4; }
+        uint32_t GetLevelCount() const override { return m_FaceSize > 0 ? 1 : 0; }
+
+        // Bilinear sample of the face the direction points into, clamped at its edges
+        glm::vec4 Sample(const glm::vec3& direction) const
+        {
+            if (m_FaceSize == 0) {
+                return glm::vec4(0.0f);
+            }
+
+            float s, t;
+            uint32_t face = HDRCubemap::FindFace(direction, s, t);
+            float x = s * m_FaceSize - 0.5f;
+            float y = t * m_FaceSize - 0.5f;
+            float fx = std::floor(x);
+            float fy = std::floor(y);
+            float tx = x - fx;
+            float ty = y - fy;
+
+            int x0 = ClampCoord(static_cast<int>(fx));
+            int x1 = ClampCoord(static_cast<int>(fx) + 1);
+            int y0 = ClampCoord(static_cast<int>(fy));
+            int y1 = ClampCoord(static_cast<int>(fy) + 1);
+
+            glm::vec4 top = Texel(face, x0, y0) * (1.0f - tx) + Texel(face, x1, y0) * tx;
+            glm::vec4 bottom = Texel(face, x0, y1) * (1.0f - tx) + Texel(face, x1, y1) * tx;
+            return top * (1.0f - ty) + bottom * ty;
+        }
+
+    private:
+        int ClampCoord(int value) const
+        {
+            return value < 0 ? 0 : (value >= static_cast<int>(m_FaceSize) ? static_cast<int>(m_FaceSize) - 1 : value);
+        }
+
+        glm::vec4 Texel(uint32_t face, int x, int y) const
+        {
+            size_t index = ((static_cast<size_t>(face) * m_FaceSize + y) * m_FaceSize + x) * 4;
+            return glm::vec4(m_TexelsF[index], m_TexelsF[index + 1], m_TexelsF[index + 2], m_TexelsF[index + 3]);
+        }
+
+        unsigned int m_FaceSize = 0;
+        std::vector<float> m_TexelsF;  // RGBA32F, the six faces of level 0
+    };
+
+}
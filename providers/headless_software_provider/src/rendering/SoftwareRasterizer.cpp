@@ -0,0 +1,715 @@
+#include "SoftwareRasterizer.h"
+#include "SoftwareBuffer.h"
+#include "ARVBase.h"
+#include "math/VertexPacking.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace arv {
+
+    static uint32_t PackColor(const glm::vec4& color)
+    {
+        auto toByte = [](float v) {
+            v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+            return static_cast<uint32_t>(v * 255.0f + 0.5f);
+        };
+        return toByte(color.r) | (toByte(color.g) << 8) | (toByte(color.b) << 16) | (toByte(color.a) << 24);
+    }
+
+    static glm::vec4 UnpackColor(uint32_t packed)
+    {
+        constexpr float scale = 1.0f / 255.0f;
+        return glm::vec4((packed & 0xFF) * scale, ((packed >> 8) & 0xFF) * scale,
+                         ((packed >> 16) & 0xFF) * scale, ((packed >> 24) & 0xFF) * scale);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SoftwareRenderTarget /////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+    void SoftwareRenderTarget::Resize(uint32_t newWidth, uint32_t newHeight)
+    {
+        width = newWidth;
+        height = newHeight;
+        color.assign(static_cast<size_t>(width) * height, 0);
+        depth.assign(static_cast<size_t>(width) * height, 1.0f);
+    }
+
+    void SoftwareRenderTarget::Clear(const glm::vec4& clearColor, ThreadPool& pool)
+    {
+        uint32_t packed = PackColor(clearColor);
+        pool.ParallelFor(height, [this, packed](uint32_t begin, uint32_t end) {
+            size_t first = static_cast<size_t>(begin) * width;
+            size_t last = static_cast<size_t>(end) * width;
+            std::fill(color.begin() + first, color.begin() + last, packed);
+            std::fill(depth.begin() + first, depth.begin() + last, 1.0f);
+        }, 16);
+    }
+
+    /////////////////////////////////////////////////////////////////////////////
+    // SoftwareRasterizer ///////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+    void SoftwareRasterizer::Execute(const std::vector<SoftwareDrawCommand>& commands)
+    {
+        m_ExecuteIndex++;
+        for (auto it = m_Remaps.begin(); it != m_Remaps.end();)
+        {
+            bool stale = it->second.indexBuffer.expired() || m_ExecuteIndex - it->second.lastUsed > RemapRetainExecutes;
+            it = stale ? m_Remaps.erase(it) : std::next(it);
+        }
+
+        // Split into runs that target the same surface; each run is one binning pass
+        size_t runStart = 0;
+        while (runStart < commands.size())
+        {
+            size_t runEnd = runStart + 1;
+            while (runEnd < commands.size() && commands[runEnd].target == commands[runStart].target)
+            {
+                runEnd++;
+            }
+            ExecuteBatch(commands.data() + runStart, static_cast<uint32_t>(runEnd - runStart));
+            runStart = runEnd;
+        }
+    }
+
+    glm::vec4 SoftwareRasterizer::FetchAttribute(const AttributeStream& stream, uint32_t index)
+    {
+        const uint8_t* element = stream.data + size_t(index) * stream.stride;
+        uint32_t components = std::min(stream.components, 4u);
+        glm::vec4 value(0.0f);
+
+        switch (stream.type)
+        {
+            case ShaderDataType::Half2:
+            case ShaderDataType::Half4:
+            {
+                uint16_t halves[4];
+                std::memcpy(halves, element, components * sizeof(uint16_t));
+                for (uint32_t i = 0; i < components; i++) {
+                    value[i] = HalfToFloat(halves[i]);
+                }
+                break;
+            }
+            case ShaderDataType::Short2:
+            case ShaderDataType::Short4:
+            {
+                int16_t shorts[4];
+                std::memcpy(shorts, element, components * sizeof(int16_t));
+                for (uint32_t i = 0; i < components; i++) {
+                    value[i] = stream.normalized ? std::max(shorts[i] / 32767.0f, -1.0f) : float(shorts[i]);
+                }
+                break;
+            }
+            case ShaderDataType::UShort2:
+            case ShaderDataType::UShort4:
+            {
+                uint16_t shorts[4];
+                std::memcpy(shorts, element, components * sizeof(uint16_t));
+                for (uint32_t i = 0; i < components; i++) {
+                    value[i] = stream.normalized ? shorts[i] / 65535.0f : float(shorts[i]);
+                }
+                break;
+            }
+            default:
+                std::memcpy(&value[0], element, components * sizeof(float));
+                break;
+        }
+        return value;
+    }
+
+    SoftwareRasterizer::CommandGeometry SoftwareRasterizer::ResolveGeometry(const SoftwareDrawCommand& command)
+    {
+        CommandGeometry geometry;
+        if (!command.vertexArray || !command.vertexArray->GetIndexBuffer())
+        {
+            return geometry;
+        }
+
+        // Buffers are always created by SoftwareRenderingAPI
+        auto* indexBuffer = static_cast<SoftwareIndexBuffer*>(command.vertexArray->GetIndexBuffer().get());
+        uint32_t firstIndex = std::min(command.range.firstIndex, indexBuffer->GetCount());
+        uint32_t indexCount = std::min(command.range.indexCount, indexBuffer->GetCount() - firstIndex);
+        indexCount -= indexCount % 3;
+        geometry.vertexCount = UINT32_MAX;
+
+        for (const auto& buffer : command.vertexArray->GetVertexBuffers())
+        {
+            auto* vertexBuffer = static_cast<SoftwareVertexBuffer*>(buffer.get());
+            const BufferLayout& layout = vertexBuffer->GetLayout();
+            if (layout.GetStride() == 0)
+            {
+                continue;
+            }
+            geometry.vertexCount = std::min(geometry.vertexCount, vertexBuffer->GetSize() / layout.GetStride());
+
+            for (const auto& element : layout)
+            {
+                AttributeStream stream;
+                stream.data = vertexBuffer->GetData() + element.Offset;
+                stream.stride = layout.GetStride();
+                stream.components = element.GetComponentCount();
+                stream.type = element.Type;
+                stream.normalized = element.Normalized;
+
+                if (element.Name == "a_Position") {
+                    geometry.position = stream;
+                } else if (element.Name == "a_TexCoord") {
+                    geometry.texCoord = stream;
+                } else if (element.Name == "a_Normal") {
+                    geometry.normal = stream;
+                }
+            }
+        }
+
+        if (!geometry.position.data || geometry.vertexCount == UINT32_MAX || indexCount == 0)
+        {
+            geometry.vertexCount = 0;
+            return geometry;
+        }
+
+        geometry.indexCount = indexCount;
+        if (indexCount == indexBuffer->GetCount())
+        {
+            // The whole buffer; assume it references every vertex
+            geometry.indices = indexBuffer->GetData();
+            return geometry;
+        }
+
+        const RangeRemap& remap = GetRangeRemap(command.vertexArray->GetIndexBuffer(), firstIndex, indexCount,
+                                                geometry.vertexCount);
+        geometry.indices = remap.indices.data();
+        geometry.vertexCount = static_cast<uint32_t>(remap.vertices.size());
+        geometry.sourceVertices = remap.vertices.data();
+        return geometry;
+    }
+
+    const SoftwareRasterizer::RangeRemap& SoftwareRasterizer::GetRangeRemap(const std::shared_ptr<IndexBuffer>& indexBuffer,
+                                                                            uint32_t firstIndex, uint32_t indexCount,
+                                                                            uint32_t vertexCount)
+    {
+        RangeRemap& remap = m_Remaps[RangeKey(indexBuffer.get(), firstIndex, indexCount)];
+        remap.lastUsed = m_ExecuteIndex;
+        if (remap.indexBuffer.lock() == indexBuffer && remap.bufferVertexCount == vertexCount)
+        {
+            return remap;
+        }
+
+        remap.indexBuffer = indexBuffer;
+        remap.bufferVertexCount = vertexCount;
+        remap.vertices.clear();
+        remap.indices.resize(indexCount);
+
+        const uint32_t* indices = static_cast<SoftwareIndexBuffer*>(indexBuffer.get())->GetData() + firstIndex;
+        m_RemapScratch.assign(vertexCount, UINT32_MAX);
+        for (uint32_t i = 0; i < indexCount; i++)
+        {
+            uint32_t index = indices[i];
+            if (index >= vertexCount)
+            {
+                remap.indices[i] = UINT32_MAX;
+                continue;
+            }
+            if (m_RemapScratch[index] == UINT32_MAX)
+            {
+                m_RemapScratch[index] = static_cast<uint32_t>(remap.vertices.size());
+                remap.vertices.push_back(index);
+            }
+            remap.indices[i] = m_RemapScratch[index];
+        }
+        return remap;
+    }
+
+    void SoftwareRasterizer::ExecuteBatch(const SoftwareDrawCommand* commands, uint32_t count)
+    {
+        m_Target = commands[0].target;
+        if (!m_Target || m_Target->width == 0 || m_Target->height == 0)
+        {
+            return;
+        }
+
+        m_TilesX = (m_Target->width + TileSize - 1) / TileSize;
+        m_TilesY = (m_Target->height + TileSize - 1) / TileSize;
+
+        m_Geometry.resize(count);
+        m_VertexOffsets.resize(count + 1);
+        m_TriangleOffsets.resize(count + 1);
+        m_VertexOffsets[0] = 0;
+        m_TriangleOffsets[0] = 0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_Geometry[i] = ResolveGeometry(commands[i]);
+            m_VertexOffsets[i + 1] = m_VertexOffsets[i] + m_Geometry[i].vertexCount;
+            m_TriangleOffsets[i + 1] = m_TriangleOffsets[i] + m_Geometry[i].indexCount / 3;
+        }
+
+        uint32_t totalTriangles = m_TriangleOffsets[count];
+        m_Stats.drawCalls += count;
+        m_Stats.trianglesSubmitted += totalTriangles;
+        if (totalTriangles == 0)
+        {
+            return;
+        }
+
+        TransformVertices(commands);
+
+        // Enough chunks to keep every worker busy, but not so many that tiles
+        // spend their time walking empty bins
+        uint32_t maxChunks = (m_Pool.GetThreadCount() + 1) * 4;
+        uint32_t chunkCount = std::max(1u, std::min(maxChunks, (totalTriangles + 255) / 256));
+        SetupAndBinTriangles(chunkCount);
+
+        std::atomic<uint64_t> fragments{0};
+        m_Pool.ParallelFor(m_TilesX * m_TilesY, [this, commands, chunkCount, &fragments](uint32_t begin, uint32_t end) {
+            uint64_t local = 0;
+            for (uint32_t tile = begin; tile < end; tile++)
+            {
+                local += RasterizeTile(commands, chunkCount, tile);
+            }
+            fragments.fetch_add(local, std::memory_order_relaxed);
+        });
+        m_Stats.fragmentsShaded += fragments.load();
+    }
+
+    void SoftwareRasterizer::TransformVertices(const SoftwareDrawCommand* commands)
+    {
+        uint32_t commandCount = static_cast<uint32_t>(m_Geometry.size());
+        m_Vertices.resize(m_VertexOffsets[commandCount]);
+
+        m_Pool.ParallelFor(m_VertexOffsets[commandCount], [this, commands, commandCount](uint32_t begin, uint32_t end) {
+            // Locate the command owning the first vertex, then walk forward
+            uint32_t command = static_cast<uint32_t>(
+                std::upper_bound(m_VertexOffsets.begin(), m_VertexOffsets.begin() + commandCount + 1, begin)
+                - m_VertexOffsets.begin()) - 1;
+
+            for (uint32_t global = begin; global < end; global++)
+            {
+                while (global >= m_VertexOffsets[command + 1])
+                {
+                    command++;
+                }
+
+                const CommandGeometry& geometry = m_Geometry[command];
+                const SoftwareDrawCommand& cmd = commands[command];
+                uint32_t local = global - m_VertexOffsets[command];
+                if (geometry.sourceVertices) {
+                    local = geometry.sourceVertices[local];
+                }
+                ShadedVertex& out = m_Vertices[global];
+
+                glm::vec4 objectPos(glm::vec3(FetchAttribute(geometry.position, local)), 1.0f);
+
+                if (cmd.program.type == SoftwareShaderProgramType::Equirect ||
+                    cmd.program.type == SoftwareShaderProgramType::Cubemap) {
+                    out.clip = glm::vec4(objectPos.x, objectPos.y, 0.9999f, 1.0f);
+                } else {
+                    out.clip = cmd.mvp * objectPos;
+                }
+
+                if (geometry.texCoord.data) {
+                    out.uv = glm::vec2(FetchAttribute(geometry.texCoord, local));
+                } else {
+                    out.uv = glm::vec2(0.0f);
+                }
+
+                if (geometry.normal.data) {
+                    glm::vec4 n = FetchAttribute(geometry.normal, local);
+                    out.normal = cmd.program.octahedralNormals ? OctahedralDecode(glm::vec2(n)) : glm::vec3(n);
+                } else {
+                    out.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                }
+            }
+        }, 256);
+    }
+
+    // Sutherland-Hodgman against one clip plane; distance(v) >= 0 is inside
+    template<typename Vertex, typename Distance>
+    static uint32_t ClipPolygon(const Vertex* in, uint32_t inCount, Vertex* out, Distance distance)
+    {
+        uint32_t outCount = 0;
+        for (uint32_t i = 0; i < inCount; i++)
+        {
+            const Vertex& a = in[i];
+            const Vertex& b = in[(i + 1) % inCount];
+            float da = distance(a);
+            float db = distance(b);
+
+            if (da >= 0.0f)
+            {
+                out[outCount++] = a;
+            }
+            if ((da >= 0.0f) != (db >= 0.0f))
+            {
+                float t = da / (da - db);
+                Vertex v;
+                v.clip = a.clip + (b.clip - a.clip) * t;
+                v.uv = a.uv + (b.uv - a.uv) * t;
+                v.normal = a.normal + (b.normal - a.normal) * t;
+                out[outCount++] = v;
+            }
+        }
+        return outCount;
+    }
+
+    void SoftwareRasterizer::SetupAndBinTriangles(uint32_t chunkCount)
+    {
+        if (m_Chunks.size() < chunkCount)
+        {
+            m_Chunks.resize(chunkCount);
+        }
+
+        uint32_t commandCount = static_cast<uint32_t>(m_Geometry.size());
+        uint32_t totalTriangles = m_TriangleOffsets[commandCount];
+        uint32_t trianglesPerChunk = (totalTriangles + chunkCount - 1) / chunkCount;
+        uint32_t tileCount = m_TilesX * m_TilesY;
+
+        std::atomic<uint32_t> binned{0};
+        m_Pool.ParallelFor(chunkCount, [&](uint32_t chunkBegin, uint32_t chunkEnd) {
+            for (uint32_t chunkIndex = chunkBegin; chunkIndex < chunkEnd; chunkIndex++)
+            {
+                BinChunk& chunk = m_Chunks[chunkIndex];
+                chunk.triangles.clear();
+                chunk.tiles.resize(tileCount);
+                for (auto& tile : chunk.tiles)
+                {
+                    tile.clear();
+                }
+
+                uint32_t first = std::min(totalTriangles, chunkIndex * trianglesPerChunk);
+                uint32_t last = std::min(totalTriangles, first + trianglesPerChunk);
+                if (first == last)
+                {
+                    continue;
+                }
+
+                uint32_t command = static_cast<uint32_t>(
+                    std::upper_bound(m_TriangleOffsets.begin(), m_TriangleOffsets.begin() + commandCount + 1, first)
+                    - m_TriangleOffsets.begin()) - 1;
+
+                for (uint32_t global = first; global < last; global++)
+                {
+                    while (global >= m_TriangleOffsets[command + 1])
+                    {
+                        command++;
+                    }
+
+                    const CommandGeometry& geometry = m_Geometry[command];
+                    uint32_t triangle = global - m_TriangleOffsets[command];
+                    const ShadedVertex* vertices = m_Vertices.data() + m_VertexOffsets[command];
+
+                    ShadedVertex polygon[8];
+                    ShadedVertex scratch[8];
+                    bool valid = true;
+                    for (uint32_t corner = 0; corner < 3; corner++)
+                    {
+                        uint32_t index = geometry.indices[triangle * 3 + corner];
+                        if (index >= geometry.vertexCount)
+                        {
+                            valid = false;
+                            break;
+                        }
+                        polygon[corner] = vertices[index];
+                    }
+                    if (!valid)
+                    {
+                        continue;
+                    }
+
+                    // Only clip when needed; most triangles are fully inside the depth range
+                    uint32_t vertexCount = 3;
+                    bool needsClip = false;
+                    for (uint32_t corner = 0; corner < 3; corner++)
+                    {
+                        const glm::vec4& c = polygon[corner].clip;
+                        needsClip |= (c.z < -c.w) || (c.z > c.w);
+                    }
+                    if (needsClip)
+                    {
+                        vertexCount = ClipPolygon(polygon, vertexCount, scratch,
+                                                  [](const ShadedVertex& v) { return v.clip.z + v.clip.w; });
+                        vertexCount = ClipPolygon(scratch, vertexCount, polygon,
+                                                  [](const ShadedVertex& v) { return v.clip.w - v.clip.z; });
+                    }
+
+                    for (uint32_t fan = 1; fan + 1 < vertexCount; fan++)
+                    {
+                        ShadedVertex triangleVertices[3] = { polygon[0], polygon[fan], polygon[fan + 1] };
+                        size_t before = chunk.triangles.size();
+                        SetupTriangle(triangleVertices, command, chunk);
+                        if (chunk.triangles.size() == before)
+                        {
+                            continue;
+                        }
+
+                        uint32_t index = static_cast<uint32_t>(before);
+                        const ScreenTriangle& tri = chunk.triangles.back();
+                        uint32_t tileMinX = tri.minX / TileSize;
+                        uint32_t tileMaxX = tri.maxX / TileSize;
+                        uint32_t tileMinY = tri.minY / TileSize;
+                        uint32_t tileMaxY = tri.maxY / TileSize;
+                        for (uint32_t ty = tileMinY; ty <= tileMaxY; ty++)
+                        {
+                            for (uint32_t tx = tileMinX; tx <= tileMaxX; tx++)
+                            {
+                                chunk.tiles[ty * m_TilesX + tx].push_back(index);
+                            }
+                        }
+                    }
+                }
+
+                binned.fetch_add(static_cast<uint32_t>(chunk.triangles.size()), std::memory_order_relaxed);
+            }
+        });
+
+        m_Stats.trianglesBinned += binned.load();
+    }
+
+    void SoftwareRasterizer::SetupTriangle(const ShadedVertex* clipped, uint32_t command, BinChunk& chunk) const
+    {
+        ScreenTriangle tri;
+        tri.command = command;
+
+        float width = static_cast<float>(m_Target->width);
+        float height = static_cast<float>(m_Target->height);
+
+        for (int i = 0; i < 3; i++)
+        {
+            const glm::vec4& clip = clipped[i].clip;
+            if (clip.w <= 1e-6f)
+            {
+                return;
+            }
+            float invW = 1.0f / clip.w;
+            tri.x[i] = (clip.x * invW * 0.5f + 0.5f) * width;
+            tri.y[i] = (clip.y * invW * 0.5f + 0.5f) * height;
+            tri.z[i] = clip.z * invW * 0.5f + 0.5f;
+            tri.invW[i] = invW;
+            tri.uvOverW[i] = clipped[i].uv * invW;
+            tri.normalOverW[i] = clipped[i].normal * invW;
+        }
+
+        // No face culling (matches the OpenGL provider's default state), so
+        // bring every triangle to counter-clockwise winding instead
+        float area = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) - (tri.y[1] - tri.y[0]) * (tri.x[2] - tri.x[0]);
+        if (area == 0.0f || !std::isfinite(area))
+        {
+            return;
+        }
+        if (area < 0.0f)
+        {
+            std::swap(tri.x[1], tri.x[2]);
+            std::swap(tri.y[1], tri.y[2]);
+            std::swap(tri.z[1], tri.z[2]);
+            std::swap(tri.invW[1], tri.invW[2]);
+            std::swap(tri.uvOverW[1], tri.uvOverW[2]);
+            std::swap(tri.normalOverW[1], tri.normalOverW[2]);
+        }
+
+        float minX = std::min({ tri.x[0], tri.x[1], tri.x[2] });
+        float maxX = std::max({ tri.x[0], tri.x[1], tri.x[2] });
+        float minY = std::min({ tri.y[0], tri.y[1], tri.y[2] });
+        float maxY = std::max({ tri.y[0], tri.y[1], tri.y[2] });
+
+        // Pixel centers at +0.5; clamp in float first so huge guard-band
+        // coordinates never overflow the integer conversion
+        minX = std::max(0.0f, std::ceil(minX - 0.5f));
+        minY = std::max(0.0f, std::ceil(minY - 0.5f));
+        maxX = std::min(width - 1.0f, std::floor(maxX - 0.5f));
+        maxY = std::min(height - 1.0f, std::floor(maxY - 0.5f));
+        if (minX > maxX || minY > maxY)
+        {
+            return;
+        }
+
+        tri.minX = static_cast<int>(minX);
+        tri.minY = static_cast<int>(minY);
+        tri.maxX = static_cast<int>(maxX);
+        tri.maxY = static_cast<int>(maxY);
+        chunk.triangles.push_back(tri);
+    }
+
+    uint64_t SoftwareRasterizer::RasterizeTile(const SoftwareDrawCommand* commands, uint32_t chunkCount, uint32_t tileIndex)
+    {
+        const int tileMinX = static_cast<int>((tileIndex % m_TilesX) * TileSize);
+        const int tileMinY = static_cast<int>((tileIndex / m_TilesX) * TileSize);
+        const int tileMaxX = std::min(tileMinX + static_cast<int>(TileSize), static_cast<int>(m_Target->width)) - 1;
+        const int tileMaxY = std::min(tileMinY + static_cast<int>(TileSize), static_cast<int>(m_Target->height)) - 1;
+
+        const uint32_t targetWidth = m_Target->width;
+        uint32_t* colorBuffer = m_Target->color.data();
+        float* depthBuffer = m_Target->depth.data();
+
+        const glm::vec3 lightDir = glm::normalize(glm::vec3(1.0f, 1.0f, 1.0f));
+        constexpr float PI = 3.14159265358979323846f;
+
+        uint64_t fragments = 0;
+
+        for (uint32_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
+        {
+            const BinChunk& chunk = m_Chunks[chunkIndex];
+            for (uint32_t triangleIndex : chunk.tiles[tileIndex])
+            {
+                const ScreenTriangle& tri = chunk.triangles[triangleIndex];
+                const SoftwareDrawCommand& cmd = commands[tri.command];
+                const SoftwareShaderProgram& program = cmd.program;
+                const SoftwareTexture2D* texture = cmd.texture.get();
+
+                int minX = std::max(tri.minX, tileMinX);
+                int maxX = std::min(tri.maxX, tileMaxX);
+                int minY = std::max(tri.minY, tileMinY);
+                int maxY = std::min(tri.maxY, tileMaxY);
+                if (minX > maxX || minY > maxY)
+                {
+                    continue;
+                }
+
+                // Edge e_i is opposite vertex i: w_i(p) = (b - a) x (p - a)
+                float area = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) - (tri.y[1] - tri.y[0]) * (tri.x[2] - tri.x[0]);
+                float invArea = 1.0f / area;
+
+                // Perspective-correct texture coordinate for unnormalized edge values
+                auto uvAt = [&](float e0, float e1, float e2) {
+                    float c0 = e0 * invArea;
+                    float c1 = e1 * invArea;
+                    float c2 = e2 * invArea;
+                    float invW = c0 * tri.invW[0] + c1 * tri.invW[1] + c2 * tri.invW[2];
+                    return (tri.uvOverW[0] * c0 + tri.uvOverW[1] * c1 + tri.uvOverW[2] * c2) / invW;
+                };
+
+                float stepX[3], stepY[3], rowStart[3];
+                bool topLeft[3];
+                for (int e = 0; e < 3; e++)
+                {
+                    int a = (e + 1) % 3;
+                    int b = (e + 2) % 3;
+                    float dx = tri.x[b] - tri.x[a];
+                    float dy = tri.y[b] - tri.y[a];
+                    stepX[e] = -dy;
+                    stepY[e] = dx;
+                    float px = minX + 0.5f;
+                    float py = minY + 0.5f;
+                    rowStart[e] = dx * (py - tri.y[a]) - dy * (px - tri.x[a]);
+                    // Counter-clockwise with y up: left edges go down, top edges go left
+                    topLeft[e] = dy < 0.0f || (dy == 0.0f && dx < 0.0f);
+                }
+
+                for (int y = minY; y <= maxY; y++)
+                {
+                    float w[3] = { rowStart[0], rowStart[1], rowStart[2] };
+                    uint32_t* colorRow = colorBuffer + static_cast<size_t>(y) * targetWidth;
+                    float* depthRow = depthBuffer + static_cast<size_t>(y) * targetWidth;
+
+                    for (int x = minX; x <= maxX; x++, w[0] += stepX[0], w[1] += stepX[1], w[2] += stepX[2])
+                    {
+                        bool inside = (w[0] > 0.0f || (w[0] == 0.0f && topLeft[0])) &&
+                                      (w[1] > 0.0f || (w[1] == 0.0f && topLeft[1])) &&
+                                      (w[2] > 0.0f || (w[2] == 0.0f && topLeft[2]));
+                        if (!inside)
+                        {
+                            continue;
+                        }
+
+                        float b0 = w[0] * invArea;
+                        float b1 = w[1] * invArea;
+                        float b2 = w[2] * invArea;
+
+                        float depth = b0 * tri.z[0] + b1 * tri.z[1] + b2 * tri.z[2];
+                        if (!(depth < depthRow[x]))
+                        {
+                            continue;
+                        }
+
+                        glm::vec4 color;
+                        if (program.type == SoftwareShaderProgramType::Equirect ||
+                            program.type == SoftwareShaderProgramType::Cubemap)
+                        {
+                            float width = static_cast<float>(m_Target->width);
+                            float height = static_cast<float>(m_Target->height);
+                            glm::vec4 clipPos((x + 0.5f) / width * 2.0f - 1.0f, (y + 0.5f) / height * 2.0f - 1.0f, 1.0f, 1.0f);
+                            glm::vec4 worldPos = cmd.inverseVP * clipPos;
+                            glm::vec3 dir = glm::vec3(worldPos) / worldPos.w;
+
+                            glm::vec3 hdrColor(0.0f);
+                            if (program.type == SoftwareShaderProgramType::Cubemap)
+                            {
+                                if (cmd.cubemap)
+                                {
+                                    hdrColor = glm::vec3(cmd.cubemap->Sample(dir));
+                                }
+                            }
+                            else if (texture)
+                            {
+                                dir = glm::normalize(dir);
+                                float u = std::atan2(dir.z, dir.x) / (2.0f * PI) + 0.5f;
+                                float v = std::asin(std::max(-1.0f, std::min(1.0f, dir.y))) / PI + 0.5f;
+                                v = 1.0f - v;
+                                hdrColor = glm::vec3(texture->Sample(u, v));
+                            }
+
+                            // Reinhard tonemapping + gamma correction
+                            glm::vec3 mapped = hdrColor / (hdrColor + glm::vec3(1.0f));
+                            mapped = glm::vec3(std::pow(mapped.x, 1.0f / 2.2f), std::pow(mapped.y, 1.0f / 2.2f),
+                                               std::pow(mapped.z, 1.0f / 2.2f));
+                            color = glm::vec4(mapped, 1.0f);
+                        }
+                        else
+                        {
+                            color = cmd.color;
+
+                            float invW = b0 * tri.invW[0] + b1 * tri.invW[1] + b2 * tri.invW[2];
+                            float perspective = 1.0f / invW;
+
+                            if (program.useTexture && texture)
+                            {
+                                glm::vec2 uv = (tri.uvOverW[0] * b0 + tri.uvOverW[1] * b1 + tri.uvOverW[2] * b2) * perspective;
+                                float lod = 0.0f;
+                                if (texture->HasMips())
+                                {
+                                    // Footprint from the neighbours to the right and above, like a GPU's quad derivatives
+                                    glm::vec2 uvRight = uvAt(w[0] + stepX[0], w[1] + stepX[1], w[2] + stepX[2]);
+                                    glm::vec2 uvUp = uvAt(w[0] + stepY[0], w[1] + stepY[1], w[2] + stepY[2]);
+                                    lod = texture->ComputeLod(uvRight - uv, uvUp - uv);
+                                }
+                                color = color * texture->SampleLod(uv.x, uv.y, lod);
+                            }
+
+                            if (program.directionalLighting)
+                            {
+                                glm::vec3 normal = (tri.normalOverW[0] * b0 + tri.normalOverW[1] * b1 + tri.normalOverW[2] * b2) * perspective;
+                                float len = glm::length(normal);
+                                float diff = len > 0.0f ? std::max(glm::dot(normal / len, lightDir), 0.3f) : 0.3f;
+                                color = glm::vec4(glm::vec3(color) * diff, color.a);
+                            }
+
+                            if (color.a < program.alphaDiscard)
+                            {
+                                continue;
+                            }
+                        }
+
+                        // glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), applied to all four channels
+                        float alpha = std::max(0.0f, std::min(1.0f, color.a));
+                        if (alpha < 1.0f)
+                        {
+                            glm::vec4 dst = UnpackColor(colorRow[x]);
+                            color = color * alpha + dst * (1.0f - alpha);
+                        }
+
+                        colorRow[x] = PackColor(color);
+                        depthRow[x] = depth;
+                        fragments++;
+                    }
+
+                    rowStart[0] += stepY[0];
+                    rowStart[1] += stepY[1];
+                    rowStart[2] += stepY[2];
+                }
+            }
+        }
+
+        return fragments;
+    }
+
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "rendering/VertexArray.h"
+#include "SoftwareShader.h"
+#include "SoftwareTexture.h"
+#include "SoftwareHDRTextureCube.h"
+#include "utils/ThreadPool.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * Color + depth surface the rasterizer draws into.
+     * Rows are stored bottom-up (OpenGL window convention).
+     */
+    struct SoftwareRenderTarget
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint32_t> color;  // RGBA8, R in the lowest byte
+        std::vector<float> depth;     // window-space depth in [0, 1]
+
+        void Resize(uint32_t newWidth, uint32_t newHeight);
+        void Clear(const glm::vec4& clearColor, ThreadPool& pool);
+    };
+
+    // Everything the rasterizer needs for one draw, captured when Draw() is called
+    struct SoftwareDrawCommand
+    {
+        SoftwareRenderTarget* target = nullptr;
+        SoftwareShaderProgram program;
+        std::shared_ptr<VertexArray> vertexArray;
+        std::shared_ptr<SoftwareTexture2D> texture; // nullptr if no texture
+        std::shared_ptr<SoftwareHDRTextureCube> cubemap; // Set instead of texture for cubemaps
+        IndexRange range;
+        glm::mat4 mvp = glm::mat4(1.0f);
+        glm::mat4 inverseVP = glm::mat4(1.0f);
+        glm::vec4 color = glm::vec4(1.0f);
+    };
+
+    struct SoftwareRasterizerStats
+    {
+        uint32_t drawCalls = 0;
+        uint32_t trianglesSubmitted = 0;
+        uint32_t trianglesBinned = 0;
+        uint64_t fragmentsShaded = 0;
+    };
+
+    /**
+     * Tile-binned triangle rasterizer.
+     *
+     * A batch of draw commands runs through three parallel stages:
+     *   1. vertex transform of the vertices each command's index range
+     *      references, so a submesh or coarse LOD only shades its own part
+     *      of the shared vertex buffer
+     *   2. triangle setup (near/far clipping, viewport, culling) and binning
+     *      into TileSize x TileSize screen tiles
+     *   3. per-tile rasterization, depth test and blending
+     * Triangles are binned per chunk of consecutive triangles and tiles walk the
+     * chunks in order, so submission order (and therefore blending) is preserved
+     * while every tile is owned by exactly one thread.
+     */
+    class SoftwareRasterizer
+    {
+    public:
+        static constexpr uint32_t TileSize = 64;
+
+        SoftwareRasterizer(ThreadPool& pool) : m_Pool(pool) {}
+
+        void Execute(const std::vector<SoftwareDrawCommand>& commands);
+
+        const SoftwareRasterizerStats& GetStats() const { return m_Stats; }
+        void ResetStats() { m_Stats = SoftwareRasterizerStats(); }
+
+    private:
+        struct AttributeStream
+        {
+            const uint8_t* data = nullptr;
+            uint32_t stride = 0;
+            uint32_t components = 0;
+            ShaderDataType type = ShaderDataType::Float;
+            bool normalized = false;
+        };
+
+        // Reads one element of any float, half or 16-bit type; missing components are 0
+        static glm::vec4 FetchAttribute(const AttributeStream& stream, uint32_t index);
+
+        struct CommandGeometry
+        {
+            const uint32_t* indices = nullptr;       // Into the shaded vertices
+            uint32_t indexCount = 0;
+            uint32_t vertexCount = 0;                // Shaded vertices
+            const uint32_t* sourceVertices = nullptr; // Buffer vertex of each shaded one, nullptr if the same
+            AttributeStream position;
+            AttributeStream texCoord;
+            AttributeStream normal;
+        };
+
+        struct ShadedVertex
+        {
+            glm::vec4 clip;
+            glm::vec2 uv;
+            glm::vec3 normal;
+        };
+
+        struct ScreenTriangle
+        {
+            float x[3], y[3];
+            float z[3];
+            float invW[3];
+            glm::vec2 uvOverW[3];
+            glm::vec3 normalOverW[3];
+            int minX, minY, maxX, maxY;
+            uint32_t command;
+        };
+
+        struct BinChunk
+        {
+            std::vector<ScreenTriangle> triangles;
+            std::vector<std::vector<uint32_t>> tiles;
+        };
+
+        // Vertices one index range references, in first-use order, and the range's
+        // indices rewritten to point into that list. Index data never changes
+        // after creation, so it is built on the first draw of a range and reused
+        struct RangeRemap
+        {
+            std::weak_ptr<IndexBuffer> indexBuffer;  // Detects a new buffer at the same address
+            uint32_t bufferVertexCount = 0;
+            std::vector<uint32_t> vertices;
+            std::vector<uint32_t> indices;           // UINT32_MAX for out-of-range indices
+            uint64_t lastUsed = 0;
+        };
+        using RangeKey = std::tuple<const IndexBuffer*, uint32_t, uint32_t>;
+
+        // Execute() calls a range may go undrawn before its remap is dropped
+        static constexpr uint64_t RemapRetainExecutes = 120;
+
+        void ExecuteBatch(const SoftwareDrawCommand* commands, uint32_t count);
+        CommandGeometry ResolveGeometry(const SoftwareDrawCommand& command);
+        const RangeRemap& GetRangeRemap(const std::shared_ptr<IndexBuffer>& indexBuffer, uint32_t firstIndex,
+                                        uint32_t indexCount, uint32_t vertexCount);
+
+        void TransformVertices(const SoftwareDrawCommand* commands);
+        void SetupAndBinTriangles(uint32_t chunkCount);
+        void SetupTriangle(const ShadedVertex* clipped, uint32_t command, BinChunk& chunk) const;
+        uint64_t RasterizeTile(const SoftwareDrawCommand* commands, uint32_t chunkCount, uint32_t tileIndex);
+
+        ThreadPool& m_Pool;
+        SoftwareRasterizerStats m_Stats;
+
+        // Per-batch scratch, kept between frames to avoid reallocations
+        SoftwareRenderTarget* m_Target = nullptr;
+        uint32_t m_TilesX = 0;
+        uint32_t m_TilesY = 0;
+        std::vector<CommandGeometry> m_Geometry;
+        std::vector<uint32_t> m_VertexOffsets;
+        std::vector<uint32_t> m_TriangleOffsets;
+        std::vector<ShadedVertex> m_Vertices;
+        std::vector<BinChunk> m_Chunks;
+
+        std::map<RangeKey, RangeRemap> m_Remaps;
+        std::vector<uint32_t> m_RemapScratch;
+        uint64_t m_ExecuteIndex = 0;
+    };
+
+}
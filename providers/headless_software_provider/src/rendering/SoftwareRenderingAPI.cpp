@@ -0,0 +1,247 @@
+#include "SoftwareRenderingAPI.h"
+#include "ARVBase.h"
+
+#include "SoftwareBuffer.h"
+#include "SoftwareShader.h"
+#include "SoftwareVertexArray.h"
+#include "SoftwareTexture.h"
+#include "SoftwareHDRTexture.h"
+#include "SoftwareHDRTextureCube.h"
+#include "SoftwareFramebuffer.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+
+namespace arv
+{
+
+    SoftwareRenderingAPI::SoftwareRenderingAPI()
+        : m_Rasterizer(ThreadPool::Global())
+    {
+        m_CurrentTarget = &m_DefaultTarget;
+    }
+
+    SoftwareRenderingAPI::~SoftwareRenderingAPI()
+    {
+
+    }
+
+    void SoftwareRenderingAPI::Init(PlatformApplicationContext* context)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::Init() - Rasterizing on {} worker threads with {}x{} tiles",
+                     ThreadPool::Global().GetThreadCount(), SoftwareRasterizer::TileSize, SoftwareRasterizer::TileSize);
+        ARV_LOG_INFO("SoftwareRenderingAPI::Init() - Software Rendering API initialized");
+    }
+
+    void SoftwareRenderingAPI::DrawExample()
+    {
+
+    }
+
+    void SoftwareRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray)
+    {
+        DrawInternal(shader, vertexArray, nullptr);
+    }
+
+    void SoftwareRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture)
+    {
+        DrawInternal(shader, vertexArray, texture);
+    }
+
+    void SoftwareRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                    const std::shared_ptr<Texture2D>& texture, const IndexRange& range)
+    {
+        DrawInternal(shader, vertexArray, texture, range);
+    }
+
+    void SoftwareRenderingAPI::DrawInternal(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                            const std::shared_ptr<Texture2D>& texture, const IndexRange& range)
+    {
+        if (!shader || !vertexArray)
+        {
+            return;
+        }
+
+        // Shaders are always created by this API
+        auto* softwareShader = static_cast<SoftwareShader*>(shader.get());
+        const SoftwareShaderProgram& program = softwareShader->GetProgram();
+
+        // Snapshot the uniforms now: objects may re-upload them before the flush
+        SoftwareDrawCommand command;
+        command.target = m_CurrentTarget;
+        command.program = program;
+        command.vertexArray = vertexArray;
+        command.texture = std::dynamic_pointer_cast<SoftwareTexture2D>(texture);
+        command.cubemap = std::dynamic_pointer_cast<SoftwareHDRTextureCube>(texture);
+        command.range = range;
+        command.color = program.constantColor;
+
+        const auto& mat4Uniforms = shader->GetMat4Uniforms();
+        auto mvp = mat4Uniforms.find("u_mvp");
+        if (mvp != mat4Uniforms.end())
+        {
+            command.mvp = mvp->second;
+        }
+        auto inverseVP = mat4Uniforms.find("u_inverseVP");
+        if (inverseVP != mat4Uniforms.end())
+        {
+            command.inverseVP = inverseVP->second;
+        }
+        if (!program.positionScaleUniform.empty())
+        {
+            // Fold the dequantization into the MVP so the rasterizer only has to
+            // widen the stored integers
+            const auto& float4Uniforms = shader->GetFloat4Uniforms();
+            auto scale = float4Uniforms.find(program.positionScaleUniform);
+            auto offset = float4Uniforms.find(program.positionOffsetUniform);
+            glm::mat4 decode(1.0f);
+            if (scale != float4Uniforms.end())
+            {
+                decode[0][0] = scale->second.x;
+                decode[1][1] = scale->second.y;
+                decode[2][2] = scale->second.z;
+            }
+            if (offset != float4Uniforms.end())
+            {
+                decode[3] = glm::vec4(glm::vec3(offset->second), 1.0f);
+            }
+            command.mvp = command.mvp * decode;
+        }
+        if (!program.colorUniform.empty())
+        {
+            const auto& float4Uniforms = shader->GetFloat4Uniforms();
+            auto color = float4Uniforms.find(program.colorUniform);
+            if (color != float4Uniforms.end())
+            {
+                command.color = color->second;
+            }
+        }
+
+        m_drawCommands.push_back(std::move(command));
+    }
+
+    void SoftwareRenderingAPI::SetClearColor(const glm::vec4& color)
+    {
+        m_ClearColor = color;
+    }
+
+    void SoftwareRenderingAPI::Clear()
+    {
+        m_CurrentTarget->Clear(m_ClearColor, ThreadPool::Global());
+    }
+
+    void SoftwareRenderingAPI::BeginFrame()
+    {
+        m_drawCommands.clear();
+        m_frameInProgress = true;
+
+        // Clear the default target at the start of each frame
+        m_CurrentTarget = &m_DefaultTarget;
+        m_DefaultTarget.Clear(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), ThreadPool::Global());
+    }
+
+    void SoftwareRenderingAPI::FlushDrawCommands()
+    {
+        if (m_drawCommands.empty())
+        {
+            return;
+        }
+
+        m_Rasterizer.Execute(m_drawCommands);
+        m_drawCommands.clear();
+    }
+
+    void SoftwareRenderingAPI::EndFrame()
+    {
+        if (!m_frameInProgress)
+        {
+            return;
+        }
+
+        // Execute any remaining draw commands
+        FlushDrawCommands();
+
+        m_frameInProgress = false;
+    }
+
+    void SoftwareRenderingAPI::ResizeDefaultTarget(uint32_t width, uint32_t height)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::ResizeDefaultTarget() - Resizing default target to {}x{}", width, height);
+        FlushDrawCommands();
+        m_DefaultTarget.Resize(width, height);
+    }
+
+    void SoftwareRenderingAPI::SetRenderTarget(SoftwareRenderTarget* target)
+    {
+        m_CurrentTarget = target ? target : &m_DefaultTarget;
+    }
+
+    void SoftwareRenderingAPI::ReleaseRenderTarget(SoftwareRenderTarget* target)
+    {
+        bool referenced = std::any_of(m_drawCommands.begin(), m_drawCommands.end(),
+                                      [target](const SoftwareDrawCommand& cmd) { return cmd.target == target; });
+        if (referenced)
+        {
+            FlushDrawCommands();
+        }
+        if (m_CurrentTarget == target)
+        {
+            m_CurrentTarget = &m_DefaultTarget;
+        }
+    }
+
+    std::shared_ptr<VertexBuffer> SoftwareRenderingAPI::CreateVertexBuffer(float* vertices, unsigned int size)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateVertexBuffer() - Creating vertex buffer with {} bytes", size);
+        return std::make_shared<SoftwareVertexBuffer>(vertices, size);
+    }
+
+    std::shared_ptr<IndexBuffer> SoftwareRenderingAPI::CreateIndexBuffer(unsigned int* indices, unsigned int size)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateIndexBuffer() - Creating index buffer with {} indices", size);
+        return std::make_shared<SoftwareIndexBuffer>(indices, size);
+    }
+
+    std::shared_ptr<VertexArray> SoftwareRenderingAPI::CreateVertexArray()
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateVertexArray() - Creating vertex array");
+        return std::make_shared<SoftwareVertexArray>();
+    }
+
+    std::shared_ptr<Shader> SoftwareRenderingAPI::CreateShader(ShaderSource* shaderSource)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateShader() - Creating shader from source");
+        return std::make_shared<SoftwareShader>(shaderSource);
+    }
+
+    std::shared_ptr<Texture2D> SoftwareRenderingAPI::CreateTexture2D(const std::string& path, const TextureSpecification& spec)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateTexture2D() - Creating texture from path: {}", path);
+        return std::make_shared<SoftwareTexture2D>(path, spec);
+    }
+
+    std::shared_ptr<Texture2D> SoftwareRenderingAPI::CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                                     const TextureSpecification& spec)
+    {
+        return std::make_shared<SoftwareTexture2D>(width, height, pixels, spec);
+    }
+
+    std::shared_ptr<Texture2D> SoftwareRenderingAPI::CreateHDRTexture2D(const std::string& path)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateHDRTexture2D() - Creating HDR texture from path: {}", path);
+        return std::make_shared<SoftwareHDRTexture2D>(path);
+    }
+
+    std::shared_ptr<TextureCube> SoftwareRenderingAPI::CreateHDRTextureCube(const std::string& path)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateHDRTextureCube() - Creating HDR cubemap from path: {}", path);
+        return std::make_shared<SoftwareHDRTextureCube>(path);
+    }
+
+    std::shared_ptr<Framebuffer> SoftwareRenderingAPI::CreateFramebuffer(const FramebufferSpecification& spec)
+    {
+        ARV_LOG_INFO("SoftwareRenderingAPI::CreateFramebuffer() - Creating framebuffer {}x{}", spec.width, spec.height);
+        return std::make_shared<SoftwareFramebuffer>(spec, this);
+    }
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "rendering/RenderingAPI.h"
+#include "SoftwareRasterizer.h"
+#include <vector>
+
+namespace arv
+{
+    /**
+     * CPU implementation of the RenderingAPI for machines without a GPU or display.
+     * Draws are deferred like in the OpenGL provider and rasterized on the shared
+     * ThreadPool when FlushDrawCommands() / EndFrame() is called.
+     */
+    class SoftwareRenderingAPI : public RenderingAPI
+    {
+    public:
+        SoftwareRenderingAPI();
+        ~SoftwareRenderingAPI() override;
+
+        RenderingBackend GetBackendType() const override { return RenderingBackend::Software; }
+
+        void Init(PlatformApplicationContext* context) override;
+        void DrawExample() override;
+
+        void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray) override;
+        void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture) override;
+        void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                  const std::shared_ptr<Texture2D>& texture, const IndexRange& range) override;
+
+        void SetClearColor(const glm::vec4& color) override;
+        void Clear() override;
+
+        void BeginFrame() override;
+        void EndFrame() override;
+
+        // Rasterize pending draw commands without ending the frame
+        void FlushDrawCommands() override;
+
+        std::shared_ptr<VertexBuffer> CreateVertexBuffer(float* vertices, unsigned int size) override;
+        std::shared_ptr<IndexBuffer> CreateIndexBuffer(unsigned int* indices, unsigned int size) override;
+        std::shared_ptr<VertexArray> CreateVertexArray() override;
+        std::shared_ptr<Shader> CreateShader(ShaderSource* shaderSource) override;
+        std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path,
+                                                   const TextureSpecification& spec = TextureSpecification()) override;
+        std::shared_ptr<Texture2D> CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                   const TextureSpecification& spec = TextureSpecification()) override;
+        std::shared_ptr<Texture2D> CreateHDRTexture2D(const std::string& path) override;
+        std::shared_ptr<TextureCube> CreateHDRTextureCube(const std::string& path) override;
+        std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferSpecification& spec) override;
+
+        // Position, texcoord and normal streams accept every float, half and 16-bit type
+        bool SupportsVertexType(ShaderDataType type) const override { return type != ShaderDataType::None; }
+        bool UsesBottomLeftTextureOrigin() const override { return true; }
+
+        // Default (window) target, presented by the HeadlessCanvas
+        SoftwareRenderTarget& GetDefaultTarget() { return m_DefaultTarget; }
+        void ResizeDefaultTarget(uint32_t width, uint32_t height);
+
+        // nullptr selects the default target (used by SoftwareFramebuffer)
+        void SetRenderTarget(SoftwareRenderTarget* target);
+        void ReleaseRenderTarget(SoftwareRenderTarget* target);
+
+        const SoftwareRasterizerStats& GetRasterizerStats() const { return m_Rasterizer.GetStats(); }
+
+    private:
+        void DrawInternal(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                          const std::shared_ptr<Texture2D>& texture, const IndexRange& range = IndexRange());
+
+        SoftwareRasterizer m_Rasterizer;
+        SoftwareRenderTarget m_DefaultTarget;
+        SoftwareRenderTarget* m_CurrentTarget = nullptr;
+        glm::vec4 m_ClearColor = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        std::vector<SoftwareDrawCommand> m_drawCommands;
+        bool m_frameInProgress = false;
+    };
+}
@@ -0,0 +1,136 @@
+#include "SoftwareShader.h"
+#include "ARVBase.h"
+#include <sstream>
+
+namespace arv {
+
+    static std::string trim(const std::string& str)
+    {
+        size_t start = str.find_first_not_of(" \t\r");
+        if (start == std::string::npos) return "";
+        size_t end = str.find_last_not_of(" \t\r");
+        return str.substr(start, end - start + 1);
+    }
+
+    void SoftwareShader::Compile()
+    {
+        m_Program = SoftwareShaderProgram();
+        m_Compiled = true;
+
+        std::string source = m_ShaderSource->GetSource("SOFTWARE_SHADER");
+        if (source.empty())
+        {
+            // Without a description fall back to "textured if a texture is bound"
+            ARV_LOG_WARN("SoftwareShader::Compile() - No SOFTWARE_SHADER section, using default textured surface");
+            m_Program.useTexture = true;
+            return;
+        }
+
+        std::istringstream stream(source);
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            line = trim(line);
+            if (line.empty() || line.compare(0, 2, "//") == 0)
+            {
+                continue;
+            }
+
+            size_t separator = line.find('=');
+            if (separator == std::string::npos)
+            {
+                ARV_LOG_WARN("SoftwareShader::Compile() - Ignoring malformed line: {}", line);
+                continue;
+            }
+
+            std::string key = trim(line.substr(0, separator));
+            std::string value = trim(line.substr(separator + 1));
+
+            if (key == "program")
+            {
+                if (value == "surface") {
+                    m_Program.type = SoftwareShaderProgramType::Surface;
+                } else if (value == "equirect") {
+                    m_Program.type = SoftwareShaderProgramType::Equirect;
+                } else if (value == "cubemap") {
+                    m_Program.type = SoftwareShaderProgramType::Cubemap;
+                } else {
+                    ARV_LOG_WARN("SoftwareShader::Compile() - Unknown program '{}'", value);
+                }
+            }
+            else if (key == "color")
+            {
+                if (value.compare(0, 2, "u_") == 0) {
+                    m_Program.colorUniform = value;
+                } else {
+                    std::istringstream components(value);
+                    glm::vec4 color(1.0f);
+                    components >> color.r >> color.g >> color.b >> color.a;
+                    m_Program.constantColor = color;
+                }
+            }
+            else if (key == "texture")
+            {
+                m_Program.useTexture = !value.empty() && value != "none";
+            }
+            else if (key == "lighting")
+            {
+                m_Program.directionalLighting = value == "directional";
+            }
+            else if (key == "alphaDiscard")
+            {
+                m_Program.alphaDiscard = std::stof(value);
+            }
+            else if (key == "positionDecode")
+            {
+                std::istringstream names(value);
+                names >> m_Program.positionScaleUniform >> m_Program.positionOffsetUniform;
+            }
+            else if (key == "normals")
+            {
+                m_Program.octahedralNormals = value == "octahedral";
+            }
+            else
+            {
+                ARV_LOG_WARN("SoftwareShader::Compile() - Unknown key '{}'", key);
+            }
+        }
+    }
+
+    // Uniforms are only stored; the rasterizer snapshots them when a draw is recorded
+    void SoftwareShader::UploadUniformInt(const std::string& name, int value)
+    {
+        m_IntUniforms[name] = value;
+    }
+
+    void SoftwareShader::UploadUniformFloat(const std::string& name, float value)
+    {
+        m_FloatUniforms[name] = value;
+    }
+
+    void SoftwareShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value)
+    {
+        m_Float2Uniforms[name] = value;
+    }
+
+    void SoftwareShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value)
+    {
+        m_Float3Uniforms[name] = value;
+    }
+
+    void SoftwareShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value)
+    {
+        m_Float4Uniforms[name] = value;
+    }
+
+    void SoftwareShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
+    {
+        m_Mat3Uniforms[name] = matrix;
+    }
+
+    void SoftwareShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
+    {
+        m_Mat4Uniforms[name] = matrix;
+    }
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "rendering/Shader.h"
+#include "rendering/ShaderSource.h"
+#include <glm/glm.hpp>
+#include <string>
+
+namespace arv {
+
+    enum class SoftwareShaderProgramType
+    {
+        // Transforms a_Position by u_mvp and shades with color/texture/lighting
+        Surface = 0,
+        // Fullscreen pass that samples an equirectangular HDR map through u_inverseVP
+        Equirect,
+        // Fullscreen pass that samples an HDR cubemap through u_inverseVP
+        Cubemap
+    };
+
+    /**
+     * Fixed-function description of what a shader does, parsed from the
+     * "### SOFTWARE_SHADER ###" section of a ShaderSource.
+     *
+     * The section is a list of "key = value" lines:
+     *   program      = surface | equirect | cubemap
+     *   color        = u_Color            (a Float4 uniform)  or  0.0 0.7 1.0 0.3
+     *   texture      = u_Texture          (multiply by the bound texture)
+     *   lighting     = none | directional (same light as the GLSL/MSL shaders)
+     *   alphaDiscard = 0.01               (discard fragments with a lower alpha)
+     *   positionDecode = u_PositionScale u_PositionOffset
+     *                                     (Float4 uniforms; position = offset + a_Position * scale)
+     *   normals      = vector | octahedral (a_Normal is a 2-component octahedral encoding)
+     */
+    struct SoftwareShaderProgram
+    {
+        SoftwareShaderProgramType type = SoftwareShaderProgramType::Surface;
+        std::string colorUniform;
+        glm::vec4 constantColor = glm::vec4(1.0f);
+        bool useTexture = false;
+        bool directionalLighting = false;
+        float alphaDiscard = -1.0f;
+        std::string positionScaleUniform;
+        std::string positionOffsetUniform;
+        bool octahedralNormals = false;
+    };
+
+    class SoftwareShader : public Shader {
+
+    public:
+        SoftwareShader(ShaderSource* shaderSource) : Shader(shaderSource) {}
+
+        ~SoftwareShader() override = default;
+
+        void Compile() override;
+
+        void Destroy() override {}
+        void Use() override {}
+
+        inline bool IsCompiled() override { return m_Compiled; }
+
+        void UploadUniformInt(const std::string& name, int value) override;
+
+        void UploadUniformFloat(const std::string& name, float value) override;
+        void UploadUniformFloat2(const std::string& name, const glm::vec2& value) override;
+        void UploadUniformFloat3(const std::string& name, const glm::vec3& value) override;
+        void UploadUniformFloat4(const std::string& name, const glm::vec4& value) override;
+
+        void UploadUniformMat3(const std::string& name, const glm::mat3& matrix) override;
+        void UploadUniformMat4(const std::string& name, const glm::mat4& matrix) override;
+
+        // Keep the UniformId overloads visible; they forward to the name-based versions
+        using Shader::UploadUniformInt;
+        using Shader::UploadUniformFloat;
+        using Shader::UploadUniformFloat2;
+        using Shader::UploadUniformFloat3;
+        using Shader::UploadUniformFloat4;
+        using Shader::UploadUniformMat3;
+        using Shader::UploadUniformMat4;
+
+        const SoftwareShaderProgram& GetProgram() const { return m_Program; }
+
+    private:
+        SoftwareShaderProgram m_Program;
+        bool m_Compiled = false;
+    };
+
+}
@@ -0,0 +1,89 @@
+#include "SoftwareTexture.h"
+#include "ARVBase.h"
+#include "rendering/MipChain.h"
+#include <stb_image.h>
+#include <cstring>
+
+namespace arv {
+
+    SoftwareTexture2D::SoftwareTexture2D(const std::string& path, const TextureSpecification& spec)
+        : m_Spec(spec)
+    {
+        // Loaded top to bottom so mips are built as on the other backends;
+        // SetData() flips to the OpenGL orientation (origin bottom-left)
+        stbi_set_flip_vertically_on_load(false);
+
+        int width, height, channels;
+        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+
+        if (!data)
+        {
+            ARV_LOG_ERROR("Failed to load texture: {}", path);
+            return;
+        }
+
+        // Always expanded to RGBA so sampling never branches on the channel count
+        SetData(data, width, height);
+        m_Channels = channels;
+
+        stbi_image_free(data);
+
+        ARV_LOG_INFO("Software texture loaded: {} ({}x{}, {} channels, {} mip levels)",
+                     path, width, height, channels, m_Levels.size());
+    }
+
+    SoftwareTexture2D::SoftwareTexture2D(uint32_t width, uint32_t height, const void* pixels, const TextureSpecification& spec)
+        : m_Spec(spec)
+    {
+        SetData(pixels, width, height);
+    }
+
+    void SoftwareTexture2D::SetData(const void* pixels, unsigned int width, unsigned int height)
+    {
+        MipChain chain = MipChain::Build(pixels, width, height, m_Spec);
+        SetMipData(chain.GetLevels(), chain.GetLevelCount());
+    }
+
+    void SoftwareTexture2D::SetMipData(const TextureMipLevel* levels, uint32_t levelCount, TextureFormat format)
+    {
+        if (levelCount == 0)
+        {
+            return;
+        }
+        if (format != TextureFormat::RGBA8)
+        {
+            // The rasterizer samples RGBA8 only; SupportsTextureFormat() says so
+            ARV_LOG_ERROR("SoftwareTexture2D::SetMipData() - {} textures are not supported", GetTextureFormatName(format));
+            return;
+        }
+
+        m_Width = levels[0].width;
+        m_Height = levels[0].height;
+        m_Channels = 4;
+        m_TexelsF.clear();
+
+        m_Levels.resize(levelCount);
+        size_t texelCount = 0;
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            m_Levels[i].width = levels[i].width;
+            m_Levels[i].height = levels[i].height;
+            m_Levels[i].offset = texelCount;
+            texelCount += static_cast<size_t>(levels[i].width) * levels[i].height;
+        }
+
+        // Flipped to the bottom-left origin used for file textures
+        m_Texels8.resize(texelCount * 4);
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            const size_t rowBytes = static_cast<size_t>(levels[i].width) * 4;
+            const uint8_t* source = static_cast<const uint8_t*>(levels[i].pixels);
+            uint8_t* target = m_Texels8.data() + m_Levels[i].offset * 4;
+            for (unsigned int y = 0; y < levels[i].height; y++)
+            {
+                std::memcpy(target + (levels[i].height - 1 - y) * rowBytes, source + y * rowBytes, rowBytes);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arv {
+
+    /**
+     * CPU texture sampled by the software rasterizer.
+     * Texels are kept as RGBA8 (LDR images) or RGBA32F (HDR images) with the
+     * first row at the bottom, matching the OpenGL provider's flipped upload so
+     * the same texture coordinates work for both backends. LDR images keep
+     * their mip chain after level 0 in the same array.
+     */
+    class SoftwareTexture2D : public Texture2D {
+    public:
+        SoftwareTexture2D(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+        SoftwareTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                          const TextureSpecification& spec = TextureSpecification());
+        ~SoftwareTexture2D() override = default;
+
+        void Bind(unsigned int slot = 0) const override {}
+        void Unbind() const override {}
+
+        unsigned int GetWidth() const override { return m_Width; }
+        unsigned int GetHeight() const override { return m_Height; }
+        unsigned int GetChannels() const override { return m_Channels; }
+
+        // Must not run while the rasterizer is executing draws that sample this texture
+        void SetData(const void* pixels, unsigned int width, unsigned int height) override;
+        void SetMipData(const TextureMipLevel* levels, uint32_t levelCount,
+                        TextureFormat format = TextureFormat::RGBA8) override;
+
+        bool IsValid() const { return m_Width > 0 && m_Height > 0; }
+        bool HasMips() const { return m_Levels.size() > 1; }
+
+        // Bilinear sample of level 0 with clamp-to-edge addressing (GL_LINEAR / GL_CLAMP_TO_EDGE)
+        glm::vec4 Sample(float u, float v) const
+        {
+            if (!IsValid()) {
+                return glm::vec4(1.0f);
+            }
+
+            float x = u * m_Width - 0.5f;
+            float y = v * m_Height - 0.5f;
+            float fx = std::floor(x);
+            float fy = std::floor(y);
+            float tx = x - fx;
+            float ty = y - fy;
+
+            int x0 = ClampCoord(static_cast<int>(fx), m_Width);
+            int x1 = ClampCoord(static_cast<int>(fx) + 1, m_Width);
+            int y0 = ClampCoord(static_cast<int>(fy), m_Height);
+            int y1 = ClampCoord(static_cast<int>(fy) + 1, m_Height);
+
+            glm::vec4 top = Texel(x0, y0) * (1.0f - tx) + Texel(x1, y0) * tx;
+            glm::vec4 bottom = Texel(x0, y1) * (1.0f - tx) + Texel(x1, y1) * tx;
+            return top * (1.0f - ty) + bottom * ty;
+        }
+
+        // Level of detail for texture coordinates that change by dUVdx and dUVdy
+        // from one pixel to the next, as GPUs compute it (isotropic: the longer
+        // of the two footprint axes picks the level)
+        float ComputeLod(const glm::vec2& dUVdx, const glm::vec2& dUVdy) const
+        {
+            glm::vec2 size(static_cast<float>(m_Width), static_cast<float>(m_Height));
+            glm::vec2 dx = dUVdx * size;
+            glm::vec2 dy = dUVdy * size;
+            float rho2 = std::max(glm::dot(dx, dx), glm::dot(dy, dy));
+            return 0.5f * std::log2(std::max(rho2, 1e-12f));
+        }
+
+        // Sample with the specification's filter and wrap mode at the given level of detail
+        glm::vec4 SampleLod(float u, float v, float lod) const
+        {
+            if (!HasMips()) {
+                return SampleLevel(0, u, v);
+            }
+
+            float maxLevel = static_cast<float>(m_Levels.size() - 1);
+            lod = std::min(std::max(lod, 0.0f), maxLevel);
+            if (m_Spec.filter != TextureFilter::Trilinear) {
+                return SampleLevel(static_cast<uint32_t>(lod + 0.5f), u, v);
+            }
+
+            uint32_t level = static_cast<uint32_t>(lod);
+            float t = lod - level;
+            glm::vec4 color = SampleLevel(level, u, v);
+            if (t > 0.0f) {
+                color = color * (1.0f - t) + SampleLevel(level + 1, u, v) * t;
+            }
+            return color;
+        }
+
+    protected:
+        SoftwareTexture2D() = default;
+
+        struct MipLevel {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            size_t offset = 0;  // In texels
+        };
+
+        static int ClampCoord(int value, unsigned int size)
+        {
+            return value < 0 ? 0 : (value >= static_cast<int>(size) ? static_cast<int>(size) - 1 : value);
+        }
+
+        int AddressCoord(int value, unsigned int size) const
+        {
+            if (m_Spec.wrap == TextureWrap::Repeat) {
+                int wrapped = value % static_cast<int>(size);
+                return wrapped < 0 ? wrapped + static_cast<int>(size) : wrapped;
+            }
+            return ClampCoord(value, size);
+        }
+
+        glm::vec4 Texel(int x, int y) const
+        {
+            return TexelAt(0, static_cast<size_t>(y) * m_Width + x);
+        }
+
+        glm::vec4 TexelAt(size_t levelOffset, size_t texel) const
+        {
+            size_t index = (levelOffset + texel) * 4;
+            if (!m_TexelsF.empty()) {
+                return glm::vec4(m_TexelsF[index], m_TexelsF[index + 1], m_TexelsF[index + 2], m_TexelsF[index + 3]);
+            }
+            constexpr float scale = 1.0f / 255.0f;
+            return glm::vec4(m_Texels8[index] * scale, m_Texels8[index + 1] * scale,
+                             m_Texels8[index + 2] * scale, m_Texels8[index + 3] * scale);
+        }
+
+        glm::vec4 SampleLevel(uint32_t levelIndex, float u, float v) const
+        {
+            if (!IsValid()) {
+                return glm::vec4(1.0f);
+            }
+            if (m_Levels.empty()) {
+                return Sample(u, v);
+            }
+
+            const MipLevel& level = m_Levels[levelIndex];
+            if (m_Spec.filter == TextureFilter::Nearest) {
+                int x = AddressCoord(static_cast<int>(std::floor(u * level.width)), level.width);
+                int y = AddressCoord(static_cast<int>(std::floor(v * level.height)), level.height);
+                return TexelAt(level.offset, static_cast<size_t>(y) * level.width + x);
+            }
+
+            float x = u * level.width - 0.5f;
+            float y = v * level.height - 0.5f;
+            float fx = std::floor(x);
+            float fy = std::floor(y);
+            float tx = x - fx;
+            float ty = y - fy;
+
+            size_t x0 = AddressCoord(static_cast<int>(fx), level.width);
+            size_t x1 = AddressCoord(static_cast<int>(fx) + 1, level.width);
+            size_t row0 = static_cast<size_t>(AddressCoord(static_cast<int>(fy), level.height)) * level.width;
+            size_t row1 = static_cast<size_t>(AddressCoord(static_cast<int>(fy) + 1, level.height)) * level.width;
+
+            glm::vec4 top = TexelAt(level.offset, row0 + x0) * (1.0f - tx) + TexelAt(level.offset, row0 + x1) * tx;
+            glm::vec4 bottom = TexelAt(level.offset, row1 + x0) * (1.0f - tx) + TexelAt(level.offset, row1 + x1) * tx;
+            return top * (1.0f - ty) + bottom * ty;
+        }
+
+        unsigned int m_Width = 0;
+        unsigned int m_Height = 0;
+        unsigned int m_Channels = 0;
+
+        TextureSpecification m_Spec;
+        std::vector<MipLevel> m_Levels;  // Empty for HDR images, which have level 0 only
+        std::vector<uint8_t> m_Texels8;  // RGBA8, used for LDR images
+        std::vector<float> m_TexelsF;    // RGBA32F, used for HDR images
+    };
+
+}
@@ -0,0 +1,21 @@
+#include "SoftwareVertexArray.h"
+#include "ARVBase.h"
+
+namespace arv {
+
+    void SoftwareVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer)
+    {
+        if (vertexBuffer->GetLayout().GetElements().empty())
+        {
+            ARV_LOG_ERROR("SoftwareVertexArray::AddVertexBuffer() - Vertex buffer has no layout");
+            return;
+        }
+        m_VertexBuffers.push_back(vertexBuffer);
+    }
+
+    void SoftwareVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer)
+    {
+        m_IndexBuffer = indexBuffer;
+    }
+
+}
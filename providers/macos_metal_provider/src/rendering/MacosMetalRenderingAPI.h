@@ -38,6 +38,8 @@ namespace arv
 
         void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray) override;
         void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture) override;
+        void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                  const std::shared_ptr<Texture2D>& texture, const IndexRange& range) override;
 
         void SetClearColor(const glm::vec4& color) override;
         void Clear() override;
@@ -49,10 +51,17 @@ namespace arv
         std::shared_ptr<IndexBuffer> CreateIndexBuffer(unsigned int* indices, unsigned int size) override;
         std::shared_ptr<VertexArray> CreateVertexArray() override;
         std::shared_ptr<Shader> CreateShader(ShaderSource* shaderSource) override;
-        std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path) override;
+        std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path,
+                                                   const TextureSpecification& spec = TextureSpecification()) override;
+        std::shared_ptr<Texture2D> CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                   const TextureSpecification& spec = TextureSpecification()) override;
         std::shared_ptr<Texture2D> CreateHDRTexture2D(const std::string& path) override;
+        std::shared_ptr<TextureCube> CreateHDRTextureCube(const std::string& path) override;
         std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferSpecification& spec) override;
 
+        // BC on Macs (and Apple silicon that reports it), ETC2/ASTC on Apple GPUs
+        bool SupportsTextureFormat(TextureFormat format) const override;
+
         void SetMetalLayer(CAMetalLayer* layer);
         void BindFramebuffer(const std::shared_ptr<Framebuffer>& framebuffer);
         void UnbindFramebuffer();
@@ -83,7 +92,8 @@ namespace arv
 #endif
 
     private:
-        void DrawInternal(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture);
+        void DrawInternal(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                          const std::shared_ptr<Texture2D>& texture, const IndexRange& range = IndexRange());
         void CreateDepthTextureIfNeeded(size_t width, size_t height);
 
 #ifdef __OBJC__
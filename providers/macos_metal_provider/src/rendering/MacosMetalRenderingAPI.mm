@@ -8,9 +8,11 @@
 #include "MetalVertexArray.h"
 #include "MetalTexture.h"
 #include "MetalHDRTexture.h"
+#include "MetalHDRTextureCube.h"
 #include "MetalFramebuffer.h"
 
 #include "ARVBase.h"
+#include <algorithm>
 #include <vector>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -198,7 +200,8 @@ namespace arv
         DrawInternal(shader, vertexArray, nullptr);
     }
 
-    void MacosMetalRenderingAPI::DrawInternal(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture)
+    void MacosMetalRenderingAPI::DrawInternal(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                              const std::shared_ptr<Texture2D>& texture, const IndexRange& range)
     {
         if (!m_frameInProgress || !m_currentRenderEncoder)
         {
@@ -359,11 +362,30 @@ namespace arv
         // Bind texture if provided
         if (texture)
         {
-            MetalTexture2D* metalTex = static_cast<MetalTexture2D*>(texture.get());
-            if (metalTex && metalTex->GetMetalTexture())
+            // HDR textures and cubemaps are separate classes with their own Metal objects
+            id<MTLTexture> metalTexture = nil;
+            id<MTLSamplerState> samplerState = nil;
+            if (auto* cube = dynamic_cast<MetalHDRTextureCube*>(texture.get()))
             {
-                [m_currentRenderEncoder setFragmentTexture:metalTex->GetMetalTexture() atIndex:0];
-                [m_currentRenderEncoder setFragmentSamplerState:metalTex->GetSamplerState() atIndex:0];
+                metalTexture = cube->GetMetalTexture();
+                samplerState = cube->GetSamplerState();
+            }
+            else if (auto* hdr = dynamic_cast<MetalHDRTexture2D*>(texture.get()))
+            {
+                metalTexture = hdr->GetMetalTexture();
+                samplerState = hdr->GetSamplerState();
+            }
+            else
+            {
+                MetalTexture2D* metalTex = static_cast<MetalTexture2D*>(texture.get());
+                metalTexture = metalTex->GetMetalTexture();
+                samplerState = metalTex->GetSamplerState();
+            }
+
+            if (metalTexture)
+            {
+                [m_currentRenderEncoder setFragmentTexture:metalTexture atIndex:0];
+                [m_currentRenderEncoder setFragmentSamplerState:samplerState atIndex:0];
             }
         }
 
@@ -372,13 +394,16 @@ namespace arv
         if (indexBuffer)
         {
             MetalIndexBuffer* metalIB = static_cast<MetalIndexBuffer*>(indexBuffer.get());
-            if (metalIB && metalIB->GetMetalBuffer())
+            uint32_t totalCount = metalIB ? metalIB->GetCount() : 0;
+            uint32_t firstIndex = std::min(range.firstIndex, totalCount);
+            uint32_t indexCount = std::min(range.indexCount, totalCount - firstIndex);
+            if (metalIB && metalIB->GetMetalBuffer() && indexCount > 0)
             {
                 [m_currentRenderEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
-                                          indexCount:metalIB->GetCount()
+                                          indexCount:indexCount
                                            indexType:MTLIndexTypeUInt32
                                          indexBuffer:metalIB->GetMetalBuffer()
-                                   indexBufferOffset:0];
+                                   indexBufferOffset:firstIndex * sizeof(uint32_t)];
             }
         }
     }
@@ -419,10 +444,16 @@ namespace arv
         return std::make_shared<MetalShader>(m_device, shaderSource);
     }
 
-    std::shared_ptr<Texture2D> MacosMetalRenderingAPI::CreateTexture2D(const std::string& path)
+    std::shared_ptr<Texture2D> MacosMetalRenderingAPI::CreateTexture2D(const std::string& path, const TextureSpecification& spec)
     {
         ARV_LOG_INFO("MacosMetalRenderingAPI::CreateTexture2D() - Creating texture from path: {}", path);
-        return std::make_shared<MetalTexture2D>(m_device, path);
+        return std::make_shared<MetalTexture2D>(m_device, path, spec);
+    }
+
+    std::shared_ptr<Texture2D> MacosMetalRenderingAPI::CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                                       const TextureSpecification& spec)
+    {
+        return std::make_shared<MetalTexture2D>(m_device, width, height, pixels, spec);
     }
 
     std::shared_ptr<Texture2D> MacosMetalRenderingAPI::CreateHDRTexture2D(const std::string& path)
@@ -431,17 +462,53 @@ namespace arv
         return std::make_shared<MetalHDRTexture2D>(m_device, path);
     }
 
+    std::shared_ptr<TextureCube> MacosMetalRenderingAPI::CreateHDRTextureCube(const std::string& path)
+    {
+        ARV_LOG_INFO("MacosMetalRenderingAPI::CreateHDRTextureCube() - Creating HDR cubemap from path: {}", path);
+        return std::make_shared<MetalHDRTextureCube>(m_device, path);
+    }
+
     void MacosMetalRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture)
     {
         DrawInternal(shader, vertexArray, texture);
     }
 
+    void MacosMetalRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                      const std::shared_ptr<Texture2D>& texture, const IndexRange& range)
+    {
+        DrawInternal(shader, vertexArray, texture, range);
+    }
+
     std::shared_ptr<Framebuffer> MacosMetalRenderingAPI::CreateFramebuffer(const FramebufferSpecification& spec)
     {
         ARV_LOG_INFO("MacosMetalRenderingAPI::CreateFramebuffer() - Creating framebuffer {}x{}", spec.width, spec.height);
         return std::make_shared<MetalFramebuffer>(m_device, spec);
     }
 
+    bool MacosMetalRenderingAPI::SupportsTextureFormat(TextureFormat format) const
+    {
+        switch (format)
+        {
+            case TextureFormat::RGBA8:
+                return true;
+            case TextureFormat::BC1:
+            case TextureFormat::BC3:
+            case TextureFormat::BC5:
+            case TextureFormat::BC6H:
+            case TextureFormat::BC7:
+                if (@available(macOS 11.0, *))
+                {
+                    return m_device.supportsBCTextureCompression;
+                }
+                return true;
+            case TextureFormat::ETC2_RGB8:
+            case TextureFormat::ETC2_RGBA8:
+            case TextureFormat::ASTC_4x4:
+                return [m_device supportsFamily:MTLGPUFamilyApple2];
+        }
+        return false;
+    }
+
     void MacosMetalRenderingAPI::BindFramebuffer(const std::shared_ptr<Framebuffer>& framebuffer)
     {
         ARV_LOG_INFO("MacosMetalRenderingAPI::BindFramebuffer() - Binding framebuffer");
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include <cstdint>
+#include <string>
+
+#ifdef __OBJC__
+@protocol MTLDevice;
+@protocol MTLTexture;
+@protocol MTLSamplerState;
+#else
+typedef void MTLDevice;
+typedef void MTLTexture;
+typedef void MTLSamplerState;
+#endif
+
+namespace arv {
+
+    class MetalHDRTextureCube : public TextureCube {
+    public:
+#ifdef __OBJC__
+        MetalHDRTextureCube(id<MTLDevice> device, const std::string& path);
+#else
+        MetalHDRTextureCube(void* device, const std::string& path);
+#endif
+        ~MetalHDRTextureCube();
+
+        void Bind(unsigned int slot = 0) const override;
+        void Unbind() const override;
+
+        unsigned int GetWidth() const override { return m_FaceSize; }
+        unsigned int GetHeight() const override { return m_FaceSize; }
+        unsigned int GetChannels() const override { return 4; }
+        uint32_t GetLevelCount() const override { return m_LevelCount; }
+
+#ifdef __OBJC__
+        id<MTLTexture> GetMetalTexture() const { return m_Texture; }
+        id<MTLSamplerState> GetSamplerState() const { return m_SamplerState; }
+#else
+        void* GetMetalTexture() const { return m_Texture; }
+        void* GetSamplerState() const { return m_SamplerState; }
+#endif
+
+    private:
+#ifdef __OBJC__
+        id<MTLTexture> m_Texture = nullptr;
+        id<MTLSamplerState> m_SamplerState = nullptr;
+#else
+        void* m_Texture = nullptr;
+        void* m_SamplerState = nullptr;
+#endif
+        unsigned int m_FaceSize = 0;
+        uint32_t m_LevelCount = 0;
+    };
+
+}
@@ -0,0 +1,75 @@
+#include "MetalHDRTextureCube.h"
+#include "ARVBase.h"
+#include "rendering/HDRCubemap.h"
+
+#import <Metal/Metal.h>
+
+namespace arv {
+
+    MetalHDRTextureCube::MetalHDRTextureCube(id<MTLDevice> device, const std::string& path)
+    {
+        HDRCubemap cubemap;
+        if (!cubemap.Load(path)) {
+            ARV_LOG_ERROR("Failed to load HDR cubemap: {}", path);
+            return;
+        }
+
+        m_FaceSize = cubemap.GetFaceSize();
+        m_LevelCount = cubemap.GetLevelCount();
+
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor
+            textureCubeDescriptorWithPixelFormat:MTLPixelFormatRGBA16Float
+            size:m_FaceSize
+            mipmapped:m_LevelCount > 1];
+        desc.mipmapLevelCount = m_LevelCount;
+        desc.usage = MTLTextureUsageShaderRead;
+
+        m_Texture = [device newTextureWithDescriptor:desc];
+        if (!m_Texture) {
+            ARV_LOG_ERROR("Failed to create Metal HDR cubemap");
+            return;
+        }
+
+        // Slices are the faces in HDRCubemap order; the texels are uploaded from the mapped cache as they are
+        for (uint32_t level = 0; level < m_LevelCount; level++) {
+            NSUInteger size = cubemap.GetLevelSize(level);
+            NSUInteger bytesPerRow = size * 4 * sizeof(uint16_t);
+            for (uint32_t face = 0; face < HDRCubemap::FaceCount; face++) {
+                [m_Texture replaceRegion:MTLRegionMake2D(0, 0, size, size)
+                             mipmapLevel:level
+                                   slice:face
+                               withBytes:cubemap.GetFace(level, face)
+                             bytesPerRow:bytesPerRow
+                           bytesPerImage:bytesPerRow * size];
+            }
+        }
+
+        MTLSamplerDescriptor* samplerDesc = [[MTLSamplerDescriptor alloc] init];
+        samplerDesc.minFilter = MTLSamplerMinMagFilterLinear;
+        samplerDesc.magFilter = MTLSamplerMinMagFilterLinear;
+        samplerDesc.mipFilter = MTLSamplerMipFilterLinear;
+        samplerDesc.sAddressMode = MTLSamplerAddressModeClampToEdge;
+        samplerDesc.tAddressMode = MTLSamplerAddressModeClampToEdge;
+        samplerDesc.rAddressMode = MTLSamplerAddressModeClampToEdge;
+        m_SamplerState = [device newSamplerStateWithDescriptor:samplerDesc];
+
+        ARV_LOG_INFO("Metal HDR cubemap loaded: {} ({}x{} faces, {} levels)", path, m_FaceSize, m_FaceSize, m_LevelCount);
+    }
+
+    MetalHDRTextureCube::~MetalHDRTextureCube()
+    {
+        m_Texture = nil;
+        m_SamplerState = nil;
+    }
+
+    void MetalHDRTextureCube::Bind(unsigned int slot) const
+    {
+        // No-op for Metal — binding done in Draw
+    }
+
+    void MetalHDRTextureCube::Unbind() const
+    {
+        // No-op for Metal
+    }
+
+}
@@ -80,6 +80,15 @@ namespace arv {
         void UploadUniformMat3(const std::string& name, const glm::mat3& matrix) override;
         void UploadUniformMat4(const std::string& name, const glm::mat4& matrix) override;
 
+        // Keep the UniformId overloads visible; they forward to the name-based versions
+        using Shader::UploadUniformInt;
+        using Shader::UploadUniformFloat;
+        using Shader::UploadUniformFloat2;
+        using Shader::UploadUniformFloat3;
+        using Shader::UploadUniformFloat4;
+        using Shader::UploadUniformMat3;
+        using Shader::UploadUniformMat4;
+
 #ifdef __OBJC__
         id<MTLRenderPipelineState> GetPipelineState() const { return m_pipelineState; }
 #else
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rendering/Texture.h"
+#include <cstdint>
 #include <string>
 
 #ifdef __OBJC__
@@ -18,9 +19,13 @@ namespace arv {
     class MetalTexture2D : public Texture2D {
     public:
 #ifdef __OBJC__
-        MetalTexture2D(id<MTLDevice> device, const std::string& path);
+        MetalTexture2D(id<MTLDevice> device, const std::string& path, const TextureSpecification& spec = TextureSpecification());
+        MetalTexture2D(id<MTLDevice> device, uint32_t width, uint32_t height, const void* pixels,
+                       const TextureSpecification& spec = TextureSpecification());
 #else
-        MetalTexture2D(void* device, const std::string& path);
+        MetalTexture2D(void* device, const std::string& path, const TextureSpecification& spec = TextureSpecification());
+        MetalTexture2D(void* device, uint32_t width, uint32_t height, const void* pixels,
+                       const TextureSpecification& spec = TextureSpecification());
 #endif
         ~MetalTexture2D();
 
@@ -31,6 +36,11 @@ namespace arv {
         unsigned int GetHeight() const override { return m_Height; }
         unsigned int GetChannels() const override { return m_Channels; }
 
+        // Always allocates new storage; draws already encoded keep the old texture
+        void SetData(const void* pixels, unsigned int width, unsigned int height) override;
+        void SetMipData(const TextureMipLevel* levels, uint32_t levelCount,
+                        TextureFormat format = TextureFormat::RGBA8) override;
+
 #ifdef __OBJC__
         id<MTLTexture> GetMetalTexture() const { return m_Texture; }
         id<MTLSamplerState> GetSamplerState() const { return m_SamplerState; }
@@ -40,10 +50,16 @@ namespace arv {
 #endif
 
     private:
+        void CreateSamplerState();
+
+        TextureSpecification m_Spec;
+
 #ifdef __OBJC__
+        id<MTLDevice> m_Device = nullptr;
         id<MTLTexture> m_Texture = nullptr;
         id<MTLSamplerState> m_SamplerState = nullptr;
 #else
+        void* m_Device = nullptr;
         void* m_Texture = nullptr;
         void* m_SamplerState = nullptr;
 #endif
@@ -1,12 +1,33 @@
 #include "MetalTexture.h"
 #include "ARVBase.h"
+#include "rendering/MipChain.h"
 
 #import <Metal/Metal.h>
 #include <stb_image.h>
+#include <algorithm>
 
 namespace arv {
 
-    MetalTexture2D::MetalTexture2D(id<MTLDevice> device, const std::string& path)
+    // Texels stay in their 8-bit encoding, as for RGBA8 (see TextureSpecification::srgb)
+    static MTLPixelFormat GetPixelFormat(TextureFormat format)
+    {
+        switch (format)
+        {
+            case TextureFormat::RGBA8: return MTLPixelFormatRGBA8Unorm;
+            case TextureFormat::BC1: return MTLPixelFormatBC1_RGBA;
+            case TextureFormat::BC3: return MTLPixelFormatBC3_RGBA;
+            case TextureFormat::BC5: return MTLPixelFormatBC5_RGUnorm;
+            case TextureFormat::BC6H: return MTLPixelFormatBC6H_RGBUfloat;
+            case TextureFormat::BC7: return MTLPixelFormatBC7_RGBAUnorm;
+            case TextureFormat::ETC2_RGB8: return MTLPixelFormatETC2_RGB8;
+            case TextureFormat::ETC2_RGBA8: return MTLPixelFormatEAC_RGBA8;
+            case TextureFormat::ASTC_4x4: return MTLPixelFormatASTC_4x4_LDR;
+        }
+        return MTLPixelFormatInvalid;
+    }
+
+    MetalTexture2D::MetalTexture2D(id<MTLDevice> device, const std::string& path, const TextureSpecification& spec)
+        : m_Spec(spec), m_Device(device)
     {
         // Don't flip for Metal (Metal expects top-left origin)
         stbi_set_flip_vertically_on_load(false);
@@ -21,46 +42,101 @@ namespace arv {
             return;
         }
 
-        m_Width = width;
-        m_Height = height;
-        m_Channels = 4; // We forced RGBA
+        CreateSamplerState();
+        SetData(data, width, height);
 
-        // Create texture descriptor
-        MTLTextureDescriptor* textureDescriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA8Unorm
-                                                                                                     width:width
-                                                                                                    height:height
-                                                                                                 mipmapped:NO];
-        textureDescriptor.usage = MTLTextureUsageShaderRead;
+        stbi_image_free(data);
 
-        // Create the texture
-        m_Texture = [device newTextureWithDescriptor:textureDescriptor];
+        ARV_LOG_INFO("Metal texture loaded: {} ({}x{}, {} channels)", path, width, height, m_Channels);
+    }
+
+    MetalTexture2D::MetalTexture2D(id<MTLDevice> device, uint32_t width, uint32_t height, const void* pixels,
+                                   const TextureSpecification& spec)
+        : m_Spec(spec), m_Device(device)
+    {
+        CreateSamplerState();
+        SetData(pixels, width, height);
+    }
 
-        if (!m_Texture)
+    void MetalTexture2D::CreateSamplerState()
+    {
+        MTLSamplerDescriptor* samplerDescriptor = [[MTLSamplerDescriptor alloc] init];
+        switch (m_Spec.filter)
         {
-            ARV_LOG_ERROR("Failed to create Metal texture");
-            stbi_image_free(data);
-            return;
+            case TextureFilter::Nearest:
+                samplerDescriptor.minFilter = MTLSamplerMinMagFilterNearest;
+                samplerDescriptor.magFilter = MTLSamplerMinMagFilterNearest;
+                samplerDescriptor.mipFilter = MTLSamplerMipFilterNearest;
+                break;
+            case TextureFilter::Linear:
+                samplerDescriptor.minFilter = MTLSamplerMinMagFilterLinear;
+                samplerDescriptor.magFilter = MTLSamplerMinMagFilterLinear;
+                samplerDescriptor.mipFilter = MTLSamplerMipFilterNearest;
+                break;
+            case TextureFilter::Trilinear:
+                samplerDescriptor.minFilter = MTLSamplerMinMagFilterLinear;
+                samplerDescriptor.magFilter = MTLSamplerMinMagFilterLinear;
+                samplerDescriptor.mipFilter = MTLSamplerMipFilterLinear;
+                break;
         }
 
-        // Copy image data to texture
-        MTLRegion region = MTLRegionMake2D(0, 0, width, height);
-        [m_Texture replaceRegion:region
-                     mipmapLevel:0
-                       withBytes:data
-                     bytesPerRow:width * 4];
+        MTLSamplerAddressMode addressMode = m_Spec.wrap == TextureWrap::Repeat ? MTLSamplerAddressModeRepeat
+                                                                               : MTLSamplerAddressModeClampToEdge;
+        samplerDescriptor.sAddressMode = addressMode;
+        samplerDescriptor.tAddressMode = addressMode;
 
-        stbi_image_free(data);
+        // Metal accepts 1 to 16
+        samplerDescriptor.maxAnisotropy = static_cast<NSUInteger>(std::min(std::max(m_Spec.maxAnisotropy, 1.0f), 16.0f));
 
-        // Create sampler state
-        MTLSamplerDescriptor* samplerDescriptor = [[MTLSamplerDescriptor alloc] init];
-        samplerDescriptor.minFilter = MTLSamplerMinMagFilterLinear;
-        samplerDescriptor.magFilter = MTLSamplerMinMagFilterLinear;
-        samplerDescriptor.sAddressMode = MTLSamplerAddressModeClampToEdge;
-        samplerDescriptor.tAddressMode = MTLSamplerAddressModeClampToEdge;
+        m_SamplerState = [m_Device newSamplerStateWithDescriptor:samplerDescriptor];
+    }
 
-        m_SamplerState = [device newSamplerStateWithDescriptor:samplerDescriptor];
+    void MetalTexture2D::SetData(const void* pixels, unsigned int width, unsigned int height)
+    {
+        MipChain chain = MipChain::Build(pixels, width, height, m_Spec);
+        SetMipData(chain.GetLevels(), chain.GetLevelCount());
+    }
 
-        ARV_LOG_INFO("Metal texture loaded: {} ({}x{}, {} channels)", path, width, height, m_Channels);
+    void MetalTexture2D::SetMipData(const TextureMipLevel* levels, uint32_t levelCount, TextureFormat format)
+    {
+        if (levelCount == 0)
+        {
+            return;
+        }
+        unsigned int width = levels[0].width;
+        unsigned int height = levels[0].height;
+
+        // New storage every time: the GPU may still be reading the old texture
+        // for frames in flight, and those keep it alive until they complete
+        MTLTextureDescriptor* textureDescriptor = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:GetPixelFormat(format)
+                                                                                                     width:width
+                                                                                                    height:height
+                                                                                                 mipmapped:levelCount > 1];
+        textureDescriptor.mipmapLevelCount = levelCount;
+        textureDescriptor.usage = MTLTextureUsageShaderRead;
+        id<MTLTexture> texture = [m_Device newTextureWithDescriptor:textureDescriptor];
+        if (!texture)
+        {
+            ARV_LOG_ERROR("MetalTexture2D::SetMipData() - Failed to create {}x{} {} texture",
+                          width, height, GetTextureFormatName(format));
+            return;
+        }
+
+        // Metal's origin is top-left like the source rows, so no flip is needed.
+        // Compressed levels are copied as they are, a row of blocks at a time.
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            MTLRegion region = MTLRegionMake2D(0, 0, levels[i].width, levels[i].height);
+            [texture replaceRegion:region
+                       mipmapLevel:i
+                         withBytes:levels[i].pixels
+                       bytesPerRow:GetTextureRowPitch(format, levels[i].width)];
+        }
+
+        m_Texture = texture;
+        m_Width = width;
+        m_Height = height;
+        m_Channels = 4;
     }
 
     MetalTexture2D::~MetalTexture2D()
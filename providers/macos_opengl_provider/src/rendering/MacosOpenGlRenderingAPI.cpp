@@ -1,6 +1,9 @@
 #include "MacosOpenGlRenderingAPI.h"
 #include "ARVBase.h"
 #include <glad/glad.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
 #include "OpenGLBuffer.h"
@@ -8,11 +11,74 @@
 #include "OpenGLVertexArray.h"
 #include "OpenGLTexture.h"
 #include "OpenGLHDRTexture.h"
+#include "OpenGLHDRTextureCube.h"
 #include "OpenGLFramebuffer.h"
 
 namespace arv
 {
+    // Sort key layout, most significant bits first:
+    //   pass (2) | shader (14) | texture (12) | vertex array (12) | depth (24)   Background, Opaque
+    //   pass (2) | inverted depth (24) | shader (14) | texture (12) | vertex array (12)   Transparent, Overlay
+    // State-first ordering groups draws that share a shader, texture or vertex array
+    // (front to back within a group). Blended passes need strict back-to-front order,
+    // so depth comes first there and state only breaks ties.
+    static constexpr uint32_t SortKeyShaderBits = 14;
+    static constexpr uint32_t SortKeyTextureBits = 12;
+    static constexpr uint32_t SortKeyVertexArrayBits = 12;
+    static constexpr uint32_t SortKeyDepthBits = 24;
+
+    // First attribute location of the instance stream (see InstanceData)
+    static constexpr GLuint InstanceAttributeLocation = 8;
+
+    // Folds a pointer into a small id. Equal pointers always share an id;
+    // a collision only costs a missed grouping, never a wrong draw.
+    static uint64_t PointerSortId(const void* pointer, uint32_t bits)
+    {
+        if (!pointer)
+        {
+            return 0;
+        }
+        uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)) >> 4;
+        return (value * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+    }
+
+    // View depth quantized to SortKeyDepthBits. The bit pattern of a positive
+    // float increases with its value, so dropping low mantissa bits keeps the order.
+    static uint64_t QuantizeSortDepth(float depth)
+    {
+        if (!(depth > 0.0f))
+        {
+            return 0;
+        }
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return bits >> (32 - SortKeyDepthBits);
+    }
 
+    static constexpr UniformId MvpUniform("u_mvp");
+    static constexpr UniformId ViewProjectionUniform("u_viewProjection");
+
+    // depth is the clip-space w of the object origin, i.e. its distance along the view axis
+    static uint64_t BuildSortKey(DrawPass pass, const OpenGLDrawCommand& cmd, float depth)
+    {
+        uint64_t shader = PointerSortId(cmd.shader, SortKeyShaderBits);
+        uint64_t texture = PointerSortId(cmd.texture, SortKeyTextureBits);
+        uint64_t vertexArray = PointerSortId(cmd.vertexArray, SortKeyVertexArrayBits);
+        uint64_t state = (shader << (SortKeyTextureBits + SortKeyVertexArrayBits)) | (texture << SortKeyVertexArrayBits) | vertexArray;
+        uint64_t quantizedDepth = QuantizeSortDepth(depth);
+
+        uint64_t key = static_cast<uint64_t>(pass) << 62;
+        if (pass == DrawPass::Transparent || pass == DrawPass::Overlay)
+        {
+            uint64_t farFirst = ((1ull << SortKeyDepthBits) - 1) - quantizedDepth;
+            key |= (farFirst << 38) | state;
+        }
+        else
+        {
+            key |= (state << SortKeyDepthBits) | quantizedDepth;
+        }
+        return key;
+    }
 
     MacosOpenGlRenderingAPI::MacosOpenGlRenderingAPI()
     {
@@ -21,16 +87,76 @@ namespace arv
 
     MacosOpenGlRenderingAPI::~MacosOpenGlRenderingAPI()
     {
-
+        if (m_instanceBuffer)
+        {
+            glDeleteBuffers(1, &m_instanceBuffer);
+        }
     }
 
     void MacosOpenGlRenderingAPI::Init(PlatformApplicationContext* context)
     {
         ARV_LOG_INFO("MacosOpenGlRenderingAPI::Init() - Enabling depth testing");
         glEnable(GL_DEPTH_TEST);
+        // Filter across cubemap face edges, as Metal always does
+        glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+        glGenBuffers(1, &m_instanceBuffer);
+
+        m_programCache = std::make_unique<OpenGLProgramCache>();
+
+        m_frameUniformBuffer = std::make_unique<OpenGLUniformBuffer>(static_cast<uint32_t>(sizeof(FrameUniforms)));
+
+        // Every bound range must start at a multiple of the offset alignment (often 256)
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        if (alignment > 0)
+        {
+            m_objectUniformStride = (m_objectUniformStride + alignment - 1) / alignment * alignment;
+        }
+        m_objectSegmentSize = m_objectUniformStride * 1024;
+        m_objectUniformBuffer = std::make_unique<OpenGLUniformBuffer>(m_objectSegmentSize * ObjectRingSegments);
+
+        // RGTC (BC5) is core since 3.0; the other block formats depend on the driver
+        // (macOS stops at 4.1 with S3TC, so BC6H/BC7 and ETC2/ASTC stay unsupported there)
+        auto enable = [this](TextureFormat format) { m_textureFormats |= 1u << static_cast<uint32_t>(format); };
+        enable(TextureFormat::BC5);
+        GLint extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (GLint i = 0; i < extensionCount; i++)
+        {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (!name)
+            {
+                continue;
+            }
+            if (std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+            {
+                enable(TextureFormat::BC1);
+                enable(TextureFormat::BC3);
+            }
+            else if (std::strcmp(name, "GL_ARB_texture_compression_bptc") == 0)
+            {
+                enable(TextureFormat::BC6H);
+                enable(TextureFormat::BC7);
+            }
+            else if (std::strcmp(name, "GL_ARB_ES3_compatibility") == 0)
+            {
+                enable(TextureFormat::ETC2_RGB8);
+                enable(TextureFormat::ETC2_RGBA8);
+            }
+            else if (std::strcmp(name, "GL_KHR_texture_compression_astc_ldr") == 0)
+            {
+                enable(TextureFormat::ASTC_4x4);
+            }
+        }
+
         ARV_LOG_INFO("MacosOpenGlRenderingAPI::Init() - OpenGL Rendering API initialized");
     }
 
+    bool MacosOpenGlRenderingAPI::SupportsTextureFormat(TextureFormat format) const
+    {
+        return (m_textureFormats >> static_cast<uint32_t>(format)) & 1u;
+    }
+
     void MacosOpenGlRenderingAPI::DrawExample()
     {
 
@@ -38,12 +164,98 @@ namespace arv
 
     void MacosOpenGlRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray)
     {
-        m_drawCommands.push_back({shader, vertexArray, nullptr});
+        Submit(shader, vertexArray, nullptr);
     }
 
     void MacosOpenGlRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture)
     {
-        m_drawCommands.push_back({shader, vertexArray, texture});
+        Submit(shader, vertexArray, texture);
+    }
+
+    void MacosOpenGlRenderingAPI::Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                       const std::shared_ptr<Texture2D>& texture, const IndexRange& range)
+    {
+        Submit(shader, vertexArray, texture, range);
+    }
+
+    void MacosOpenGlRenderingAPI::DrawInstanced(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                                const std::shared_ptr<Texture2D>& texture, const InstanceData* instances,
+                                                uint32_t instanceCount, const glm::mat4& viewProjection,
+                                                const IndexRange& range)
+    {
+        if (!shader->SupportsInstancing())
+        {
+            RenderingAPI::DrawInstanced(shader, vertexArray, texture, instances, instanceCount, viewProjection, range);
+            return;
+        }
+        if (instanceCount == 0)
+        {
+            return;
+        }
+
+        OpenGLDrawCommand& cmd = Submit(shader, vertexArray, texture, range);
+        cmd.firstInstance = static_cast<uint32_t>(m_instanceData.size());
+        cmd.instanceCount = instanceCount;
+        int32_t viewProjectionOffset = cmd.shader->GetStagedOffset(ViewProjectionUniform);
+        if (viewProjectionOffset >= 0)
+        {
+            std::memcpy(cmd.uniforms + viewProjectionOffset, &viewProjection[0][0], sizeof(glm::mat4));
+        }
+        m_instanceData.insert(m_instanceData.end(), instances, instances + instanceCount);
+    }
+
+    void MacosOpenGlRenderingAPI::SetFrameUniforms(const FrameUniforms& uniforms)
+    {
+        m_frameUniforms = uniforms;
+        m_frameUniformsDirty = true;
+    }
+
+    void MacosOpenGlRenderingAPI::SetObjectUniforms(const ObjectUniforms& uniforms)
+    {
+        m_pendingObjectUniforms = uniforms;
+        m_hasPendingObjectUniforms = true;
+    }
+
+    OpenGLDrawCommand& MacosOpenGlRenderingAPI::Submit(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                                       const std::shared_ptr<Texture2D>& texture, const IndexRange& range)
+    {
+        const OpenGLShader* glShader = static_cast<const OpenGLShader*>(shader.get());
+        const float* staged = glShader->GetStagedUniforms();
+        uint32_t stagedCount = glShader->GetStagedUniformCount();
+
+        OpenGLDrawCommand& cmd = *m_frameArena.New<OpenGLDrawCommand>();
+        cmd.shader = glShader;
+        cmd.vertexArray = vertexArray.get();
+        cmd.texture = texture.get();
+        uint32_t totalCount = vertexArray->GetIndexBuffer()->GetCount();
+        cmd.firstIndex = std::min(range.firstIndex, totalCount);
+        cmd.indexCount = std::min(range.indexCount, totalCount - cmd.firstIndex);
+        cmd.firstInstance = 0;
+        cmd.instanceCount = 0;
+        cmd.objectUniforms = OpenGLDrawCommand::NoObjectUniforms;
+        cmd.uniforms = m_frameArena.AllocateArray<float>(stagedCount);
+        std::memcpy(cmd.uniforms, staged, stagedCount * sizeof(float));
+
+        float depth = 0.0f;
+        int32_t mvpOffset = glShader->GetStagedOffset(MvpUniform);
+        if (mvpOffset >= 0)
+        {
+            depth = staged[mvpOffset + 15];  // mvp[3][3]
+        }
+
+        if (m_hasPendingObjectUniforms && glShader->UsesObjectBlock())
+        {
+            cmd.objectUniforms = static_cast<uint32_t>(m_objectUniforms.size());
+            m_objectUniforms.push_back(m_pendingObjectUniforms);
+            if (mvpOffset < 0)
+            {
+                depth = m_pendingObjectUniforms.mvp[3][3];
+            }
+        }
+        m_hasPendingObjectUniforms = false;
+
+        m_sortEntries.push_back({BuildSortKey(m_DrawPass, cmd, depth), &cmd});
+        return cmd;
     }
 
     void MacosOpenGlRenderingAPI::SetClearColor(const glm::vec4& color)
@@ -58,9 +270,23 @@ namespace arv
 
     void MacosOpenGlRenderingAPI::BeginFrame()
     {
-        m_drawCommands.clear();
+        m_sortEntries.clear();
+        m_instanceData.clear();
+        m_objectUniforms.clear();
+        m_hasPendingObjectUniforms = false;
         m_frameInProgress = true;
 
+        m_frameStats.queueMemoryUsed = static_cast<uint32_t>(m_frameArena.GetUsed());
+        m_frameStats.queueMemoryHighWater = static_cast<uint32_t>(m_frameArena.GetHighWater());
+        m_frameArena.Reset();
+
+        // Draws of this frame write the next segment of the object uniform ring
+        m_objectSegment = (m_objectSegment + 1) % ObjectRingSegments;
+        m_objectSegmentCursor = 0;
+
+        m_RenderStats = m_frameStats;
+        m_frameStats = RenderStats();
+
         // Clear the default framebuffer at the start of each frame
         // This ensures no leftover content from previous frames
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -68,30 +294,211 @@ namespace arv
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
+    void MacosOpenGlRenderingAPI::SortDrawCommands()
+    {
+        uint32_t count = static_cast<uint32_t>(m_sortEntries.size());
+        m_sortScratch.resize(count);
+
+        // LSD radix sort, one byte per pass. It is stable, so equal keys keep
+        // submission order. Bytes that are the same for every key are skipped.
+        for (uint32_t shift = 0; shift < 64; shift += 8)
+        {
+            uint32_t offsets[256] = {};
+            for (const SortEntry& entry : m_sortEntries)
+            {
+                offsets[(entry.key >> shift) & 0xFF]++;
+            }
+            if (offsets[(m_sortEntries[0].key >> shift) & 0xFF] == count)
+            {
+                continue;
+            }
+
+            uint32_t sum = 0;
+            for (uint32_t& offset : offsets)
+            {
+                uint32_t bucketSize = offset;
+                offset = sum;
+                sum += bucketSize;
+            }
+            for (const SortEntry& entry : m_sortEntries)
+            {
+                m_sortScratch[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+            m_sortEntries.swap(m_sortScratch);
+        }
+    }
+
+    void MacosOpenGlRenderingAPI::UploadInstanceData()
+    {
+        // One upload for every instanced draw of this flush; each draw points its
+        // attributes at its own range of the buffer
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+        glBufferData(GL_ARRAY_BUFFER, m_instanceData.size() * sizeof(InstanceData), m_instanceData.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void MacosOpenGlRenderingAPI::BindInstanceAttributes(uint32_t firstInstance)
+    {
+        // Attribute pointers are vertex array state, so this runs after the vertex array is bound
+        const GLsizei stride = sizeof(InstanceData);
+        const size_t base = firstInstance * sizeof(InstanceData);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+        for (GLuint column = 0; column < 4; column++)
+        {
+            GLuint location = InstanceAttributeLocation + column;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                                  (const void*)(base + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+            glVertexAttribDivisor(location, 1);
+        }
+
+        GLuint tintLocation = InstanceAttributeLocation + 4;
+        glEnableVertexAttribArray(tintLocation);
+        glVertexAttribPointer(tintLocation, 4, GL_FLOAT, GL_FALSE, stride,
+                              (const void*)(base + offsetof(InstanceData, tint)));
+        glVertexAttribDivisor(tintLocation, 1);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    uint32_t MacosOpenGlRenderingAPI::UploadObjectUniforms()
+    {
+        uint32_t bytes = static_cast<uint32_t>(m_objectUniforms.size()) * m_objectUniformStride;
+        if (m_objectSegmentCursor + bytes > m_objectSegmentSize)
+        {
+            // Reallocating orphans the old storage, so draws still in flight keep their data
+            uint32_t segmentSize = m_objectSegmentSize * 2;
+            while (segmentSize < bytes)
+            {
+                segmentSize *= 2;
+            }
+            ARV_LOG_INFO("MacosOpenGlRenderingAPI::UploadObjectUniforms() - Growing object uniform segments from {} to {} bytes",
+                         m_objectSegmentSize, segmentSize);
+            m_objectSegmentSize = segmentSize;
+            m_objectUniformBuffer->Resize(m_objectSegmentSize * ObjectRingSegments);
+            m_objectSegment = 0;
+            m_objectSegmentCursor = 0;
+        }
+
+        m_objectUniformStaging.resize(bytes);
+        for (size_t i = 0; i < m_objectUniforms.size(); i++)
+        {
+            std::memcpy(m_objectUniformStaging.data() + i * m_objectUniformStride, &m_objectUniforms[i], sizeof(ObjectUniforms));
+        }
+
+        uint32_t base = m_objectSegment * m_objectSegmentSize + m_objectSegmentCursor;
+        m_objectUniformBuffer->SetData(m_objectUniformStaging.data(), bytes, base);
+        m_objectSegmentCursor += bytes;
+        return base;
+    }
+
     void MacosOpenGlRenderingAPI::FlushDrawCommands()
     {
+        if (m_sortEntries.empty())
+        {
+            return;
+        }
+
+        SortDrawCommands();
+        if (!m_instanceData.empty())
+        {
+            UploadInstanceData();
+        }
+
+        if (m_frameUniformsDirty)
+        {
+            m_frameUniformBuffer->SetData(&m_frameUniforms, sizeof(FrameUniforms));
+            m_frameUniformsDirty = false;
+        }
+        m_frameUniformBuffer->Bind(FrameBlockBinding);
+        uint32_t objectUniformBase = m_objectUniforms.empty() ? 0 : UploadObjectUniforms();
+
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        for (const auto& cmd : m_drawCommands)
+        const Shader* boundShader = nullptr;
+        bool boundInstanced = false;
+        const VertexArray* boundVertexArray = nullptr;
+        const Texture2D* boundTexture = nullptr;
+
+        for (const SortEntry& entry : m_sortEntries)
         {
-            if (cmd.texture)
+            const OpenGLDrawCommand& cmd = *entry.command;
+            const OpenGLShader* shader = cmd.shader;
+            bool instanced = cmd.instanceCount > 0;
+
+            if (shader != boundShader || instanced != boundInstanced)
             {
-                cmd.texture->Bind(0);
+                shader->Bind(instanced);
+                boundShader = shader;
+                boundInstanced = instanced;
+                m_frameStats.shaderBinds++;
+            }
+            else
+            {
+                m_frameStats.stateChangesSkipped++;
+            }
+            shader->ApplyUniforms(cmd.uniforms, instanced);
+            if (cmd.objectUniforms != OpenGLDrawCommand::NoObjectUniforms)
+            {
+                m_objectUniformBuffer->BindRange(ObjectBlockBinding, objectUniformBase + cmd.objectUniforms * m_objectUniformStride,
+                                                 static_cast<uint32_t>(sizeof(ObjectUniforms)));
             }
 
-            cmd.shader->Use();
-            cmd.vertexArray->Bind();
-            glDrawElements(GL_TRIANGLES, cmd.vertexArray->GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
+            if (cmd.texture != boundTexture)
+            {
+                if (cmd.texture)
+                {
+                    cmd.texture->Bind(0);
+                    m_frameStats.textureBinds++;
+                }
+                else
+                {
+                    boundTexture->Unbind();
+                }
+                boundTexture = cmd.texture;
+            }
+            else if (cmd.texture)
+            {
+                m_frameStats.stateChangesSkipped++;
+            }
 
-            if (cmd.texture)
+            if (cmd.vertexArray != boundVertexArray)
             {
-                cmd.texture->Unbind();
+                cmd.vertexArray->Bind();
+                boundVertexArray = cmd.vertexArray;
+                m_frameStats.vertexArrayBinds++;
             }
+            else
+            {
+                m_frameStats.stateChangesSkipped++;
+            }
+
+            // Byte offset into the bound element buffer
+            const void* indexOffset = (const void*)(static_cast<uintptr_t>(cmd.firstIndex) * sizeof(uint32_t));
+            if (instanced)
+            {
+                BindInstanceAttributes(cmd.firstInstance);
+                glDrawElementsInstanced(GL_TRIANGLES, cmd.indexCount, GL_UNSIGNED_INT, indexOffset, cmd.instanceCount);
+                m_frameStats.instancedDraws++;
+                m_frameStats.instances += cmd.instanceCount;
+            }
+            else
+            {
+                glDrawElements(GL_TRIANGLES, cmd.indexCount, GL_UNSIGNED_INT, indexOffset);
+            }
+            m_frameStats.drawCalls++;
+        }
+
+        if (boundTexture)
+        {
+            boundTexture->Unbind();
         }
 
         glDisable(GL_BLEND);
-        m_drawCommands.clear();
+        m_sortEntries.clear();
+        m_instanceData.clear();
+        m_objectUniforms.clear();
     }
 
     void MacosOpenGlRenderingAPI::EndFrame()
@@ -128,13 +535,19 @@ namespace arv
     std::shared_ptr<Shader> MacosOpenGlRenderingAPI::CreateShader(ShaderSource* shaderSource)
     {
         ARV_LOG_INFO("MacosOpenGlRenderingAPI::CreateShader() - Creating shader from source");
-        return std::make_shared<OpenGLShader>(shaderSource);
+        return std::make_shared<OpenGLShader>(shaderSource, m_programCache.get());
     }
 
-    std::shared_ptr<Texture2D> MacosOpenGlRenderingAPI::CreateTexture2D(const std::string& path)
+    std::shared_ptr<Texture2D> MacosOpenGlRenderingAPI::CreateTexture2D(const std::string& path, const TextureSpecification& spec)
     {
         ARV_LOG_INFO("MacosOpenGlRenderingAPI::CreateTexture2D() - Creating texture from path: {}", path);
-        return std::make_shared<OpenGLTexture2D>(path);
+        return std::make_shared<OpenGLTexture2D>(path, spec);
+    }
+
+    std::shared_ptr<Texture2D> MacosOpenGlRenderingAPI::CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                                        const TextureSpecification& spec)
+    {
+        return std::make_shared<OpenGLTexture2D>(width, height, pixels, spec);
     }
 
     std::shared_ptr<Texture2D> MacosOpenGlRenderingAPI::CreateHDRTexture2D(const std::string& path)
@@ -143,10 +556,21 @@ namespace arv
         return std::make_shared<OpenGLHDRTexture2D>(path);
     }
 
+    std::shared_ptr<TextureCube> MacosOpenGlRenderingAPI::CreateHDRTextureCube(const std::string& path)
+    {
+        ARV_LOG_INFO("MacosOpenGlRenderingAPI::CreateHDRTextureCube() - Creating HDR cubemap from path: {}", path);
+        return std::make_shared<OpenGLHDRTextureCube>(path);
+    }
+
     std::shared_ptr<Framebuffer> MacosOpenGlRenderingAPI::CreateFramebuffer(const FramebufferSpecification& spec)
     {
         ARV_LOG_INFO("MacosOpenGlRenderingAPI::CreateFramebuffer() - Creating framebuffer {}x{}", spec.width, spec.height);
         return std::make_shared<OpenGLFramebuffer>(spec);
     }
 
+    std::shared_ptr<UniformBuffer> MacosOpenGlRenderingAPI::CreateUniformBuffer(uint32_t size)
+    {
+        return std::make_shared<OpenGLUniformBuffer>(size);
+    }
+
 }
@@ -1,14 +1,36 @@
 #pragma once
 #include "rendering/RenderingAPI.h"
+#include "OpenGLBuffer.h"
+#include "OpenGLProgramCache.h"
+#include "utils/FrameArena.h"
+#include <string>
 #include <vector>
 
 namespace arv
 {
+    class OpenGLShader;
+
+    // Draw packet in the frame arena. Plain data with raw handles: the submitted
+    // resources must stay alive until the queue is flushed.
     struct OpenGLDrawCommand
     {
-        std::shared_ptr<Shader> shader;
-        std::shared_ptr<VertexArray> vertexArray;
-        std::shared_ptr<Texture2D> texture; // nullptr if no texture
+        const OpenGLShader* shader;
+        const VertexArray* vertexArray;
+        const Texture2D* texture;       // nullptr if no texture
+        uint32_t firstIndex;
+        uint32_t indexCount;
+
+        // Range in the frame's instance stream; instanceCount == 0 for a regular draw
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+
+        // Index into the flush's object uniforms, NoObjectUniforms if SetObjectUniforms() wasn't called
+        uint32_t objectUniforms;
+        static constexpr uint32_t NoObjectUniforms = ~0u;
+
+        // Copy of the shader's staged uniforms at submission time, so draws sharing
+        // a shader keep their own values
+        float* uniforms;
     };
 
     class MacosOpenGlRenderingAPI : public RenderingAPI
@@ -24,6 +46,12 @@ namespace arv
 
         void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray) override;
         void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture) override;
+        void Draw(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                  const std::shared_ptr<Texture2D>& texture, const IndexRange& range) override;
+        void DrawInstanced(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                           const std::shared_ptr<Texture2D>& texture, const InstanceData* instances,
+                           uint32_t instanceCount, const glm::mat4& viewProjection,
+                           const IndexRange& range = IndexRange()) override;
 
         void SetClearColor(const glm::vec4& color) override;
         void Clear() override;
@@ -31,19 +59,76 @@ namespace arv
         void BeginFrame() override;
         void EndFrame() override;
 
-        // Execute pending draw commands without ending the frame
+        // Sort pending draw commands by state and execute them without ending the frame
         void FlushDrawCommands() override;
 
+        // Frame uniforms are uploaded at the start of a flush, so the last values set
+        // before it apply to all its draws. Object uniforms are sub-allocated from a
+        // ring of per-frame segments in one buffer and bound by offset per draw.
+        void SetFrameUniforms(const FrameUniforms& uniforms) override;
+        void SetObjectUniforms(const ObjectUniforms& uniforms) override;
+
         std::shared_ptr<VertexBuffer> CreateVertexBuffer(float* vertices, unsigned int size) override;
         std::shared_ptr<IndexBuffer> CreateIndexBuffer(unsigned int* indices, unsigned int size) override;
         std::shared_ptr<VertexArray> CreateVertexArray() override;
         std::shared_ptr<Shader> CreateShader(ShaderSource* shaderSource) override;
-        std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path) override;
+        std::shared_ptr<Texture2D> CreateTexture2D(const std::string& path,
+                                                   const TextureSpecification& spec = TextureSpecification()) override;
+        std::shared_ptr<Texture2D> CreateTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                                                   const TextureSpecification& spec = TextureSpecification()) override;
         std::shared_ptr<Texture2D> CreateHDRTexture2D(const std::string& path) override;
+        std::shared_ptr<TextureCube> CreateHDRTextureCube(const std::string& path) override;
         std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferSpecification& spec) override;
+        std::shared_ptr<UniformBuffer> CreateUniformBuffer(uint32_t size) override;
+
+        bool SupportsVertexType(ShaderDataType type) const override { return type != ShaderDataType::None; }
+        // Decided from the context's extensions in Init()
+        bool SupportsTextureFormat(TextureFormat format) const override;
+        bool UsesBottomLeftTextureOrigin() const override { return true; }
 
     private:
-        std::vector<OpenGLDrawCommand> m_drawCommands;
+        // Segments in the object uniform ring; the GPU may still read the previous frames'
+        static constexpr uint32_t ObjectRingSegments = 3;
+
+        struct SortEntry
+        {
+            uint64_t key;
+            const OpenGLDrawCommand* command;
+        };
+
+        OpenGLDrawCommand& Submit(const std::shared_ptr<Shader>& shader, const std::shared_ptr<VertexArray>& vertexArray,
+                                  const std::shared_ptr<Texture2D>& texture, const IndexRange& range = IndexRange());
+        void SortDrawCommands();
+        void UploadInstanceData();
+        void BindInstanceAttributes(uint32_t firstInstance);
+        uint32_t UploadObjectUniforms();
+
+        // Packets and uniform snapshots live in the arena, which is reset in BeginFrame().
+        // m_sortEntries is the queue itself; the vectors keep their capacity across frames.
+        FrameArena m_frameArena;
+        std::vector<SortEntry> m_sortEntries;
+        std::vector<SortEntry> m_sortScratch;
+        std::vector<InstanceData> m_instanceData;
+
+        std::unique_ptr<OpenGLProgramCache> m_programCache;
+
+        std::unique_ptr<OpenGLUniformBuffer> m_frameUniformBuffer;
+        FrameUniforms m_frameUniforms;
+        bool m_frameUniformsDirty = false;
+
+        std::unique_ptr<OpenGLUniformBuffer> m_objectUniformBuffer;
+        std::vector<ObjectUniforms> m_objectUniforms;
+        std::vector<uint8_t> m_objectUniformStaging;
+        ObjectUniforms m_pendingObjectUniforms;
+        bool m_hasPendingObjectUniforms = false;
+        uint32_t m_objectUniformStride = sizeof(ObjectUniforms);  // Rounded up to the offset alignment
+        uint32_t m_objectSegmentSize = 0;                           // Bytes per ring segment
+        uint32_t m_objectSegment = 0;
+        uint32_t m_objectSegmentCursor = 0;                         // Bytes used in the current segment
+
+        uint32_t m_textureFormats = 1u << static_cast<uint32_t>(TextureFormat::RGBA8);  // Bit per supported TextureFormat
+        unsigned int m_instanceBuffer = 0;
+        RenderStats m_frameStats;
         bool m_frameInProgress = false;
     };
 }
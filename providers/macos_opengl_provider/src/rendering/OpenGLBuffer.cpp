@@ -51,6 +51,48 @@ namespace arv {
     {
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
+    /////////////////////////////////////////////////////////////////////////////
+    // UniformBuffer ////////////////////////////////////////////////////////////
+    /////////////////////////////////////////////////////////////////////////////
+    OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size)
+        : m_Size(size)
+    {
+        glGenBuffers(1, &m_RendererID);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        ARV_LOG_INFO("OpenGLUniformBuffer::OpenGLUniformBuffer() - Created uniform buffer ID {} with {} bytes", m_RendererID, size);
+    }
+    OpenGLUniformBuffer::~OpenGLUniformBuffer()
+    {
+        ARV_LOG_INFO("OpenGLUniformBuffer::~OpenGLUniformBuffer() - Destroying uniform buffer ID {}", m_RendererID);
+        glDeleteBuffers(1, &m_RendererID);
+    }
+    void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+    {
+        if (offset + size > m_Size)
+        {
+            ARV_LOG_ERROR("OpenGLUniformBuffer::SetData() - Write of {} bytes at {} exceeds buffer size {}", size, offset, m_Size);
+            return;
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    void OpenGLUniformBuffer::Bind(uint32_t binding) const
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+    }
+    void OpenGLUniformBuffer::BindRange(uint32_t binding, uint32_t offset, uint32_t size) const
+    {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_RendererID, offset, size);
+    }
+    void OpenGLUniformBuffer::Resize(uint32_t size)
+    {
+        m_Size = size;
+        glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
 
-
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rendering/Buffer.h"
+#include "rendering/UniformBuffer.h"
 
 namespace arv {
 
@@ -30,5 +31,22 @@ namespace arv {
         unsigned int m_RendererID;
         unsigned int m_Count;
     };
+    class OpenGLUniformBuffer : public UniformBuffer
+    {
+    public:
+        OpenGLUniformBuffer(uint32_t size);
+        virtual ~OpenGLUniformBuffer();
+
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+        virtual void Bind(uint32_t binding) const override;
+        virtual void BindRange(uint32_t binding, uint32_t offset, uint32_t size) const override;
+        virtual uint32_t GetSize() const override { return m_Size; }
+
+        // Reallocates the storage; the contents are undefined afterwards
+        void Resize(uint32_t size);
+    private:
+        unsigned int m_RendererID;
+        uint32_t m_Size;
+    };
 
-}
\ No newline at end of file
+}
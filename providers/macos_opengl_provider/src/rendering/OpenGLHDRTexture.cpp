@@ -1,27 +1,21 @@
 #include "OpenGLHDRTexture.h"
 #include "ARVBase.h"
+#include "rendering/HDRImage.h"
 #include <glad/glad.h>
 
-#include <tinyexr.h>
-
 namespace arv {
 
     OpenGLHDRTexture2D::OpenGLHDRTexture2D(const std::string& path)
     {
-        float* rgba = nullptr;
-        int width, height;
-        const char* err = nullptr;
-
-        int ret = LoadEXR(&rgba, &width, &height, path.c_str(), &err);
-        if (ret != TINYEXR_SUCCESS) {
-            ARV_LOG_ERROR("Failed to load EXR texture: {} ({})", path, err ? err : "unknown error");
-            FreeEXRErrorMessage(err);
+        HDRImage image;
+        if (!image.Load(path)) {
+            ARV_LOG_ERROR("Failed to load EXR texture: {}", path);
             return;
         }
 
-        m_Width = width;
-        m_Height = height;
-        m_Channels = 4; // LoadEXR always returns RGBA
+        m_Width = image.GetWidth();
+        m_Height = image.GetHeight();
+        m_Channels = 4;
 
         glGenTextures(1, &m_RendererID);
         glBindTexture(GL_TEXTURE_2D, m_RendererID);
@@ -31,11 +25,10 @@ namespace arv {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, rgba);
-
-        free(rgba);
+        // Uploaded as halves, so the driver doesn't convert and moves half the bytes
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, m_Width, m_Height, 0, GL_RGBA, GL_HALF_FLOAT, image.GetTexels());
 
-        ARV_LOG_INFO("OpenGL HDR texture loaded: {} ({}x{})", path, width, height);
+        ARV_LOG_INFO("OpenGL HDR texture loaded: {} ({}x{})", path, m_Width, m_Height);
     }
 
     OpenGLHDRTexture2D::~OpenGLHDRTexture2D()
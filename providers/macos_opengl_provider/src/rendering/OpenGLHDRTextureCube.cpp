@@ -0,0 +1,58 @@
+#include "OpenGLHDRTextureCube.h"
+#include "ARVBase.h"
+#include "rendering/HDRCubemap.h"
+#include <glad/glad.h>
+
+namespace arv {
+
+    OpenGLHDRTextureCube::OpenGLHDRTextureCube(const std::string& path)
+    {
+        HDRCubemap cubemap;
+        if (!cubemap.Load(path)) {
+            ARV_LOG_ERROR("Failed to load HDR cubemap: {}", path);
+            return;
+        }
+
+        m_FaceSize = cubemap.GetFaceSize();
+        m_LevelCount = cubemap.GetLevelCount();
+
+        glGenTextures(1, &m_RendererID);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_LevelCount) - 1);
+
+        // Cube faces keep rows top to bottom, so unlike 2D textures nothing is flipped
+        for (uint32_t level = 0; level < m_LevelCount; level++) {
+            GLsizei size = static_cast<GLsizei>(cubemap.GetLevelSize(level));
+            for (uint32_t face = 0; face < HDRCubemap::FaceCount; face++) {
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, GL_RGBA16F, size, size, 0,
+                             GL_RGBA, GL_HALF_FLOAT, cubemap.GetFace(level, face));
+            }
+        }
+
+        ARV_LOG_INFO("OpenGL HDR cubemap loaded: {} ({}x{} faces, {} levels)", path, m_FaceSize, m_FaceSize, m_LevelCount);
+    }
+
+    OpenGLHDRTextureCube::~OpenGLHDRTextureCube()
+    {
+        glDeleteTextures(1, &m_RendererID);
+    }
+
+    void OpenGLHDRTextureCube::Bind(unsigned int slot) const
+    {
+        glActiveTexture(GL_TEXTURE0 + slot);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+    }
+
+    void OpenGLHDRTextureCube::Unbind() const
+    {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    }
+
+}
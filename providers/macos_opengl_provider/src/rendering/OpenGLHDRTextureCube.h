@@ -0,0 +1,28 @@
+#pragma once
+
+#include "rendering/Texture.h"
+#include <cstdint>
+#include <string>
+
+namespace arv {
+
+    class OpenGLHDRTextureCube : public TextureCube {
+    public:
+        OpenGLHDRTextureCube(const std::string& path);
+        ~OpenGLHDRTextureCube();
+
+        void Bind(unsigned int slot = 0) const override;
+        void Unbind() const override;
+
+        unsigned int GetWidth() const override { return m_FaceSize; }
+        unsigned int GetHeight() const override { return m_FaceSize; }
+        unsigned int GetChannels() const override { return 4; }
+        uint32_t GetLevelCount() const override { return m_LevelCount; }
+
+    private:
+        unsigned int m_RendererID = 0;
+        unsigned int m_FaceSize = 0;
+        uint32_t m_LevelCount = 0;
+    };
+
+}
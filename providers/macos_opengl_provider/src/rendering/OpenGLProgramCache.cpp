@@ -0,0 +1,176 @@
+#include "OpenGLProgramCache.h"
+#include "ARVBase.h"
+#include "utils/SourceStamp.h"
+#include "utils/Stopwatch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace arv {
+
+    namespace {
+
+        constexpr char ProgramFileMagic[8] = { 'A', 'R', 'V', 'P', 'R', 'O', 'G', '\0' };
+        constexpr uint64_t MaxBinarySize = 64ull << 20;
+
+        struct ProgramFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t binaryFormat;
+            uint64_t key;
+            uint64_t binarySize;
+        };
+
+        std::string GetString(GLenum name)
+        {
+            const char* value = reinterpret_cast<const char*>(glGetString(name));
+            return value ? value : "";
+        }
+
+    }
+
+    OpenGLProgramCache::OpenGLProgramCache(const std::string& directory)
+        : m_Directory(directory)
+    {
+        m_Driver = GetString(GL_VENDOR) + "\n" + GetString(GL_RENDERER) + "\n" + GetString(GL_VERSION) + "\n" +
+                   GetString(GL_SHADING_LANGUAGE_VERSION);
+
+        GLint formatCount = 0;
+        if (glGetProgramBinary && glProgramBinary && glProgramParameteri) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        }
+        if (formatCount <= 0) {
+            ARV_LOG_INFO("OpenGLProgramCache() - The driver offers no program binary formats, compiling every shader");
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(m_Directory, error);
+        if (error) {
+            ARV_LOG_WARN("OpenGLProgramCache() - Cannot create {}: {}", m_Directory, error.message());
+            return;
+        }
+
+        m_Enabled = true;
+        ARV_LOG_INFO("OpenGLProgramCache() - Caching program binaries in {}", m_Directory);
+    }
+
+    std::string OpenGLProgramCache::GetDefaultDirectory()
+    {
+        const char* home = std::getenv("HOME");
+        if (home && *home) {
+            return (std::filesystem::path(home) / "Library" / "Caches" / "ARVision" / "programs").string();
+        }
+
+        std::error_code error;
+        std::filesystem::path temp = std::filesystem::temp_directory_path(error);
+        return ((error ? std::filesystem::path(".") : temp) / "ARVision" / "programs").string();
+    }
+
+    uint64_t OpenGLProgramCache::GetKey(const std::string& vertexSource, const std::string& fragmentSource) const
+    {
+        std::string text = m_Driver;
+        text += '\0';
+        text += vertexSource;
+        text += '\0';
+        text += fragmentSource;
+        return HashBytes(reinterpret_cast<const std::byte*>(text.data()), text.size());
+    }
+
+    GLuint OpenGLProgramCache::Load(uint64_t key)
+    {
+        if (!m_Enabled) {
+            return 0;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::string path = GetPath(key);
+        std::ifstream in(path, std::ios::binary);
+        ProgramFileHeader header;
+        if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, ProgramFileMagic, sizeof(ProgramFileMagic)) != 0 ||
+            header.version != Version || header.key != key || header.binarySize > MaxBinarySize) {
+            m_Misses++;
+            ARV_LOG_INFO("OpenGLProgramCache::Load() - Miss for {:016x}", key);
+            return 0;
+        }
+
+        std::vector<char> binary(header.binarySize);
+        if (!in.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+            m_Misses++;
+            ARV_LOG_WARN("OpenGLProgramCache::Load() - {} is truncated", path);
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            // Stale for this driver; the caller's rebuild replaces the file
+            glDeleteProgram(program);
+            m_Misses++;
+            ARV_LOG_INFO("OpenGLProgramCache::Load() - Driver rejected the binary for {:016x}, compiling from source", key);
+            return 0;
+        }
+
+        m_Hits++;
+        ARV_LOG_INFO("OpenGLProgramCache::Load() - Hit for {:016x}, {} bytes loaded in {:.1f} ms",
+                     key, binary.size(), MillisecondsSince(start));
+        return program;
+    }
+
+    void OpenGLProgramCache::Store(uint64_t key, GLuint program)
+    {
+        if (!m_Enabled || !program) {
+            return;
+        }
+
+        GLint size = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+        if (size <= 0) {
+            ARV_LOG_WARN("OpenGLProgramCache::Store() - The driver returned no binary for {:016x}", key);
+            return;
+        }
+
+        std::vector<char> binary(static_cast<size_t>(size));
+        GLsizei length = 0;
+        GLenum format = 0;
+        glGetProgramBinary(program, size, &length, &format, binary.data());
+        if (length <= 0) {
+            ARV_LOG_WARN("OpenGLProgramCache::Store() - The driver returned no binary for {:016x}", key);
+            return;
+        }
+
+        ProgramFileHeader header = {};
+        std::memcpy(header.magic, ProgramFileMagic, sizeof(ProgramFileMagic));
+        header.version = Version;
+        header.binaryFormat = format;
+        header.key = key;
+        header.binarySize = static_cast<uint64_t>(length);
+
+        // Written under a temporary name and renamed, so another instance never reads half a file
+        bool stored = WriteCacheFile(GetPath(key), [&](std::ostream& out) {
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(binary.data(), length);
+        });
+        if (!stored) {
+            return;
+        }
+        ARV_LOG_INFO("OpenGLProgramCache::Store() - Stored {:016x} ({} bytes)", key, length);
+    }
+
+    std::string OpenGLProgramCache::GetPath(uint64_t key) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.arvprog", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(m_Directory) / name).string();
+    }
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+namespace arv {
+
+    /**
+     * On-disk cache of linked program binaries (glGetProgramBinary), so a
+     * shader that was built once is loaded instead of compiled from GLSL.
+     *
+     * Programs are keyed by a hash of their stage sources and the vendor,
+     * renderer and version strings of the driver, one .arvprog file per key.
+     * Drivers may still reject a binary (e.g. after an update that keeps the
+     * version string); the caller then compiles from source and stores the
+     * new binary over the old one.
+     */
+    class OpenGLProgramCache {
+    public:
+        static constexpr uint32_t Version = 1;
+
+        // Needs the GL context current; caching is off if the driver has no binary formats
+        explicit OpenGLProgramCache(const std::string& directory = GetDefaultDirectory());
+
+        // ~/Library/Caches/ARVision/programs, or a directory under the system temp path
+        static std::string GetDefaultDirectory();
+
+        bool IsEnabled() const { return m_Enabled; }
+
+        uint64_t GetKey(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+        // Program created from the binary stored under key, 0 on a miss or if the driver rejects it
+        GLuint Load(uint64_t key);
+
+        // Writes the binary of a program linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+        void Store(uint64_t key, GLuint program);
+
+        uint32_t GetHits() const { return m_Hits; }
+        uint32_t GetMisses() const { return m_Misses; }
+
+    private:
+        std::string GetPath(uint64_t key) const;
+
+        std::string m_Directory;
+        std::string m_Driver;  // Vendor, renderer and version strings
+        bool m_Enabled = false;
+        uint32_t m_Hits = 0;
+        uint32_t m_Misses = 0;
+    };
+
+}
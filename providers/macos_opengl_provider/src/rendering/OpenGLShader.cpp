@@ -1,7 +1,13 @@
 #include "OpenGLShader.h"
+#include "OpenGLProgramCache.h"
 #include "ARVBase.h"
+#include "rendering/UniformBuffer.h"
+#include "utils/Stopwatch.h"
 
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 namespace arv {
 
@@ -10,56 +16,265 @@ namespace arv {
         Destroy();
     }
 
+    // Inserts a #define right after the #version line (which must stay first)
+    static std::string InsertDefine(const std::string& source, const char* define) {
+        size_t version = source.find("#version");
+        size_t lineEnd = version == std::string::npos ? std::string::npos : source.find('\n', version);
+        if (lineEnd == std::string::npos) {
+            return std::string("#define ") + define + "\n" + source;
+        }
+        return source.substr(0, lineEnd + 1) + "#define " + define + "\n" + source.substr(lineEnd + 1);
+    }
+
     void OpenGLShader::Compile() {
         ARV_LOG_INFO("OpenGLShader::Compile() - Starting shader compilation");
 
         std::string vertexSource = m_ShaderSource->GetSource("GLSL_VERTEX_SHADER");
         std::string fragmentSource = m_ShaderSource->GetSource("GLSL_FRAGMENT_SHADER");
 
-        ARV_LOG_INFO("OpenGLShader::Compile() - Compiling vertex shader");
+        GLuint shaderProgram = LinkProgram(vertexSource, fragmentSource);
+        if (!shaderProgram) {
+            return;
+        }
+
+        m_ProgramId = shaderProgram;
+        ARV_LOG_INFO("OpenGLShader::Compile() - Shader compiled successfully, program ID: {}", m_ProgramId);
+
+        m_Uniforms.clear();
+        CollectUniforms(m_ProgramId, 0);
+        m_UsesObjectBlock = BindUniformBlocks(m_ProgramId);
+
+        if (vertexSource.find("ARV_INSTANCED") != std::string::npos) {
+            ARV_LOG_INFO("OpenGLShader::Compile() - Compiling instanced variant");
+            m_InstancedProgramId = LinkProgram(InsertDefine(vertexSource, "ARV_INSTANCED"),
+                                               InsertDefine(fragmentSource, "ARV_INSTANCED"));
+            if (m_InstancedProgramId) {
+                CollectUniforms(m_InstancedProgramId, 1);
+                BindUniformBlocks(m_InstancedProgramId);
+            }
+        }
+
+        FinalizeUniforms();
+        ARV_LOG_INFO("OpenGLShader::Compile() - {} active uniforms, {} staged floats", m_Uniforms.size(), m_StagedUniforms.size());
+    }
+
+    void OpenGLShader::CollectUniforms(GLuint program, uint32_t variant) {
+        GLint count = 0;
+        GLint maxNameLength = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+        std::vector<char> nameBuffer(std::max(maxNameLength, 1));
+
+        for (GLint i = 0; i < count; i++) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(program, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &length, &size, &type, nameBuffer.data());
+
+            // Arrays are reported as "name[0]"; only their first element is addressable by name here
+            std::string name(nameBuffer.data(), length);
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+                name.resize(name.size() - 3);
+            }
+
+            // Members of uniform blocks have no location
+            GLint location = glGetUniformLocation(program, name.c_str());
+            if (location < 0) {
+                continue;
+            }
+
+            uint32_t hash = UniformNameHash(name);
+            auto existing = std::find_if(m_Uniforms.begin(), m_Uniforms.end(),
+                                         [hash](const UniformSlot& slot) { return slot.hash == hash; });
+            if (existing != m_Uniforms.end()) {
+                if (existing->name != name) {
+                    ARV_LOG_WARN("OpenGLShader::CollectUniforms() - Uniforms '{}' and '{}' have the same hash, '{}' is ignored",
+                                 existing->name, name, name);
+                    continue;
+                }
+                existing->locations[variant] = location;
+                continue;
+            }
+
+            UniformSlot slot;
+            slot.hash = hash;
+            slot.type = type;
+            slot.locations[variant] = location;
+            slot.name = std::move(name);
+            m_Uniforms.push_back(std::move(slot));
+        }
+    }
+
+    // Points the built-in blocks at their fixed binding points; returns true if ArvObject is declared
+    bool OpenGLShader::BindUniformBlocks(GLuint program) {
+        GLuint frameBlock = glGetUniformBlockIndex(program, "ArvFrame");
+        if (frameBlock != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program, frameBlock, FrameBlockBinding);
+        }
+
+        GLuint objectBlock = glGetUniformBlockIndex(program, "ArvObject");
+        if (objectBlock != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program, objectBlock, ObjectBlockBinding);
+            return true;
+        }
+        return false;
+    }
+
+    // Floats a uniform of the type takes in the staged array, 0 if it can't be uploaded
+    // through Shader. Ints, bools and samplers keep their bits in a float slot.
+    static uint32_t GetStagedSize(GLenum type) {
+        switch (type) {
+            case GL_INT:
+            case GL_BOOL:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_FLOAT:        return 1;
+            case GL_FLOAT_VEC2:   return 2;
+            case GL_FLOAT_VEC3:   return 3;
+            case GL_FLOAT_VEC4:   return 4;
+            case GL_FLOAT_MAT3:   return 9;
+            case GL_FLOAT_MAT4:   return 16;
+            default:              return 0;
+        }
+    }
+
+    static bool IsIntType(GLenum type) {
+        return type == GL_INT || type == GL_BOOL || type == GL_SAMPLER_2D || type == GL_SAMPLER_3D || type == GL_SAMPLER_CUBE;
+    }
+
+    void OpenGLShader::FinalizeUniforms() {
+        std::sort(m_Uniforms.begin(), m_Uniforms.end(),
+                  [](const UniformSlot& a, const UniformSlot& b) { return a.hash < b.hash; });
+
+        uint32_t stagedCount = 0;
+        m_StagedSlots.clear();
+        for (uint32_t i = 0; i < m_Uniforms.size(); i++) {
+            UniformSlot& slot = m_Uniforms[i];
+            uint32_t size = GetStagedSize(slot.type);
+            if (size > 0) {
+                slot.stagedOffset = static_cast<int32_t>(stagedCount);
+                stagedCount += size;
+                m_StagedSlots.push_back(i);
+            }
+        }
+        m_StagedUniforms.assign(stagedCount, 0.0f);
+    }
+
+    void OpenGLShader::Stage(const UniformId& id, bool (*accepts)(GLenum), const void* value, size_t size) {
+        const UniformSlot* slot = FindUniform(id);
+        if (slot && slot->stagedOffset >= 0 && accepts(slot->type)) {
+            std::memcpy(m_StagedUniforms.data() + slot->stagedOffset, value, size);
+        }
+    }
+
+    const OpenGLShader::UniformSlot* OpenGLShader::FindUniform(const UniformId& id) const {
+        auto it = std::lower_bound(m_Uniforms.begin(), m_Uniforms.end(), id.hash,
+                                   [](const UniformSlot& slot, uint32_t hash) { return slot.hash < hash; });
+        // A different name with the same hash must not write into this uniform
+        if (it == m_Uniforms.end() || it->hash != id.hash || it->name != id.name) {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    int32_t OpenGLShader::GetStagedOffset(const UniformId& id) const {
+        const UniformSlot* slot = FindUniform(id);
+        return slot ? slot->stagedOffset : -1;
+    }
+
+    GLuint OpenGLShader::LinkProgram(const std::string& vertexSource, const std::string& fragmentSource) {
+        bool cached = m_ProgramCache && m_ProgramCache->IsEnabled();
+        uint64_t key = cached ? m_ProgramCache->GetKey(vertexSource, fragmentSource) : 0;
+        if (cached) {
+            if (GLuint program = m_ProgramCache->Load(key)) {
+                return program;
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ARV_LOG_INFO("OpenGLShader::LinkProgram() - Compiling vertex shader");
         GLuint vertexShader = CompileShader(vertexSource.c_str(), GL_VERTEX_SHADER);
-        ARV_LOG_INFO("OpenGLShader::Compile() - Compiling fragment shader");
+        ARV_LOG_INFO("OpenGLShader::LinkProgram() - Compiling fragment shader");
         GLuint fragmentShader = CompileShader(fragmentSource.c_str(), GL_FRAGMENT_SHADER);
 
-        ARV_LOG_INFO("OpenGLShader::Compile() - Linking shader program");
+        ARV_LOG_INFO("OpenGLShader::LinkProgram() - Linking shader program");
         GLuint shaderProgram = glCreateProgram();
         glAttachShader(shaderProgram, vertexShader);
         glAttachShader(shaderProgram, fragmentShader);
+        if (cached) {
+            glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
         glLinkProgram(shaderProgram);
 
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+
         GLint success;
         char infoLog[512];
         glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(shaderProgram, 512, nullptr, infoLog);
-            ARV_LOG_ERROR("OpenGLShader::Compile() - Shader program linking failed: {}", infoLog);
-            return;
+            ARV_LOG_ERROR("OpenGLShader::LinkProgram() - Shader program linking failed: {}", infoLog);
+            glDeleteProgram(shaderProgram);
+            return 0;
         }
 
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+        ARV_LOG_INFO("OpenGLShader::LinkProgram() - Compiled and linked in {:.1f} ms", MillisecondsSince(start));
 
-        m_ProgramId = shaderProgram;
-        ARV_LOG_INFO("OpenGLShader::Compile() - Shader compiled successfully, program ID: {}", m_ProgramId);
+        if (cached) {
+            m_ProgramCache->Store(key, shaderProgram);
+        }
+        return shaderProgram;
     }
 
     void OpenGLShader::Destroy() {
         glDeleteProgram(m_ProgramId);
+        if (m_InstancedProgramId) {
+            glDeleteProgram(m_InstancedProgramId);
+            m_InstancedProgramId = 0;
+        }
+        m_Uniforms.clear();
+        m_StagedSlots.clear();
+        m_StagedUniforms.clear();
     }
 
     void OpenGLShader::Use() {
-        glUseProgram(m_ProgramId);
+        Bind();
+        ApplyUniforms(m_StagedUniforms.data());
+    }
 
-        for (const auto& [name, value] : m_Float4Uniforms)
-        {
-            GLint location = glGetUniformLocation(m_ProgramId, name.c_str());
-            glUniform4f(location, value.x, value.y, value.z, value.w);
-        }
+    void OpenGLShader::Bind(bool instanced) const {
+        glUseProgram(instanced ? m_InstancedProgramId : m_ProgramId);
+    }
 
-        for (const auto& [name, value] : m_Mat4Uniforms)
+    void OpenGLShader::ApplyUniforms(const float* stagedUniforms, bool instanced) const {
+        for (uint32_t index : m_StagedSlots)
         {
-            GLint location = glGetUniformLocation(m_ProgramId, name.c_str());
-            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+            const UniformSlot& slot = m_Uniforms[index];
+            GLint location = slot.locations[instanced ? 1 : 0];
+            if (location < 0)
+            {
+                continue;
+            }
+
+            const float* value = stagedUniforms + slot.stagedOffset;
+            switch (slot.type)
+            {
+                case GL_FLOAT:      glUniform1fv(location, 1, value); break;
+                case GL_FLOAT_VEC2: glUniform2fv(location, 1, value); break;
+                case GL_FLOAT_VEC3: glUniform3fv(location, 1, value); break;
+                case GL_FLOAT_VEC4: glUniform4fv(location, 1, value); break;
+                case GL_FLOAT_MAT3: glUniformMatrix3fv(location, 1, GL_FALSE, value); break;
+                case GL_FLOAT_MAT4: glUniformMatrix4fv(location, 1, GL_FALSE, value); break;
+                default:
+                {
+                    GLint integer;
+                    std::memcpy(&integer, value, sizeof(integer));
+                    glUniform1i(location, integer);
+                    break;
+                }
+            }
         }
     }
 
@@ -81,44 +296,75 @@ namespace arv {
 
     void OpenGLShader::UploadUniformInt(const std::string& name, int value)
     {
-        GLint location = glGetUniformLocation(m_ProgramId, name.c_str());
-        glUniform1i(location, value);
+        UploadUniformInt(UniformId(name), value);
     }
 
     void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
     {
-        GLint location = glGetUniformLocation(m_ProgramId, name.c_str());
-        glUniform1f(location, value);
+        UploadUniformFloat(UniformId(name), value);
     }
 
     void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value)
     {
-        GLint location = glGetUniformLocation(m_ProgramId, name.c_str());
-        glUniform2f(location, value.x, value.y);
+        UploadUniformFloat2(UniformId(name), value);
     }
 
     void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value)
     {
-        GLint location = glGetUniformLocation(m_ProgramId, name.c_str());
-        glUniform3f(location, value.x, value.y, value.z);
+        UploadUniformFloat3(UniformId(name), value);
     }
 
     void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value)
     {
-        // Store the uniform value - will be applied during Use()
-        m_Float4Uniforms[name] = value;
+        UploadUniformFloat4(UniformId(name), value);
     }
 
     void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
     {
-        GLint location = glGetUniformLocation(m_ProgramId, name.c_str());
-        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        UploadUniformMat3(UniformId(name), matrix);
     }
 
     void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
     {
-        // Store the uniform value - will be applied during Use()
-        m_Mat4Uniforms[name] = matrix;
+        UploadUniformMat4(UniformId(name), matrix);
+    }
+
+    // Every type is staged and applied during Use() or by the draw queue, so a
+    // value reaches the program it was meant for at the draw it was set for
+
+    void OpenGLShader::UploadUniformInt(const UniformId& id, int value)
+    {
+        Stage(id, IsIntType, &value, sizeof(value));
+    }
+
+    void OpenGLShader::UploadUniformFloat(const UniformId& id, float value)
+    {
+        Stage(id, [](GLenum type) { return type == GL_FLOAT; }, &value, sizeof(value));
+    }
+
+    void OpenGLShader::UploadUniformFloat2(const UniformId& id, const glm::vec2& value)
+    {
+        Stage(id, [](GLenum type) { return type == GL_FLOAT_VEC2; }, glm::value_ptr(value), sizeof(value));
+    }
+
+    void OpenGLShader::UploadUniformFloat3(const UniformId& id, const glm::vec3& value)
+    {
+        Stage(id, [](GLenum type) { return type == GL_FLOAT_VEC3; }, glm::value_ptr(value), sizeof(value));
+    }
+
+    void OpenGLShader::UploadUniformFloat4(const UniformId& id, const glm::vec4& value)
+    {
+        Stage(id, [](GLenum type) { return type == GL_FLOAT_VEC4; }, glm::value_ptr(value), sizeof(value));
+    }
+
+    void OpenGLShader::UploadUniformMat3(const UniformId& id, const glm::mat3& matrix)
+    {
+        Stage(id, [](GLenum type) { return type == GL_FLOAT_MAT3; }, glm::value_ptr(matrix), sizeof(matrix));
+    }
+
+    void OpenGLShader::UploadUniformMat4(const UniformId& id, const glm::mat4& matrix)
+    {
+        Stage(id, [](GLenum type) { return type == GL_FLOAT_MAT4; }, glm::value_ptr(matrix), sizeof(matrix));
     }
 
 }
\ No newline at end of file
@@ -2,13 +2,19 @@
 #include "rendering/Shader.h"
 #include "rendering/ShaderSource.h"
 #include <glad/glad.h>
+#include <string>
+#include <vector>
 
 namespace arv {
 
+    class OpenGLProgramCache;
+
     class OpenGLShader : public Shader {
 
     public:
-        OpenGLShader(ShaderSource* shaderSource) : Shader(shaderSource) {}
+        // Programs are loaded from and stored in programCache if it isn't nullptr
+        OpenGLShader(ShaderSource* shaderSource, OpenGLProgramCache* programCache = nullptr)
+            : Shader(shaderSource), m_ProgramCache(programCache) {}
         
         ~OpenGLShader();
         
@@ -16,8 +22,26 @@ namespace arv {
         
         void Destroy() override;
         void Use() override;
+
+        // Split form of Use() for the draw queue: Bind() only switches the program,
+        // ApplyUniforms() uploads a copy of GetStagedUniforms() taken when the draw was submitted
+        void Bind(bool instanced = false) const;
+        void ApplyUniforms(const float* stagedUniforms, bool instanced = false) const;
+
+        // Uniforms of every type are staged in one float array; ints keep their bits
+        const float* GetStagedUniforms() const { return m_StagedUniforms.data(); }
+        uint32_t GetStagedUniformCount() const { return static_cast<uint32_t>(m_StagedUniforms.size()); }
+
+        // Offset of a staged uniform in the staged array, or -1 if the shader has none
+        int32_t GetStagedOffset(const UniformId& id) const;
+
+        // True if the regular program declares the ArvObject block (see UniformBuffer.h)
+        bool UsesObjectBlock() const { return m_UsesObjectBlock; }
         
         inline bool IsCompiled() override { return m_ProgramId; }
+
+        // Sources that reference ARV_INSTANCED get a second program compiled with that define
+        bool SupportsInstancing() const override { return m_InstancedProgramId != 0; }
         
         void UploadUniformInt(const std::string& name, int value) override;
         
@@ -28,11 +52,44 @@ namespace arv {
 
         void UploadUniformMat3(const std::string& name, const glm::mat3& matrix) override;
         void UploadUniformMat4(const std::string& name, const glm::mat4& matrix) override;
+
+        void UploadUniformInt(const UniformId& id, int value) override;
+
+        void UploadUniformFloat(const UniformId& id, float value) override;
+        void UploadUniformFloat2(const UniformId& id, const glm::vec2& value) override;
+        void UploadUniformFloat3(const UniformId& id, const glm::vec3& value) override;
+        void UploadUniformFloat4(const UniformId& id, const glm::vec4& value) override;
+
+        void UploadUniformMat3(const UniformId& id, const glm::mat3& matrix) override;
+        void UploadUniformMat4(const UniformId& id, const glm::mat4& matrix) override;
         
     private:
-        GLuint m_ProgramId;
+        // Active uniform of either program, found by introspection after linking
+        struct UniformSlot {
+            uint32_t hash;
+            GLenum type;
+            GLint locations[2] = {-1, -1};  // Regular, instanced program
+            int32_t stagedOffset = -1;      // Into m_StagedUniforms, -1 for types Shader can't upload
+            std::string name;
+        };
+
+        OpenGLProgramCache* m_ProgramCache = nullptr;
+        GLuint m_ProgramId = 0;
+        GLuint m_InstancedProgramId = 0;
+        bool m_UsesObjectBlock = false;
+
+        std::vector<UniformSlot> m_Uniforms;       // Sorted by hash
+        std::vector<uint32_t> m_StagedSlots;       // Indices of the slots with a staged offset
+        std::vector<float> m_StagedUniforms;
         
         GLuint CompileShader(const char *source, GLint shaderType);
+        GLuint LinkProgram(const std::string& vertexSource, const std::string& fragmentSource);
+        void CollectUniforms(GLuint program, uint32_t variant);
+        bool BindUniformBlocks(GLuint program);
+        void FinalizeUniforms();
+        const UniformSlot* FindUniform(const UniformId& id) const;  // nullptr unless hash and name match
+        // Copies value into the staged array if the uniform exists and its type is accepted
+        void Stage(const UniformId& id, bool (*accepts)(GLenum), const void* value, size_t size);
     };
 
 }
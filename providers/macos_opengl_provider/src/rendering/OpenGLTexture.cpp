@@ -1,17 +1,40 @@
 #include "OpenGLTexture.h"
 #include "ARVBase.h"
+#include "rendering/MipChain.h"
 #include <glad/glad.h>
 #include <stb_image.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Extension enums the OpenGL 4.1 core loader doesn't define
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+#ifndef GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT
+#define GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT 0x8E8F
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
 
 namespace arv {
 
-    OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
+    OpenGLTexture2D::OpenGLTexture2D(const std::string& path, const TextureSpecification& spec)
+        : m_Spec(spec)
     {
-        // Flip for OpenGL (OpenGL texture origin is bottom-left)
-        stbi_set_flip_vertically_on_load(true);
+        // Loaded top to bottom so mips are built as on the other backends;
+        // SetMipData() flips each level (OpenGL texture origin is bottom-left)
+        stbi_set_flip_vertically_on_load(false);
 
         int width, height, channels;
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
 
         if (!data)
         {
@@ -19,42 +42,181 @@ namespace arv {
             return;
         }
 
-        m_Width = width;
-        m_Height = height;
+        glGenTextures(1, &m_RendererID);
+
+        // Expanded to RGBA like on the other backends, so all mip levels share one format
+        SetData(data, width, height);
         m_Channels = channels;
 
-        GLenum internalFormat = 0;
-        GLenum dataFormat = 0;
+        stbi_image_free(data);
+
+        ARV_LOG_INFO("OpenGL texture loaded: {} ({}x{}, {} channels)", path, width, height, channels);
+    }
+
+    OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height, const void* pixels, const TextureSpecification& spec)
+        : m_Spec(spec)
+    {
+        glGenTextures(1, &m_RendererID);
+        SetData(pixels, width, height);
+    }
 
-        if (channels == 4)
+    void OpenGLTexture2D::SetData(const void* pixels, unsigned int width, unsigned int height)
+    {
+        MipChain chain = MipChain::Build(pixels, width, height, m_Spec);
+        SetMipData(chain.GetLevels(), chain.GetLevelCount());
+    }
+
+    unsigned int OpenGLTexture2D::GetCompressedFormat(TextureFormat format)
+    {
+        switch (format)
         {
-            internalFormat = GL_RGBA8;
-            dataFormat = GL_RGBA;
+            case TextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+            case TextureFormat::BC6H: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+            case TextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case TextureFormat::ETC2_RGB8: return GL_COMPRESSED_RGB8_ETC2;
+            case TextureFormat::ETC2_RGBA8: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+            case TextureFormat::ASTC_4x4: return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+            default: return 0;
         }
-        else if (channels == 3)
+    }
+
+    void OpenGLTexture2D::SetMipData(const TextureMipLevel* levels, uint32_t levelCount, TextureFormat format)
+    {
+        if (levelCount == 0)
         {
-            internalFormat = GL_RGB8;
-            dataFormat = GL_RGB;
+            return;
         }
-        else if (channels == 1)
+
+        const bool compressed = IsBlockCompressed(format);
+        const GLenum compressedFormat = GetCompressedFormat(format);
+        if (compressed && compressedFormat == 0)
         {
-            internalFormat = GL_R8;
-            dataFormat = GL_RED;
+            ARV_LOG_ERROR("OpenGLTexture2D::SetMipData() - {} textures are not supported", GetTextureFormatName(format));
+            return;
         }
 
-        glGenTextures(1, &m_RendererID);
-        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        m_Width = levels[0].width;
+        m_Height = levels[0].height;
+        m_Channels = 4;
+
+        std::vector<size_t> offsets(levelCount);
+        size_t size = 0;
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            offsets[i] = size;
+            size += GetTextureLevelSize(format, levels[i].width, levels[i].height);
+        }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // All levels go through one pixel buffer object. RGBA8 rows are flipped
+        // while they are copied in (OpenGL texture origin is bottom-left); blocks
+        // can't be flipped, so compressed levels are cooked bottom-up instead
+        // (see RenderingAPI::UsesBottomLeftTextureOrigin()).
+        GLuint pixelBuffer = 0;
+        glGenBuffers(1, &pixelBuffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        auto* mapped = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                                               GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+        std::vector<uint8_t> flipped;
+        uint8_t* staging = mapped;
+        if (!mapped)
+        {
+            ARV_LOG_WARN("OpenGLTexture2D::SetMipData() - Could not map pixel buffer, uploading from client memory");
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &pixelBuffer);
+            pixelBuffer = 0;
 
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
+            flipped.resize(size);
+            staging = flipped.data();
+        }
 
-        stbi_image_free(data);
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            const uint8_t* source = static_cast<const uint8_t*>(levels[i].pixels);
+            uint8_t* target = staging + offsets[i];
+            if (compressed)
+            {
+                std::memcpy(target, source, GetTextureLevelSize(format, levels[i].width, levels[i].height));
+                continue;
+            }
+
+            const size_t rowBytes = static_cast<size_t>(levels[i].width) * 4;
+            for (unsigned int y = 0; y < levels[i].height; y++)
+            {
+                std::memcpy(target + (levels[i].height - 1 - y) * rowBytes, source + y * rowBytes, rowBytes);
+            }
+        }
+        if (mapped)
+        {
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
 
-        ARV_LOG_INFO("OpenGL texture loaded: {} ({}x{}, {} channels)", path, width, height, channels);
+        glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        for (uint32_t i = 0; i < levelCount; i++)
+        {
+            // With a bound pixel buffer the pointer is an offset into it
+            const void* upload = pixelBuffer ? reinterpret_cast<const void*>(offsets[i]) : flipped.data() + offsets[i];
+            if (compressed)
+            {
+                GLsizei levelSize = static_cast<GLsizei>(GetTextureLevelSize(format, levels[i].width, levels[i].height));
+                glCompressedTexImage2D(GL_TEXTURE_2D, i, compressedFormat, levels[i].width, levels[i].height, 0, levelSize, upload);
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, levels[i].width, levels[i].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, upload);
+            }
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+        ApplySamplerState(levelCount);
+
+        // The driver keeps the storage alive until the transfer has finished
+        if (pixelBuffer)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &pixelBuffer);
+        }
+    }
+
+    void OpenGLTexture2D::ApplySamplerState(uint32_t levelCount) const
+    {
+        bool mipmapped = levelCount > 1;
+        GLint minFilter = GL_LINEAR;
+        GLint magFilter = GL_LINEAR;
+        switch (m_Spec.filter)
+        {
+            case TextureFilter::Nearest:
+                minFilter = mipmapped ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
+                magFilter = GL_NEAREST;
+                break;
+            case TextureFilter::Linear:
+                minFilter = mipmapped ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR;
+                break;
+            case TextureFilter::Trilinear:
+                minFilter = mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+                break;
+        }
+        GLint wrap = m_Spec.wrap == TextureWrap::Repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+
+        // Core since 4.6 and an extension every macOS driver exposes; the query
+        // leaves 0 where it isn't supported
+        static GLfloat s_MaxAnisotropy = []() {
+            GLfloat value = 0.0f;
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &value);
+            return value;
+        }();
+        if (m_Spec.maxAnisotropy > 1.0f && s_MaxAnisotropy >= 1.0f)
+        {
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, std::min(m_Spec.maxAnisotropy, s_MaxAnisotropy));
+        }
     }
 
     OpenGLTexture2D::~OpenGLTexture2D()
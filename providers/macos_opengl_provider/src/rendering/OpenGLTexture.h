@@ -1,13 +1,16 @@
 #pragma once
 
 #include "rendering/Texture.h"
+#include <cstdint>
 #include <string>
 
 namespace arv {
 
     class OpenGLTexture2D : public Texture2D {
     public:
-        OpenGLTexture2D(const std::string& path);
+        OpenGLTexture2D(const std::string& path, const TextureSpecification& spec = TextureSpecification());
+        OpenGLTexture2D(uint32_t width, uint32_t height, const void* pixels,
+                        const TextureSpecification& spec = TextureSpecification());
         ~OpenGLTexture2D();
 
         void Bind(unsigned int slot = 0) const override;
@@ -17,7 +20,20 @@ namespace arv {
         unsigned int GetHeight() const override { return m_Height; }
         unsigned int GetChannels() const override { return m_Channels; }
 
+        // Staged through a pixel buffer object, so the call returns once the
+        // texels are copied and the driver transfers them asynchronously
+        void SetData(const void* pixels, unsigned int width, unsigned int height) override;
+        // Compressed levels go through the same buffer with glCompressedTexImage2D
+        void SetMipData(const TextureMipLevel* levels, uint32_t levelCount,
+                        TextureFormat format = TextureFormat::RGBA8) override;
+
+        // OpenGL enum of a block-compressed format, 0 if it has none
+        static unsigned int GetCompressedFormat(TextureFormat format);
+
     private:
+        void ApplySamplerState(uint32_t levelCount) const;
+
+        TextureSpecification m_Spec;
         unsigned int m_RendererID = 0;
         unsigned int m_Width = 0;
         unsigned int m_Height = 0;
@@ -18,6 +18,12 @@ namespace arv {
             case arv::ShaderDataType::Int3:     return GL_INT;
             case arv::ShaderDataType::Int4:     return GL_INT;
             case arv::ShaderDataType::Bool:     return GL_BOOL;
+            case arv::ShaderDataType::Half2:    return GL_HALF_FLOAT;
+            case arv::ShaderDataType::Half4:    return GL_HALF_FLOAT;
+            case arv::ShaderDataType::Short2:   return GL_SHORT;
+            case arv::ShaderDataType::Short4:   return GL_SHORT;
+            case arv::ShaderDataType::UShort2:  return GL_UNSIGNED_SHORT;
+            case arv::ShaderDataType::UShort4:  return GL_UNSIGNED_SHORT;
         }
         //GATE_ASSERT(false, "Unknown ShaderDataType!");
         return 0;